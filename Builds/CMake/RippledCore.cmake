@@ -101,6 +101,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/STInteger.cpp
   src/ripple/protocol/impl/STLedgerEntry.cpp
   src/ripple/protocol/impl/STObject.cpp
+  src/ripple/protocol/impl/STObjectView.cpp
   src/ripple/protocol/impl/STParsedJSON.cpp
   src/ripple/protocol/impl/STPathSet.cpp
   src/ripple/protocol/impl/STXChainBridge.cpp
@@ -153,6 +154,28 @@ target_link_libraries (xrpl_core
     ed25519::ed25519
     date::date
     Ripple::opts)
+
+#[===============================[
+    multi-buffer SHA-512 kernels: each is built
+    with the instruction set it uses and is only
+    called on CPUs found to support it at runtime
+#]===============================]
+if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+  target_sources (xrpl_core PRIVATE
+    src/ripple/protocol/impl/sha512_avx2.cpp
+    src/ripple/protocol/impl/sha512_avx512.cpp)
+  set_source_files_properties (
+    src/ripple/protocol/impl/sha512_avx2.cpp
+    PROPERTIES
+      COMPILE_OPTIONS $<IF:$<BOOL:${MSVC}>,/arch:AVX2,-mavx2>
+      SKIP_UNITY_BUILD_INCLUSION TRUE)
+  set_source_files_properties (
+    src/ripple/protocol/impl/sha512_avx512.cpp
+    PROPERTIES
+      COMPILE_OPTIONS $<IF:$<BOOL:${MSVC}>,/arch:AVX512,-mavx512f>
+      SKIP_UNITY_BUILD_INCLUSION TRUE)
+  target_compile_definitions (xrpl_core PRIVATE RIPPLE_SHA512_MULTIBUFFER=1)
+endif ()
 #[=================================[
    main/core headers installation
 #]=================================]
@@ -220,6 +243,7 @@ install (
     src/ripple/json/MultivarJson.h
     src/ripple/json/Object.h
     src/ripple/json/Output.h
+    src/ripple/json/SharedJson.h
     src/ripple/json/Writer.h
     src/ripple/json/json_forwards.h
     src/ripple/json/json_reader.h
@@ -273,6 +297,7 @@ install (
     src/ripple/protocol/STInteger.h
     src/ripple/protocol/STLedgerEntry.h
     src/ripple/protocol/STObject.h
+    src/ripple/protocol/STObjectView.h
     src/ripple/protocol/STParsedJSON.h
     src/ripple/protocol/STPathSet.h
     src/ripple/protocol/STTx.h
@@ -485,6 +510,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/RippleCalc.cpp
   src/ripple/app/paths/RippleLineCache.cpp
   src/ripple/app/paths/TrustLine.cpp
+  src/ripple/app/paths/TrustLineIndex.cpp
   src/ripple/app/paths/impl/AMMLiquidity.cpp
   src/ripple/app/paths/impl/AMMOffer.cpp
   src/ripple/app/paths/impl/BookStep.cpp
@@ -599,6 +625,7 @@ target_sources (rippled PRIVATE
      main sources:
        subdir: net
   #]===============================]
+  src/ripple/net/impl/AccountSubscriptions.cpp
   src/ripple/net/impl/DatabaseDownloader.cpp
   src/ripple/net/impl/HTTPClient.cpp
   src/ripple/net/impl/HTTPDownloader.cpp
@@ -743,6 +770,7 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
   src/ripple/rpc/impl/ShardVerificationScheduler.cpp
   src/ripple/rpc/impl/Status.cpp
+  src/ripple/rpc/impl/StreamedResponse.cpp
   src/ripple/rpc/impl/TransactionSign.cpp
   #[===============================[
      main sources:
@@ -808,6 +836,8 @@ if (tests)
     src/test/app/NFTokenDir_test.cpp
     src/test/app/OfferStream_test.cpp
     src/test/app/Offer_test.cpp
+    src/test/app/OpenLedger_test.cpp
+    src/test/app/OrderBookDB_test.cpp
     src/test/app/OversizeMeta_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
@@ -827,6 +857,7 @@ if (tests)
     src/test/app/Ticket_test.cpp
     src/test/app/Transaction_ordering_test.cpp
     src/test/app/TrustAndBalance_test.cpp
+    src/test/app/TrustLineIndex_test.cpp
     src/test/app/TxQ_test.cpp
     src/test/app/ValidatorKeys_test.cpp
     src/test/app/ValidatorList_test.cpp
@@ -919,8 +950,10 @@ if (tests)
     src/test/json/Object_test.cpp
     src/test/json/Output_test.cpp
     src/test/json/Writer_test.cpp
+    src/test/json/json_reader_test.cpp
     src/test/json/json_value_test.cpp
     src/test/json/MultivarJson_test.cpp
+    src/test/json/SharedJson_test.cpp
     #[===============================[
        test sources:
          subdir: jtx
@@ -976,6 +1009,7 @@ if (tests)
     src/test/ledger/BookDirs_test.cpp
     src/test/ledger/Directory_test.cpp
     src/test/ledger/Invariants_test.cpp
+    src/test/ledger/KeyedTable_test.cpp
     src/test/ledger/PaymentSandbox_test.cpp
     src/test/ledger/PendingSaves_test.cpp
     src/test/ledger/SkipList_test.cpp
@@ -991,8 +1025,10 @@ if (tests)
     #]===============================]
     src/test/nodestore/Backend_test.cpp
     src/test/nodestore/Basics_test.cpp
+    src/test/nodestore/BatchWriter_test.cpp
     src/test/nodestore/DatabaseShard_test.cpp
     src/test/nodestore/Database_test.cpp
+    src/test/nodestore/DatabaseRotating_test.cpp
     src/test/nodestore/Timing_test.cpp
     src/test/nodestore/import_test.cpp
     src/test/nodestore/varint_test.cpp
@@ -1027,12 +1063,14 @@ if (tests)
     src/test/protocol/STAccount_test.cpp
     src/test/protocol/STAmount_test.cpp
     src/test/protocol/STObject_test.cpp
+    src/test/protocol/STObjectView_test.cpp
     src/test/protocol/STTx_test.cpp
     src/test/protocol/STValidation_test.cpp
     src/test/protocol/SecretKey_test.cpp
     src/test/protocol/Seed_test.cpp
     src/test/protocol/SeqProxy_test.cpp
     src/test/protocol/TER_test.cpp
+    src/test/protocol/digest_test.cpp
     src/test/protocol/types_test.cpp
     #[===============================[
        test sources:
@@ -1079,6 +1117,7 @@ if (tests)
     src/test/rpc/ServerInfo_test.cpp
     src/test/rpc/ShardArchiveHandler_test.cpp
     src/test/rpc/Status_test.cpp
+    src/test/rpc/StreamedResponse_test.cpp
     src/test/rpc/Subscribe_test.cpp
     src/test/rpc/Transaction_test.cpp
     src/test/rpc/TransactionEntry_test.cpp
@@ -20,7 +20,7 @@
 #ifndef RIPPLE_APP_LEDGER_BOOKLISTENERS_H_INCLUDED
 #define RIPPLE_APP_LEDGER_BOOKLISTENERS_H_INCLUDED
 
-#include <ripple/json/MultivarJson.h>
+#include <ripple/json/SharedJson.h>
 #include <ripple/net/InfoSub.h>
 
 #include <memory>
@@ -60,7 +60,9 @@ public:
 
     */
     void
-    publish(MultiApiJson const& jvObj, hash_set<std::uint64_t>& havePublished);
+    publish(
+        MultiApiSharedJson const& jvObj,
+        hash_set<std::uint64_t>& havePublished);
 
 private:
     std::recursive_mutex mLock;
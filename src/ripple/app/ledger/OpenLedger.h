@@ -30,6 +30,7 @@
 #include <ripple/ledger/OpenView.h>
 #include <cassert>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -189,6 +190,39 @@ private:
 
     enum Result { success, failure, retry };
 
+    /** Apply each transaction once, adding those to retry to `retries`.
+
+        With [speculative_apply] enabled, large batches are applied
+        speculatively in parallel. See applySpeculative.
+    */
+    static void
+    applyFirstPass(
+        Application& app,
+        OpenView& view,
+        std::vector<std::shared_ptr<STTx const>> const& txs,
+        OrderedTxs& retries,
+        ApplyFlags flags,
+        beast::Journal j);
+
+    /** Apply transactions speculatively in parallel.
+
+        The transactions are taken in chunks. Each transaction in a chunk
+        is applied on its own to a view of `view` as it was at the start of
+        the chunk, recording the ledger entries it reads. The results are
+        then merged into `view` in order. A transaction that read an entry
+        written by a transaction merged before it is applied again on top
+        of those, so that `view` ends up exactly as if every transaction
+        had been applied one by one.
+    */
+    static void
+    applySpeculative(
+        Application& app,
+        OpenView& view,
+        std::vector<std::shared_ptr<STTx const>> const& txs,
+        OrderedTxs& retries,
+        ApplyFlags flags,
+        beast::Journal j);
+
     std::shared_ptr<OpenView>
     create(Rules const& rules, std::shared_ptr<Ledger const> const& ledger);
 
@@ -215,6 +249,7 @@ OpenLedger::apply(
     ApplyFlags flags,
     beast::Journal j)
 {
+    std::vector<std::shared_ptr<STTx const>> batch;
     for (auto iter = txs.begin(); iter != txs.end(); ++iter)
     {
         try
@@ -224,9 +259,7 @@ OpenLedger::apply(
             auto const txId = tx->getTransactionID();
             if (check.txExists(txId))
                 continue;
-            auto const result = apply_one(app, view, tx, true, flags, j);
-            if (result == Result::retry)
-                retries.insert(tx);
+            batch.push_back(tx);
         }
         catch (std::exception const& e)
         {
@@ -234,6 +267,8 @@ OpenLedger::apply(
                 << "OpenLedger::apply: Caught exception: " << e.what();
         }
     }
+    applyFirstPass(app, view, batch, retries, flags, j);
+
     bool retry = true;
     for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
     {
@@ -23,12 +23,34 @@
 #include <ripple/app/misc/AMMUtils.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/scope.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 
 namespace ripple {
 
+namespace {
+
+// How many ledgers the index may be behind and still be brought up to date
+// from their metadata
+constexpr LedgerIndex maxCatchUp = 256;
+
+// How often the index is saved, in ledgers
+constexpr LedgerIndex snapshotInterval = 256;
+
+// The version of the format the index is saved in
+constexpr std::uint32_t snapshotVersion = 2;
+
+}  // namespace
+
 OrderBookDB::OrderBookDB(Application& app)
     : app_(app), seq_(0), j_(app.journal("OrderBookDB"))
 {
@@ -43,6 +65,22 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
         return;
     }
 
+    if (app_.config().PATH_SEARCH_MAX != 0 && !snapshotTried_.exchange(true))
+    {
+        if (loadSnapshot())
+        {
+            if (catchUp(ledger))
+            {
+                app_.getLedgerMaster().newOrderBookDB();
+                return;
+            }
+
+            std::lock_guard sl(mLock);
+            allBooks_.clear();
+            indexSeq_ = 0;
+        }
+    }
+
     auto seq = seq_.load();
 
     if (seq != 0)
@@ -62,6 +100,7 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
 
     if (app_.config().PATH_SEARCH_MAX != 0)
     {
+        updating_ = true;
         if (app_.config().standalone())
             update(ledger);
         else
@@ -78,6 +117,8 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     if (app_.config().PATH_SEARCH_MAX == 0)
         return;  // pathfinding has been disabled
 
+    scope_exit finished([this]() { updating_ = false; });
+
     // A newer full update job is pending
     if (auto const seq = seq_.load(); seq > ledger->seq())
     {
@@ -86,11 +127,8 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         return;
     }
 
-    decltype(allBooks_) allBooks;
-    decltype(xrpBooks_) xrpBooks;
-
+    Books allBooks;
     allBooks.reserve(allBooks_.size());
-    xrpBooks.reserve(xrpBooks_.size());
 
     JLOG(j_.debug()) << "Beginning update (" << ledger->seq() << ")";
 
@@ -120,24 +158,20 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
                 book.out.currency = sle->getFieldH160(sfTakerGetsCurrency);
                 book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
 
-                allBooks[book.in].insert(book.out);
-
-                if (isXRP(book.out))
-                    xrpBooks.insert(book.in);
-
-                ++cnt;
+                auto& info = allBooks[book.in][book.out];
+                if (!info.exists())
+                    ++cnt;
+                ++info.directories;
             }
             else if (sle->getType() == ltAMM)
             {
                 auto const issue1 = (*sle)[sfAsset];
                 auto const issue2 = (*sle)[sfAsset2];
                 auto addBook = [&](Issue const& in, Issue const& out) {
-                    allBooks[in].insert(out);
-
-                    if (isXRP(out))
-                        xrpBooks.insert(in);
-
-                    ++cnt;
+                    auto& info = allBooks[in][out];
+                    if (!info.exists())
+                        ++cnt;
+                    info.amm = true;
                 };
                 addBook(issue1, issue2);
                 addBook(issue2, issue1);
@@ -158,23 +192,350 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     {
         std::lock_guard sl(mLock);
         allBooks_.swap(allBooks);
-        xrpBooks_.swap(xrpBooks);
+        indexSeq_ = ledger->seq();
+        indexHash_ = ledger->info().hash;
     }
 
+    saveSnapshot();
+
     app_.getLedgerMaster().newOrderBookDB();
 }
 
 void
-OrderBookDB::addOrderBook(Book const& book)
+OrderBookDB::applyLedger(std::shared_ptr<ReadView const> const& ledger)
 {
-    bool toXRP = isXRP(book.out);
+    if (app_.config().PATH_SEARCH_MAX == 0)
+        return;  // pathfinding has been disabled
 
-    std::lock_guard sl(mLock);
+    if (catchUp(ledger))
+    {
+        if (ledger->seq() % snapshotInterval == 0)
+            app_.getJobQueue().addJob(
+                jtUPDATE_PF, "OrderBookDB::saveSnapshot", [this]() {
+                    saveSnapshot();
+                });
+        return;
+    }
+
+    if (!updating_)
+        setup(ledger);
+}
+
+bool
+OrderBookDB::collectChanges(
+    ReadView const& ledger,
+    std::vector<BookChange>& changes)
+{
+    // The transactions are keyed by ID, but a directory may be deleted and
+    // created again by different transactions in a ledger, so the changes
+    // are ordered as the transactions were applied.
+    std::vector<std::pair<std::uint32_t, BookChange>> ordered;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        // Without the metadata, the changes the transaction made are
+        // unknown.
+        if (!meta)
+            return false;
+
+        auto const index = meta->getFieldU32(sfTransactionIndex);
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            bool const created = node.getFName() == sfCreatedNode;
+            if (!created && node.getFName() != sfDeletedNode)
+                continue;
+
+            auto const fields = dynamic_cast<STObject const*>(
+                node.peekAtPField(created ? sfNewFields : sfFinalFields));
+            if (!fields)
+                continue;
+
+            // Fields with default values are left out of NewFields, so a
+            // missing currency or issuer is XRP's.
+            auto const type = node.getFieldU16(sfLedgerEntryType);
+            if (type == ltDIR_NODE)
+            {
+                auto const key = node.getFieldH256(sfLedgerIndex);
+                if (!fields->isFieldPresent(sfExchangeRate) ||
+                    (*fields)[~sfRootIndex] != key)
+                    continue;
+
+                auto const h160 = [&](SField const& field) {
+                    auto const& f = static_cast<SF_UINT160 const&>(field);
+                    return fields->isFieldPresent(f) ? fields->getFieldH160(f)
+                                                     : uint160{};
+                };
+
+                Book book;
+                book.in.currency = h160(sfTakerPaysCurrency);
+                book.in.account = h160(sfTakerPaysIssuer);
+                book.out.currency = h160(sfTakerGetsCurrency);
+                book.out.account = h160(sfTakerGetsIssuer);
+                ordered.emplace_back(
+                    index, BookChange{book, true, created});
+            }
+            else if (type == ltAMM)
+            {
+                auto const asset = [&](SField const& field) {
+                    auto const& f = static_cast<SF_ISSUE const&>(field);
+                    return fields->isFieldPresent(f) ? (*fields)[f]
+                                                     : xrpIssue();
+                };
+                auto const issue1 = asset(sfAsset);
+                auto const issue2 = asset(sfAsset2);
+                ordered.emplace_back(
+                    index, BookChange{{issue1, issue2}, false, created});
+                ordered.emplace_back(
+                    index, BookChange{{issue2, issue1}, false, created});
+            }
+        }
+    }
+
+    std::stable_sort(
+        ordered.begin(), ordered.end(), [](auto const& a, auto const& b) {
+            return a.first < b.first;
+        });
+    for (auto& item : ordered)
+        changes.push_back(std::move(item.second));
+    return true;
+}
+
+// Bring the index up to `ledger` from the metadata of the ledgers since the
+// one it reflects. Returns false if that can't be done.
+bool
+OrderBookDB::catchUp(std::shared_ptr<ReadView const> const& ledger)
+{
+    LedgerIndex from;
+    uint256 fromHash;
+    {
+        std::lock_guard sl(mLock);
+        from = indexSeq_;
+        fromHash = indexHash_;
+    }
+
+    if (from == 0)
+        return false;
+    if (ledger->seq() <= from)
+        return ledger->seq() < from || ledger->info().hash == fromHash;
+    if (ledger->seq() - from > maxCatchUp)
+        return false;
+
+    // Find the ledgers in between by their parents, so that the changes are
+    // only applied to the index if it reflects an ancestor.
+    std::vector<std::shared_ptr<ReadView const>> ledgers{ledger};
+    while (ledgers.back()->seq() > from + 1)
+    {
+        auto parent = app_.getLedgerMaster().getLedgerByHash(
+            ledgers.back()->info().parentHash);
+        if (!parent)
+            return false;
+        ledgers.push_back(std::move(parent));
+    }
+    if (ledgers.back()->info().parentHash != fromHash)
+        return false;
+
+    std::vector<BookChange> changes;
+    try
+    {
+        for (auto iter = ledgers.rbegin(); iter != ledgers.rend(); ++iter)
+        {
+            if (!collectChanges(**iter, changes))
+            {
+                JLOG(j_.info()) << "Can't bring order books up to "
+                                << ledger->seq() << ": no metadata in "
+                                << (*iter)->seq();
+                return false;
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.info()) << "Can't bring order books up to " << ledger->seq()
+                        << ": " << e.what();
+        return false;
+    }
+
+    bool booksChanged = false;
+    {
+        std::lock_guard sl(mLock);
+        if (indexSeq_ != from || indexHash_ != fromHash)
+            return indexSeq_ >= ledger->seq();
+
+        for (auto const& change : changes)
+        {
+            auto& books = allBooks_[change.book.in];
+            auto& info = books[change.book.out];
+            bool const existed = info.exists();
+
+            if (change.directory && change.created)
+            {
+                ++info.directories;
+                info.added = false;
+            }
+            else if (change.directory)
+            {
+                if (info.directories != 0)
+                    --info.directories;
+            }
+            else
+                info.amm = change.created;
+
+            if (existed != info.exists())
+                booksChanged = true;
+            if (!info.exists())
+            {
+                books.erase(change.book.out);
+                if (books.empty())
+                    allBooks_.erase(change.book.in);
+            }
+        }
+
+        indexSeq_ = ledger->seq();
+        indexHash_ = ledger->info().hash;
+    }
+
+    JLOG(j_.debug()) << "Order books brought up to " << ledger->seq()
+                     << " with " << changes.size() << " changes";
+
+    if (booksChanged)
+        app_.getLedgerMaster().newOrderBookDB();
+    return true;
+}
+
+boost::filesystem::path
+OrderBookDB::snapshotPath() const
+{
+    auto const dbPath = app_.config().legacy("database_path");
+    if (dbPath.empty())
+        return {};
+    return boost::filesystem::path(dbPath) / "order_books.snapshot";
+}
+
+void
+OrderBookDB::saveSnapshot()
+{
+    auto const path = snapshotPath();
+    if (path.empty())
+        return;
+
+    Serializer s;
+    {
+        std::lock_guard sl(mLock);
+        if (indexSeq_ == 0)
+            return;
+
+        s.add32(snapshotVersion);
+        s.add32(indexSeq_);
+        s.addBitString(indexHash_);
+
+        std::uint32_t count = 0;
+        for (auto const& item : allBooks_)
+            count += item.second.size();
+        s.add32(count);
+
+        for (auto const& [in, books] : allBooks_)
+        {
+            for (auto const& [out, info] : books)
+            {
+                s.addBitString(in.currency);
+                s.addBitString(in.account);
+                s.addBitString(out.currency);
+                s.addBitString(out.account);
+                s.add8((info.amm ? 1 : 0) | (info.added ? 2 : 0));
+                s.add32(info.directories);
+            }
+        }
+    }
+
+    // Write a new file and then replace the old one, so that a crash
+    // never leaves a partial index behind.
+    std::lock_guard lock(snapshotMutex_);
+    auto temp = path;
+    temp += ".tmp";
+    boost::system::error_code ec;
+    {
+        std::ofstream out(temp.string(), std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<char const*>(s.data()), s.size());
+        if (!out)
+        {
+            JLOG(j_.warn()) << "Can't save order books to " << temp;
+            return;
+        }
+    }
+    boost::filesystem::rename(temp, path, ec);
+    if (ec)
+    {
+        JLOG(j_.warn()) << "Can't save order books to " << path << ": "
+                        << ec.message();
+    }
+}
+
+bool
+OrderBookDB::loadSnapshot()
+{
+    auto const path = snapshotPath();
+    boost::system::error_code ec;
+    if (path.empty() || !boost::filesystem::exists(path, ec))
+        return false;
+
+    Blob data;
+    {
+        std::ifstream in(path.string(), std::ios::binary);
+        data.assign(
+            std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>());
+    }
 
-    allBooks_[book.in].insert(book.out);
+    Books allBooks;
+    LedgerIndex seq;
+    uint256 hash;
+    try
+    {
+        SerialIter sit(makeSlice(data));
+        if (sit.get32() != snapshotVersion)
+            return false;
+        seq = sit.get32();
+        hash = sit.get256();
+
+        for (auto count = sit.get32(); count != 0; --count)
+        {
+            Book book;
+            book.in.currency = sit.get160();
+            book.in.account = sit.get160();
+            book.out.currency = sit.get160();
+            book.out.account = sit.get160();
+
+            auto& info = allBooks[book.in][book.out];
+            auto const flags = sit.get8();
+            info.amm = (flags & 1) != 0;
+            info.added = (flags & 2) != 0;
+            info.directories = sit.get32();
+        }
+
+        if (!sit.empty())
+            return false;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Can't load order books from " << path << ": "
+                        << e.what();
+        return false;
+    }
 
-    if (toXRP)
-        xrpBooks_.insert(book.in);
+    JLOG(j_.info()) << "Loaded order books as of ledger " << seq;
+
+    std::lock_guard sl(mLock);
+    allBooks_.swap(allBooks);
+    indexSeq_ = seq;
+    indexHash_ = hash;
+    return true;
+}
+
+void
+OrderBookDB::addOrderBook(Book const& book)
+{
+    std::lock_guard sl(mLock);
+    allBooks_[book.in][book.out].added = true;
 }
 
 // return list of all orderbooks that want this issuerID and currencyID
@@ -191,7 +552,7 @@ OrderBookDB::getBooksByTakerPays(Issue const& issue)
             ret.reserve(it->second.size());
 
             for (auto const& gets : it->second)
-                ret.push_back(Book(issue, gets));
+                ret.push_back(Book(issue, gets.first));
         }
     }
 
@@ -211,7 +572,9 @@ bool
 OrderBookDB::isBookToXRP(Issue const& issue)
 {
     std::lock_guard sl(mLock);
-    return xrpBooks_.count(issue) > 0;
+    if (auto it = allBooks_.find(issue); it != allBooks_.end())
+        return it->second.count(xrpIssue()) > 0;
+    return false;
 }
 
 BookListeners::pointer
@@ -250,7 +613,7 @@ void
 OrderBookDB::processTxn(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& alTx,
-    MultiApiJson const& jvObj)
+    MultiApiSharedJson const& jvObj)
 {
     std::lock_guard sl(mLock);
 
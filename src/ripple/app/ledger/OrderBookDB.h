@@ -23,12 +23,23 @@
 #include <ripple/app/ledger/AcceptedLedgerTx.h>
 #include <ripple/app/ledger/BookListeners.h>
 #include <ripple/app/main/Application.h>
-#include <ripple/json/MultivarJson.h>
+#include <ripple/json/SharedJson.h>
 
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
 #include <mutex>
 
 namespace ripple {
 
+/** The order books in the ledger, for pathfinding and subscriptions.
+
+    The index is built by walking a whole ledger once, and then kept up
+    to date from the metadata of each published ledger, which records the
+    book directories and AMMs created and deleted. It is saved every so
+    often under the database path, so that after a restart only the
+    ledgers since need to be read.
+*/
 class OrderBookDB
 {
 public:
@@ -39,6 +50,15 @@ public:
     void
     update(std::shared_ptr<ReadView const> const& ledger);
 
+    /** Bring the index up to a published ledger.
+
+        The changes to books made by the ledger, and by any ledgers between
+        it and the one the index reflects, are read from their metadata.
+        If that can't be done, a full update is started.
+    */
+    void
+    applyLedger(std::shared_ptr<ReadView const> const& ledger);
+
     void
     addOrderBook(Book const&);
 
@@ -65,19 +85,78 @@ public:
     processTxn(
         std::shared_ptr<ReadView const> const& ledger,
         const AcceptedLedgerTx& alTx,
-        MultiApiJson const& jvObj);
+        MultiApiSharedJson const& jvObj);
 
 private:
-    Application& app_;
+    struct BookInfo
+    {
+        // The number of the book's directories of offers, one per quality
+        std::uint32_t directories = 0;
+
+        // Whether an AMM trades the book
+        bool amm = false;
+
+        // Whether an offer was placed in the book since the index was
+        // last updated
+        bool added = false;
+
+        bool
+        exists() const
+        {
+            return directories != 0 || amm || added;
+        }
+    };
 
     // Maps order books by "issue in" to "issue out":
-    hardened_hash_map<Issue, hardened_hash_set<Issue>> allBooks_;
+    using Books = hardened_hash_map<Issue, hardened_hash_map<Issue, BookInfo>>;
+
+    // A book directory or AMM created or deleted by a transaction
+    struct BookChange
+    {
+        Book book;
 
-    // does an order book to XRP exist
-    hash_set<Issue> xrpBooks_;
+        // Whether a book directory changed, rather than an AMM
+        bool directory;
+
+        bool created;
+    };
+
+    // Adds the changes made to books by a ledger's transactions. Returns
+    // false if a transaction has no metadata.
+    static bool
+    collectChanges(ReadView const& ledger, std::vector<BookChange>& changes);
+
+    bool
+    catchUp(std::shared_ptr<ReadView const> const& ledger);
+
+    boost::filesystem::path
+    snapshotPath() const;
+
+    void
+    saveSnapshot();
+
+    bool
+    loadSnapshot();
+
+    Application& app_;
+
+    Books allBooks_;
+
+    // The ledger the index reflects, or zero
+    LedgerIndex indexSeq_ = 0;
+    uint256 indexHash_;
 
     std::recursive_mutex mLock;
 
+    // Whether a full update has been started and not yet finished
+    std::atomic<bool> updating_{false};
+
+    // Whether a saved index was looked for
+    std::atomic<bool> snapshotTried_{false};
+
+    // Serializes saving the index
+    std::mutex snapshotMutex_;
+
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
 
     BookToListenersMap mListeners;
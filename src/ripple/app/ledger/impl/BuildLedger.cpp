@@ -24,17 +24,204 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/PerfLog.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Feature.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STAccount.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace ripple {
 
+namespace {
+
+// The most jobs that prefetch for a ledger being built, besides the thread
+// applying its transactions.
+constexpr std::size_t maxPrefetchJobs = 8;
+
+/** Add the keys of the ledger entries a transaction is likely to use.
+
+    These are the roots and owner directories of the accounts it names,
+    their trust lines in the currencies it names, its signer list and the
+    offer it cancels. Reading an entry that turns out to be missing or
+    unused costs no more than the read.
+*/
+void
+addPrefetchKeys(STTx const& tx, std::vector<Keylet>& keys)
+{
+    std::vector<AccountID> accounts;
+    std::vector<Issue> issues;
+    for (auto const& field : tx)
+    {
+        if (field.getSType() == STI_ACCOUNT)
+        {
+            accounts.push_back(static_cast<STAccount const&>(field).value());
+        }
+        else if (field.getSType() == STI_AMOUNT)
+        {
+            auto const& amount = static_cast<STAmount const&>(field);
+            if (!amount.native())
+                issues.push_back(amount.issue());
+        }
+    }
+
+    for (auto const& issue : issues)
+        keys.push_back(keylet::account(issue.account));
+    for (auto const& id : accounts)
+    {
+        keys.push_back(keylet::account(id));
+        keys.push_back(keylet::ownerDir(id));
+        for (auto const& issue : issues)
+        {
+            if (id != issue.account)
+                keys.push_back(keylet::line(id, issue));
+        }
+    }
+
+    auto const account = tx.getAccountID(sfAccount);
+    if (tx.isFieldPresent(sfSigners))
+        keys.push_back(keylet::signers(account));
+    if (tx.isFieldPresent(sfOfferSequence))
+        keys.push_back(
+            keylet::offer(account, tx.getFieldU32(sfOfferSequence)));
+}
+
+/** Prefetches for the transactions of a ledger being built.
+
+    Jobs running ahead of the thread applying the transactions read the
+    ledger entries each is likely to use through the cached view it is
+    applied over, and check its signature, which records the result in
+    the HashRouter. Applying a transaction then rarely waits for either.
+
+    The ledger under the view must not change until stop() has returned.
+*/
+class Prefetcher
+{
+    struct Work
+    {
+        std::vector<std::shared_ptr<STTx const>> txs;
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::atomic<bool> stopped{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t running = 0;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    std::shared_ptr<Work> work_;
+
+    // Prefetch for transactions until all are claimed or prefetching is
+    // stopped.
+    static void
+    run(Application& app, ReadView const& view, Work& w)
+    {
+        {
+            std::lock_guard lock(w.mutex);
+            if (w.stopped)
+                return;
+            ++w.running;
+        }
+
+        std::vector<Keylet> keys;
+        while (!w.stopped)
+        {
+            auto const i = w.next++;
+            if (i >= w.txs.size())
+                break;
+
+            auto const& tx = *w.txs[i];
+            try
+            {
+                checkValidity(
+                    app.getHashRouter(), tx, view.rules(), app.config());
+                keys.clear();
+                addPrefetchKeys(tx, keys);
+                for (auto const& k : keys)
+                    view.read(k);
+            }
+            catch (std::exception const&)
+            {
+                // Applying the transaction reports the problem.
+            }
+
+            if (++w.done == w.txs.size())
+            {
+                using namespace std::chrono;
+                app.getPerfLog().phaseFinish(
+                    "buildLedger.prefetch",
+                    duration_cast<microseconds>(
+                        steady_clock::now() - w.start));
+            }
+        }
+
+        std::lock_guard lock(w.mutex);
+        if (--w.running == 0)
+            w.cv.notify_all();
+    }
+
+public:
+    /** Start prefetching.
+
+        @param txs A map whose values are the transactions, in the order
+                   they will be applied
+    */
+    template <class Txs>
+    Prefetcher(Application& app, ReadView const& view, Txs const& txs)
+        : work_(std::make_shared<Work>())
+    {
+        for (auto const& item : txs)
+            work_->txs.push_back(item.second);
+        work_->start = std::chrono::steady_clock::now();
+
+        auto const jobs = std::min(work_->txs.size(), maxPrefetchJobs);
+        for (std::size_t i = 0; i < jobs; ++i)
+        {
+            if (!app.getJobQueue().addJob(
+                    jtACCEPT,
+                    "buildLedger.prefetch",
+                    [&app, &view, work = work_]() { run(app, view, *work); }))
+                break;
+        }
+    }
+
+    Prefetcher(Prefetcher const&) = delete;
+    Prefetcher&
+    operator=(Prefetcher const&) = delete;
+
+    ~Prefetcher()
+    {
+        stop();
+    }
+
+    /** Stop prefetching, and wait for the jobs doing it.
+
+        Jobs that have yet to start do nothing.
+    */
+    void
+    stop()
+    {
+        std::unique_lock lock(work_->mutex);
+        work_->stopped = true;
+        work_->cv.wait(lock, [this] { return work_->running == 0; });
+    }
+};
+
+}  // namespace
+
 /* Generic buildLedgerImpl that dispatches to ApplyTxs invocable with signature
     void(OpenView&, std::shared_ptr<Ledger> const&)
    It is responsible for adding transactions to the open view to generate the
    new ledger. It is generic since the mechanics differ for consensus
-   generated ledgers versus replayed ledgers.
+   generated ledgers versus replayed ledgers. Txs maps to the transactions
+   ApplyTxs will apply, in order, for prefetching.
 */
-template <class ApplyTxs>
+template <class Txs, class ApplyTxs>
 std::shared_ptr<Ledger>
 buildLedgerImpl(
     std::shared_ptr<Ledger const> const& parent,
@@ -43,6 +230,7 @@ buildLedgerImpl(
     NetClock::duration closeResolution,
     Application& app,
     beast::Journal j,
+    Txs const& txs,
     ApplyTxs&& applyTxs)
 {
     auto built = std::make_shared<Ledger>(*parent, closeTime);
@@ -56,9 +244,29 @@ buildLedgerImpl(
     //   perform updates, extract changes
 
     {
-        OpenView accum(&*built);
+        // With [parallel_ledger_build], the transactions are applied over a
+        // cache that is filled ahead of them.
+        std::optional<CachedLedger> cached;
+        std::optional<Prefetcher> prefetcher;
+        if (app.config().PARALLEL_LEDGER_BUILD)
+        {
+            cached.emplace(built, app.cachedSLEs());
+            prefetcher.emplace(app, *cached, txs);
+        }
+
+        OpenView accum(
+            cached ? static_cast<ReadView const*>(&*cached) : &*built);
         assert(!accum.open());
+
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
         applyTxs(accum, built);
+        app.getPerfLog().phaseFinish(
+            "buildLedger.applyTransactions",
+            duration_cast<microseconds>(steady_clock::now() - start));
+
+        if (prefetcher)
+            prefetcher->stop();
         accum.apply(*built);
     }
 
@@ -67,10 +275,20 @@ buildLedgerImpl(
         // Write the final version of all modified SHAMap
         // nodes to the node store to preserve the new LCL
 
-        int const asf = built->stateMap().flushDirty(hotACCOUNT_NODE);
-        int const tmf = built->txMap().flushDirty(hotTRANSACTION_NODE);
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+
+        int const asf = built->stateMap().flushDirty(
+            hotACCOUNT_NODE, app.getJobQueue());
+        int const tmf = built->txMap().flushDirty(
+            hotTRANSACTION_NODE, app.getJobQueue());
+
+        auto const elapsed =
+            duration_cast<microseconds>(steady_clock::now() - start);
+        app.getPerfLog().phaseFinish("buildLedger.flushDirty", elapsed);
         JLOG(j.debug()) << "Flushed " << asf << " accounts and " << tmf
-                        << " transaction nodes";
+                        << " transaction nodes in " << elapsed.count()
+                        << "us";
     }
     built->unshare();
 
@@ -196,6 +414,7 @@ buildLedger(
         closeResolution,
         app,
         j,
+        txns,
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
             JLOG(j.debug())
                 << "Attempting to apply " << txns.size() << " transactions";
@@ -231,6 +450,7 @@ buildLedger(
         replayLedger->info().closeTimeResolution,
         app,
         j,
+        replayData.orderedTxns(),
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
             for (auto& tx : replayData.orderedTxns())
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
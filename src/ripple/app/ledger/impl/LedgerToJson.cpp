@@ -312,7 +312,7 @@ fillJsonQueue(Object& json, LedgerFill const& fill)
         if (fill.context->apiVersion > 1)
             copyFrom(txJson, temp);
         else
-            copyFrom(txJson[jss::tx], temp);
+            txJson[jss::tx] = temp;
     }
 }
 
@@ -341,16 +341,32 @@ fillJson(Object& json, LedgerFill const& fill)
         fillJsonState(json, fill);
 }
 
+template <class Object>
+void
+addJsonImpl(Object& json, LedgerFill const& fill)
+{
+    {
+        // A Json::Object must be closed before its parent can be written.
+        auto&& object = Json::addObject(json, jss::ledger);
+        fillJson(object, fill);
+    }
+
+    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
+        fillJsonQueue(json, fill);
+}
+
 }  // namespace
 
 void
 addJson(Json::Value& json, LedgerFill const& fill)
 {
-    auto&& object = Json::addObject(json, jss::ledger);
-    fillJson(object, fill);
+    addJsonImpl(json, fill);
+}
 
-    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
-        fillJsonQueue(json, fill);
+void
+addJson(Json::Object& json, LedgerFill const& fill)
+{
+    addJsonImpl(json, fill);
 }
 
 Json::Value
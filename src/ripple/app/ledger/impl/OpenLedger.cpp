@@ -22,6 +22,7 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/ledger/CachedView.h>
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/Overlay.h>
@@ -29,8 +30,241 @@
 #include <ripple/protocol/Feature.h>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <set>
+
 namespace ripple {
 
+namespace {
+
+// The fewest transactions worth applying speculatively.
+constexpr std::size_t minSpeculativeBatch = 64;
+
+// How many transactions are applied speculatively against the same view.
+// Each holds a view of its own until it is merged.
+constexpr std::size_t speculativeChunk = 256;
+
+// The most jobs that apply transactions speculatively, besides the thread
+// that merges them.
+constexpr std::size_t maxSpeculativeJobs = 8;
+
+/** Forwards reads to a view, recording what was read.
+
+    The keys of the ledger entries read, and the key ranges searched by
+    succ, are recorded so that a transaction applied on top of this view
+    can be checked against the entries written since.
+*/
+class ReadRecorder : public ReadView
+{
+    ReadView const& base_;
+
+public:
+    // The keys of the entries and transactions read
+    std::vector<uint256> mutable keys;
+
+    // The ranges of keys searched for a successor, without their first
+    // key. A range without a last key is unbounded.
+    std::vector<std::pair<uint256, std::optional<uint256>>> mutable ranges;
+
+    // Whether the entries or transactions were iterated, which cannot be
+    // checked by key
+    bool mutable readAll = false;
+
+    explicit ReadRecorder(ReadView const& base) : base_(base)
+    {
+    }
+
+    /** Whether anything that was read is among the keys written. */
+    bool
+    conflicts(std::set<uint256> const& written) const
+    {
+        if (written.empty())
+            return false;
+        if (readAll)
+            return true;
+        for (auto const& key : keys)
+        {
+            if (written.count(key) != 0)
+                return true;
+        }
+        for (auto const& [first, last] : ranges)
+        {
+            auto const iter = written.upper_bound(first);
+            if (iter != written.end() && (!last || *iter <= *last))
+                return true;
+        }
+        return false;
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override
+    {
+        keys.push_back(k.key);
+        return base_.exists(k);
+    }
+
+    std::optional<key_type>
+    succ(
+        key_type const& key,
+        std::optional<key_type> const& last = std::nullopt) const override
+    {
+        auto const next = base_.succ(key, last);
+        ranges.emplace_back(key, next ? next : last);
+        return next;
+    }
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override
+    {
+        keys.push_back(k.key);
+        return base_.read(k);
+    }
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        readAll = true;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        readAll = true;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        readAll = true;
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        readAll = true;
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        readAll = true;
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        keys.push_back(key);
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        keys.push_back(key);
+        return base_.txRead(key);
+    }
+};
+
+/** Forwards changes to an open view, recording the keys of the entries and
+    transactions written.
+*/
+class WriteRecorder : public TxsRawView
+{
+    OpenView& to_;
+    std::set<uint256>& written_;
+
+public:
+    WriteRecorder(OpenView& to, std::set<uint256>& written)
+        : to_(to), written_(written)
+    {
+    }
+
+    void
+    rawErase(std::shared_ptr<SLE> const& sle) override
+    {
+        written_.insert(sle->key());
+        to_.rawErase(sle);
+    }
+
+    void
+    rawInsert(std::shared_ptr<SLE> const& sle) override
+    {
+        written_.insert(sle->key());
+        to_.rawInsert(sle);
+    }
+
+    void
+    rawReplace(std::shared_ptr<SLE> const& sle) override
+    {
+        written_.insert(sle->key());
+        to_.rawReplace(sle);
+    }
+
+    void
+    rawDestroyXRP(XRPAmount const& fee) override
+    {
+        to_.rawDestroyXRP(fee);
+    }
+
+    void
+    rawTxInsert(
+        ReadView::key_type const& key,
+        std::shared_ptr<Serializer const> const& txn,
+        std::shared_ptr<Serializer const> const& metaData) override
+    {
+        written_.insert(key);
+        to_.rawTxInsert(key, txn, metaData);
+    }
+};
+
+}  // namespace
+
 OpenLedger::OpenLedger(
     std::shared_ptr<Ledger const> const& ledger,
     CachedSLEs& cache,
@@ -175,6 +409,170 @@ OpenLedger::apply_one(
     return Result::retry;
 }
 
+void
+OpenLedger::applyFirstPass(
+    Application& app,
+    OpenView& view,
+    std::vector<std::shared_ptr<STTx const>> const& txs,
+    OrderedTxs& retries,
+    ApplyFlags flags,
+    beast::Journal j)
+{
+    if (app.config().SPECULATIVE_APPLY && txs.size() >= minSpeculativeBatch)
+        return applySpeculative(app, view, txs, retries, flags, j);
+
+    for (auto const& tx : txs)
+    {
+        try
+        {
+            auto const result = apply_one(app, view, tx, true, flags, j);
+            if (result == Result::retry)
+                retries.insert(tx);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j.error())
+                << "OpenLedger::apply: Caught exception: " << e.what();
+        }
+    }
+}
+
+void
+OpenLedger::applySpeculative(
+    Application& app,
+    OpenView& view,
+    std::vector<std::shared_ptr<STTx const>> const& txs,
+    OrderedTxs& retries,
+    ApplyFlags flags,
+    beast::Journal j)
+{
+    // A transaction applied on its own to a view of the chunk's view.
+    struct Speculation
+    {
+        std::shared_ptr<STTx const> tx;
+        std::optional<ReadRecorder> reads;
+        std::optional<OpenView> view;
+        Result result = Result::failure;
+        std::string error;
+    };
+
+    // The transactions of a chunk are applied by jobs and by this thread,
+    // in the order they are claimed. The chunk's view is not modified until
+    // all of them are done.
+    struct Work
+    {
+        std::vector<Speculation> specs;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+    };
+
+    // Apply the next unclaimed transaction. Returns false once there are
+    // none left.
+    auto const speculateNext = [&app, &view, flags, j](Work& w) {
+        auto const i = w.next++;
+        if (i >= w.specs.size())
+            return false;
+
+        auto& spec = w.specs[i];
+        try
+        {
+            spec.reads.emplace(view);
+            spec.view.emplace(single_tx, &*spec.reads);
+            spec.result = apply_one(app, *spec.view, spec.tx, true, flags, j);
+        }
+        catch (std::exception const& e)
+        {
+            spec.view.reset();
+            spec.error = e.what();
+        }
+
+        std::lock_guard lock(w.mutex);
+        ++w.done;
+        w.cv.notify_all();
+        return true;
+    };
+
+    std::size_t reapplied = 0;
+    std::set<uint256> written;
+    WriteRecorder to(view, written);
+
+    for (std::size_t first = 0; first < txs.size(); first += speculativeChunk)
+    {
+        auto const count = std::min(speculativeChunk, txs.size() - first);
+
+        auto work = std::make_shared<Work>();
+        work->specs.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            work->specs[i].tx = txs[first + i];
+
+        auto const jobs = std::min(count - 1, maxSpeculativeJobs);
+        for (std::size_t i = 0; i < jobs; ++i)
+        {
+            if (!app.getJobQueue().addJob(
+                    jtACCEPT, "OpenLedger.speculate", [work, speculateNext]() {
+                        while (speculateNext(*work))
+                            ;
+                    }))
+                break;
+        }
+
+        while (speculateNext(*work))
+            ;
+        {
+            std::unique_lock lock(work->mutex);
+            work->cv.wait(lock, [&] { return work->done == count; });
+        }
+
+        // Merge in order. Whatever this chunk's transactions read is
+        // checked against what the ones merged before them wrote.
+        written.clear();
+        for (auto& spec : work->specs)
+        {
+            // A transaction whose speculation failed before it could
+            // record its reads is reapplied, like one with a conflict.
+            Result result;
+            if (spec.reads && !spec.reads->conflicts(written))
+            {
+                if (!spec.view)
+                {
+                    JLOG(j.error()) << "OpenLedger::apply: Caught exception: "
+                                    << spec.error;
+                    continue;
+                }
+                spec.view->apply(to);
+                result = spec.result;
+            }
+            else
+            {
+                ++reapplied;
+                try
+                {
+                    OpenView serial(&view);
+                    result = apply_one(app, serial, spec.tx, true, flags, j);
+                    serial.apply(to);
+                }
+                catch (std::exception const& e)
+                {
+                    JLOG(j.error())
+                        << "OpenLedger::apply: Caught exception: " << e.what();
+                    continue;
+                }
+            }
+
+            if (result == Result::retry)
+                retries.insert(spec.tx);
+
+            spec.view.reset();
+            spec.reads.reset();
+        }
+    }
+
+    JLOG(j.debug()) << "Applied " << txs.size()
+                    << " transactions speculatively, reapplied " << reapplied;
+}
+
 //------------------------------------------------------------------------------
 
 std::string
@@ -326,9 +326,12 @@ public:
               m_collectorManager->group("jobq"),
               logs_->journal("JobQueue"),
               *logs_,
-              *perfLog_))
+              *perfLog_,
+              config_->WORKERS_STEAL))
 
-        , m_nodeStoreScheduler(*m_jobQueue)
+        , m_nodeStoreScheduler(
+              *m_jobQueue,
+              m_collectorManager->group("nodestore"))
 
         , m_shaMapStore(make_SHAMapStore(
               *this,
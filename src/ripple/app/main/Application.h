@@ -60,11 +60,19 @@ template <
     bool IsKeyCache,
     class Hash,
     class KeyEqual,
-    class Mutex>
+    class Mutex,
+    bool PartitionLocks>
 class TaggedCache;
 class STLedgerEntry;
 using SLE = STLedgerEntry;
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+using CachedSLEs = TaggedCache<
+    uint256,
+    SLE const,
+    /*IsKeyCache*/ false,
+    hardened_hash<>,
+    std::equal_to<uint256>,
+    std::recursive_mutex,
+    /*PartitionLocks*/ true>;
 
 class CollectorManager;
 class Family;
@@ -22,7 +22,13 @@
 
 namespace ripple {
 
-NodeStoreScheduler::NodeStoreScheduler(JobQueue& jobQueue) : jobQueue_(jobQueue)
+NodeStoreScheduler::NodeStoreScheduler(
+    JobQueue& jobQueue,
+    beast::insight::Collector::ptr const& collector)
+    : jobQueue_(jobQueue)
+    , write_(collector->make_event("write"))
+    , encode_(collector->make_event("encode"))
+    , queue_(collector->make_event("write_queue"))
 {
 }
 
@@ -62,6 +68,10 @@ NodeStoreScheduler::onBatchWrite(NodeStore::BatchWriteReport const& report)
         return;
 
     jobQueue_.addLoadEvents(jtNS_WRITE, report.writeCount, report.elapsed);
+
+    write_.notify(report.elapsed);
+    encode_.notify(report.encodeElapsed);
+    queue_.notify(report.queueElapsed);
 }
 
 }  // namespace ripple
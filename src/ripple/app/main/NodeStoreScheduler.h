@@ -20,6 +20,8 @@
 #ifndef RIPPLE_APP_MAIN_NODESTORESCHEDULER_H_INCLUDED
 #define RIPPLE_APP_MAIN_NODESTORESCHEDULER_H_INCLUDED
 
+#include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/insight/Event.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <atomic>
@@ -30,7 +32,9 @@ namespace ripple {
 class NodeStoreScheduler : public NodeStore::Scheduler
 {
 public:
-    explicit NodeStoreScheduler(JobQueue& jobQueue);
+    NodeStoreScheduler(
+        JobQueue& jobQueue,
+        beast::insight::Collector::ptr const& collector);
 
     void
     scheduleTask(NodeStore::Task& task) override;
@@ -41,6 +45,11 @@ public:
 
 private:
     JobQueue& jobQueue_;
+
+    // Latencies of batch writes
+    beast::insight::Event write_;
+    beast::insight::Event encode_;
+    beast::insight::Event queue_;
 };
 
 }  // namespace ripple
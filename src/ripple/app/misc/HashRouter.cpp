@@ -22,29 +22,42 @@
 namespace ripple {
 
 auto
-HashRouter::emplace(uint256 const& key) -> std::pair<Entry&, bool>
+HashRouter::emplace(Shard& shard, uint256 const& key)
+    -> std::pair<Entry&, bool>
 {
-    auto iter = suppressionMap_.find(key);
+    auto& suppressionMap = shard.suppressionMap;
+    auto iter = suppressionMap.find(key);
 
-    if (iter != suppressionMap_.end())
+    if (iter != suppressionMap.end())
     {
-        suppressionMap_.touch(iter);
-        return std::make_pair(std::ref(iter->second), false);
+        if (iter.when().time_since_epoch().count() > expired_.load())
+        {
+            suppressionMap.touch(iter);
+            return std::make_pair(std::ref(iter->second), false);
+        }
+
+        // Expired by an entry added since, but not swept yet
+        suppressionMap.erase(iter);
     }
 
     // See if any supressions need to be expired
-    expire(suppressionMap_, holdTime_);
+    auto const expired = (clock_.now() - holdTime_).time_since_epoch().count();
+    for (auto prior = expired_.load();
+         prior < expired && !expired_.compare_exchange_weak(prior, expired);)
+        ;
+    expire(suppressionMap, holdTime_);
 
     return std::make_pair(
-        std::ref(suppressionMap_.emplace(key, Entry()).first->second), true);
+        std::ref(suppressionMap.emplace(key, Entry()).first->second), true);
 }
 
 void
 HashRouter::addSuppression(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    emplace(key);
+    emplace(s, key);
 }
 
 bool
@@ -56,9 +69,10 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer)
 std::pair<bool, std::optional<Stopwatch::time_point>>
 HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    auto result = emplace(key);
+    auto result = emplace(s, key);
     result.first.addPeer(peer);
     return {result.second, result.first.relayed()};
 }
@@ -66,11 +80,12 @@ HashRouter::addSuppressionPeerWithStatus(const uint256& key, PeerShortID peer)
 bool
 HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    auto [s, created] = emplace(key);
-    s.addPeer(peer);
-    flags = s.getFlags();
+    auto [entry, created] = emplace(s, key);
+    entry.addPeer(peer);
+    flags = entry.getFlags();
     return created;
 }
 
@@ -81,21 +96,22 @@ HashRouter::shouldProcess(
     int& flags,
     std::chrono::seconds tx_interval)
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    auto result = emplace(key);
-    auto& s = result.first;
-    s.addPeer(peer);
-    flags = s.getFlags();
-    return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
+    auto& entry = emplace(s, key).first;
+    entry.addPeer(peer);
+    flags = entry.getFlags();
+    return entry.shouldProcess(clock_.now(), tx_interval);
 }
 
 int
 HashRouter::getFlags(uint256 const& key)
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    return emplace(key).first.getFlags();
+    return emplace(s, key).first.getFlags();
 }
 
 bool
@@ -103,14 +119,15 @@ HashRouter::setFlags(uint256 const& key, int flags)
 {
     assert(flags != 0);
 
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    auto& s = emplace(key).first;
+    auto& entry = emplace(s, key).first;
 
-    if ((s.getFlags() & flags) == flags)
+    if ((entry.getFlags() & flags) == flags)
         return false;
 
-    s.setFlags(flags);
+    entry.setFlags(flags);
     return true;
 }
 
@@ -118,14 +135,15 @@ auto
 HashRouter::shouldRelay(uint256 const& key)
     -> std::optional<std::set<PeerShortID>>
 {
-    std::lock_guard lock(mutex_);
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
 
-    auto& s = emplace(key).first;
+    auto& entry = emplace(s, key).first;
 
-    if (!s.shouldRelay(suppressionMap_.clock().now(), holdTime_))
+    if (!entry.shouldRelay(clock_.now(), holdTime_))
         return {};
 
-    return s.releasePeerSet();
+    return entry.releasePeerSet();
 }
 
 }  // namespace ripple
@@ -24,9 +24,15 @@
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/basics/chrono.h>
+#include <ripple/basics/hardened_hash.h>
 #include <ripple/beast/container/aged_unordered_map.h>
 
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -144,8 +150,11 @@ public:
     }
 
     HashRouter(Stopwatch& clock, std::chrono::seconds entryHoldTimeInSeconds)
-        : suppressionMap_(clock), holdTime_(entryHoldTimeInSeconds)
+        : clock_(clock), holdTime_(entryHoldTimeInSeconds)
     {
+        shards_.reserve(shardCount);
+        for (std::size_t i = 0; i < shardCount; ++i)
+            shards_.push_back(std::make_unique<Shard>(clock));
     }
 
     HashRouter&
@@ -206,19 +215,47 @@ public:
     shouldRelay(uint256 const& key);
 
 private:
+    static constexpr std::size_t shardCount = 64;
+
+    // The table is split by hash into shards with a lock each, so that
+    // peers relaying different messages don't wait on each other.
+    struct Shard
+    {
+        explicit Shard(Stopwatch& clock) : suppressionMap(clock)
+        {
+        }
+
+        std::mutex mutex;
+
+        // Stores the suppressed hashes in this shard and their last access
+        beast::aged_unordered_map<
+            uint256,
+            Entry,
+            Stopwatch::clock_type,
+            hardened_hash<strong_hash>>
+            suppressionMap;
+    };
+
+    Shard&
+    shard(uint256 const& key)
+    {
+        return *shards_[shardIndex(key, shardCount)];
+    }
+
     // pair.second indicates whether the entry was created
     std::pair<Entry&, bool>
-    emplace(uint256 const&);
+    emplace(Shard& shard, uint256 const& key);
+
+    Stopwatch& clock_;
 
-    std::mutex mutable mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
-    // Stores all suppressed hashes and their expiration time
-    beast::aged_unordered_map<
-        uint256,
-        Entry,
-        Stopwatch::clock_type,
-        hardened_hash<strong_hash>>
-        suppressionMap_;
+    // Adding an entry expires every entry not accessed within the hold
+    // time. Only the shard the entry goes into is swept then; the entries
+    // in the others that were last accessed at or before this time are
+    // treated as gone when they are next looked up.
+    std::atomic<Stopwatch::duration::rep> expired_{
+        std::numeric_limits<Stopwatch::duration::rep>::min()};
 
     std::chrono::seconds const holdTime_;
 };
@@ -54,7 +54,9 @@
 #include <ripple/crypto/RFC1751.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/MultivarJson.h>
+#include <ripple/json/SharedJson.h>
 #include <ripple/json/to_string.h>
+#include <ripple/net/AccountSubscriptions.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/overlay/Cluster.h>
@@ -74,6 +76,9 @@
 #include <boost/asio/steady_timer.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -609,16 +614,43 @@ private:
         std::shared_ptr<ReadView const> const& ledger,
         std::optional<std::reference_wrapper<TxMeta const>> meta);
 
+    // What is needed to publish a validated transaction, made in parallel
+    // with the other transactions in its ledger.
+    struct PublishedTransaction
+    {
+        std::optional<MultiApiJson> json;
+        // Refers to json, so must be released before it
+        std::optional<MultiApiSharedJson> msg;
+        // The subscribers to the accounts it affects
+        hash_set<InfoSub::pointer> notify;
+        std::size_t proposed = 0;
+        std::size_t accepted = 0;
+    };
+
+    void
+    prepareTransaction(
+        std::shared_ptr<ReadView const> const& ledger,
+        AcceptedLedgerTx const& transaction,
+        std::array<bool, MultiApiJson::size> const& versions,
+        PublishedTransaction& published);
+
+    void
+    pubValidatedTransactions(
+        std::shared_ptr<ReadView const> const& ledger,
+        std::shared_ptr<AcceptedLedger> const& accepted);
+
     void
     pubValidatedTransaction(
         std::shared_ptr<ReadView const> const& ledger,
         AcceptedLedgerTx const& transaction,
+        PublishedTransaction& published,
         bool last);
 
     void
     pubAccountTransaction(
         std::shared_ptr<ReadView const> const& ledger,
         AcceptedLedgerTx const& transaction,
+        PublishedTransaction& published,
         bool last);
 
     void
@@ -637,7 +669,6 @@ private:
 
 private:
     using SubMapType = hash_map<std::uint64_t, InfoSub::wptr>;
-    using SubInfoMapType = hash_map<AccountID, SubMapType>;
     using subRpcMapType = hash_map<std::string, InfoSub::pointer>;
 
     /*
@@ -727,8 +758,20 @@ private:
 
     LedgerMaster& m_ledgerMaster;
 
-    SubInfoMapType mSubAccount;
-    SubInfoMapType mSubRTAccount;
+    // These have locks of their own, and are not protected by mSubLock.
+    AccountSubscriptions mSubAccount;
+    AccountSubscriptions mSubRTAccount;
+
+    // The most jobs that prepare a ledger's transactions for publication,
+    // besides the thread publishing it.
+    static constexpr std::size_t maxPublishJobs = 8;
+
+    // The last ledger published, how long that took, and how long after
+    // its close time it was done.
+    std::atomic<LedgerIndex> publishedSeq_{0};
+    std::atomic<std::int64_t> publishDuration_{0};
+    std::atomic<std::int64_t> publishMaxDuration_{0};
+    std::atomic<std::uint32_t> publishLag_{0};
 
     subRpcMapType mRpcSubMap;
 
@@ -1978,12 +2021,13 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::domain] = mo.domain;
         jvObj[jss::manifest] = strHex(mo.serialized);
 
+        SharedJson const msg{jvObj};
         for (auto i = mStreamMaps[sManifests].begin();
              i != mStreamMaps[sManifests].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2081,6 +2125,7 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
+        SharedJson const msg{jvObj};
         for (auto i = mStreamMaps[sServer].begin();
              i != mStreamMaps[sServer].end();)
         {
@@ -2091,7 +2136,7 @@ NetworkOPsImp::pubServer()
             //             sending of JSON data.
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2114,11 +2159,12 @@ NetworkOPsImp::pubConsensus(ConsensusPhase phase)
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
+        SharedJson const msg{jvObj};
         for (auto i = streamMap.begin(); i != streamMap.end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2221,13 +2267,14 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
                 }
             });
 
+        MultiApiSharedJson const msg{multiObj};
         for (auto i = mStreamMaps[sValidations].begin();
              i != mStreamMaps[sValidations].end();)
         {
             if (auto p = i->second.lock())
             {
                 p->send(
-                    multiObj.select(apiVersionSelector(p->getApiVersion())),
+                    msg.select(apiVersionSelector(p->getApiVersion())),
                     true);
                 ++i;
             }
@@ -2250,6 +2297,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
         jvObj[jss::type] = "peerStatusChange";
 
+        SharedJson const msg{jvObj};
         for (auto i = mStreamMaps[sPeerStatus].begin();
              i != mStreamMaps[sPeerStatus].end();)
         {
@@ -2257,7 +2305,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2668,6 +2716,15 @@ NetworkOPsImp::getServerInfo(bool human, bool admin, bool counters)
             info[jss::published_ledger] = "none";
         else if (lpPublished->info().seq != lpClosed->info().seq)
             info[jss::published_ledger] = lpPublished->info().seq;
+
+        if (auto const seq = publishedSeq_.load(); seq != 0)
+        {
+            Json::Value& p = info[jss::ledger_publish] = Json::objectValue;
+            p[jss::ledger_index] = seq;
+            p[jss::duration_us] = std::to_string(publishDuration_);
+            p[jss::max_duration_us] = std::to_string(publishMaxDuration_);
+            p[jss::lag_s] = Json::UInt(publishLag_);
+        }
     }
 
     accounting_.json(info);
@@ -2758,6 +2815,7 @@ NetworkOPsImp::pubProposedTransaction(
     {
         std::lock_guard sl(mSubLock);
 
+        MultiApiSharedJson const msg{jvObj};
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -2766,7 +2824,7 @@ NetworkOPsImp::pubProposedTransaction(
             if (p)
             {
                 p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                    msg.select(apiVersionSelector(p->getApiVersion())), true);
                 ++it;
             }
             else
@@ -2790,6 +2848,7 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
     {
         std::lock_guard sl(mSubLock);
 
+        SharedJson const msg{jvObj};
         auto it = mStreamMaps[sRTTransactions].begin();
         while (it != mStreamMaps[sRTTransactions].end())
         {
@@ -2797,7 +2856,7 @@ NetworkOPsImp::forwardProposedTransaction(Json::Value const& jvObj)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++it;
             }
             else
@@ -2815,12 +2874,13 @@ NetworkOPsImp::forwardValidation(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    SharedJson const msg{jvObj};
     for (auto i = mStreamMaps[sValidations].begin();
          i != mStreamMaps[sValidations].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->send(msg, true);
             ++i;
         }
         else
@@ -2835,12 +2895,13 @@ NetworkOPsImp::forwardManifest(Json::Value const& jvObj)
 {
     std::lock_guard sl(mSubLock);
 
+    SharedJson const msg{jvObj};
     for (auto i = mStreamMaps[sManifests].begin();
          i != mStreamMaps[sManifests].end();)
     {
         if (auto p = i->second.lock())
         {
-            p->send(jvObj, true);
+            p->send(msg, true);
             ++i;
         }
         else
@@ -2871,17 +2932,10 @@ getAccounts(Json::Value const& jvObj, std::vector<AccountID>& accounts)
 void
 NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
 {
-    hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
     // check if there are any subscribers before attempting to parse the JSON
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (mSubRTAccount.empty())
-            return;
-    }
+    if (mSubRTAccount.empty())
+        return;
 
-    // parse the JSON outside of the lock
     std::vector<AccountID> accounts;
     if (jvObj.isMember(jss::transaction))
     {
@@ -2897,42 +2951,20 @@ NetworkOPsImp::forwardProposedAccountTransaction(Json::Value const& jvObj)
             return;
         }
     }
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (!mSubRTAccount.empty())
-        {
-            for (auto const& affectedAccount : accounts)
-            {
-                auto simiIt = mSubRTAccount.find(affectedAccount);
-                if (simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
 
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
+    hash_set<InfoSub::pointer> notify;
+    std::size_t iProposed = 0;
+    for (auto const& affectedAccount : accounts)
+        iProposed += mSubRTAccount.collect(affectedAccount, notify);
 
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
-    }
     JLOG(m_journal.trace()) << "forwardProposedAccountTransaction:"
                             << " iProposed=" << iProposed;
 
     if (!notify.empty())
     {
+        SharedJson const msg{jvObj};
         for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+            isrListener->send(msg, true);
     }
 }
 
@@ -2942,6 +2974,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
     // Ledgers are published only when they acquire sufficient validations
     // Holes are filled across connection loss or other catastrophe
 
+    auto const start = std::chrono::steady_clock::now();
+
     std::shared_ptr<AcceptedLedger> alpAccepted =
         app_.getAcceptedLedgerCache().fetch(lpAccepted->info().hash);
     if (!alpAccepted)
@@ -2953,6 +2987,11 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
     assert(alpAccepted->getLedger().get() == lpAccepted.get());
 
+    app_.getJobQueue().addJob(
+        jtUPDATE_PF, "OrderBookDB::applyLedger", [this, lpAccepted]() {
+            app_.getOrderBookDB().applyLedger(lpAccepted);
+        });
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
@@ -2986,13 +3025,14 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            SharedJson const msg{jvObj};
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->send(msg, true);
                     ++it;
                 }
                 else
@@ -3004,13 +3044,14 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         {
             Json::Value jvObj = ripple::RPC::computeBookChanges(lpAccepted);
 
+            SharedJson const msg{jvObj};
             auto it = mStreamMaps[sBookChanges].begin();
             while (it != mStreamMaps[sBookChanges].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->send(msg, true);
                     ++it;
                 }
                 else
@@ -3040,13 +3081,21 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         }
     }
 
-    // Don't lock since pubAcceptedTransaction is locking.
-    for (auto const& accTx : *alpAccepted)
-    {
-        JLOG(m_journal.trace()) << "pubAccepted: " << accTx->getJson();
-        pubValidatedTransaction(
-            lpAccepted, *accTx, accTx == *(--alpAccepted->end()));
-    }
+    // Don't lock since pubValidatedTransactions is locking.
+    pubValidatedTransactions(lpAccepted, alpAccepted);
+
+    auto const duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    auto const closeTime = lpAccepted->info().closeTime;
+    auto const now = app_.timeKeeper().closeTime();
+
+    publishDuration_ = duration;
+    if (duration > publishMaxDuration_)
+        publishMaxDuration_ = duration;
+    publishLag_ = closeTime < now ? (now - closeTime).count() : 0;
+    publishedSeq_ = lpAccepted->info().seq;
 }
 
 void
@@ -3184,17 +3233,170 @@ NetworkOPsImp::transJson(
 }
 
 void
-NetworkOPsImp::pubValidatedTransaction(
+NetworkOPsImp::prepareTransaction(
     std::shared_ptr<ReadView const> const& ledger,
-    const AcceptedLedgerTx& transaction,
-    bool last)
+    AcceptedLedgerTx const& transaction,
+    std::array<bool, MultiApiJson::size> const& versions,
+    PublishedTransaction& published)
 {
-    auto const& stTxn = transaction.getTxn();
+    if (!mSubAccount.empty() || !mSubRTAccount.empty())
+    {
+        for (auto const& affectedAccount : transaction.getAffected())
+        {
+            published.proposed +=
+                mSubRTAccount.collect(affectedAccount, published.notify);
+            published.accepted +=
+                mSubAccount.collect(affectedAccount, published.notify);
+        }
+    }
 
     // Create two different Json objects, for different API versions
     auto const metaRef = std::ref(transaction.getMeta());
-    auto const trResult = transaction.getResult();
-    MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
+    published.json.emplace(transJson(
+        transaction.getTxn(), transaction.getResult(), true, ledger, metaRef));
+    published.msg.emplace(*published.json);
+
+    // Serialize the message here, for every API version it will be sent
+    // in, rather than on the thread that sends it.
+    auto wanted = versions;
+    for (auto const& p : published.notify)
+        wanted[apiVersionSelector(p->getApiVersion())()] = true;
+    for (std::size_t i = 0; i < wanted.size(); ++i)
+    {
+        if (wanted[i])
+            published.msg->select([i] { return i; }).text();
+    }
+}
+
+void
+NetworkOPsImp::pubValidatedTransactions(
+    std::shared_ptr<ReadView const> const& ledger,
+    std::shared_ptr<AcceptedLedger> const& accepted)
+{
+    std::size_t const count = accepted->size();
+    if (count == 0)
+        return;
+
+    // The API versions the transaction streams are sent in
+    std::array<bool, MultiApiJson::size> versions{};
+    {
+        std::lock_guard sl(mSubLock);
+        for (auto const stream : {sTransactions, sRTTransactions})
+        {
+            for (auto const& [seq, wptr] : mStreamMaps[stream])
+            {
+                if (auto p = wptr.lock())
+                    versions[apiVersionSelector(p->getApiVersion())()] = true;
+            }
+        }
+    }
+
+    // The transactions are prepared in parallel, by jobs and by this
+    // thread, in the order they were claimed. They are sent by this thread
+    // alone, in ledger order, as each becomes ready, so every subscriber
+    // still sees them in the order they were applied.
+    struct Work
+    {
+        std::shared_ptr<ReadView const> ledger;
+        std::shared_ptr<AcceptedLedger> accepted;
+        std::array<bool, MultiApiJson::size> versions;
+        std::vector<PublishedTransaction> published;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<bool> ready;
+        std::exception_ptr error;
+    };
+
+    auto work = std::make_shared<Work>();
+    work->ledger = ledger;
+    work->accepted = accepted;
+    work->versions = versions;
+    work->published = std::vector<PublishedTransaction>(count);
+    work->ready.resize(count, false);
+
+    // Prepare the next unclaimed transaction. Returns false once there
+    // are none left.
+    auto const prepareNext = [this](Work& w) {
+        auto const i = w.next++;
+        if (i >= w.published.size())
+            return false;
+
+        std::exception_ptr error;
+        try
+        {
+            prepareTransaction(
+                w.ledger,
+                **(w.accepted->begin() + i),
+                w.versions,
+                w.published[i]);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock(w.mutex);
+        if (error && !w.error)
+            w.error = error;
+        w.ready[i] = true;
+        w.cv.notify_all();
+        return true;
+    };
+
+    auto const jobs = std::min<std::size_t>(count - 1, maxPublishJobs);
+    for (std::size_t i = 0; i < jobs; ++i)
+    {
+        if (!m_job_queue.addJob(
+                jtPUBLEDGER, "pubLedger->prepare", [work, prepareNext]() {
+                    while (prepareNext(*work))
+                        ;
+                }))
+            break;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (;;)
+        {
+            {
+                std::lock_guard lock(work->mutex);
+                if (work->error)
+                    std::rethrow_exception(work->error);
+                if (work->ready[i])
+                    break;
+            }
+
+            // Rather than wait, help with the transactions after this one.
+            if (!prepareNext(*work))
+            {
+                std::unique_lock lock(work->mutex);
+                work->cv.wait(
+                    lock, [&] { return work->ready[i] || work->error; });
+            }
+        }
+
+        auto const& accTx = **(accepted->begin() + i);
+        JLOG(m_journal.trace()) << "pubAccepted: " << accTx.getJson();
+        pubValidatedTransaction(
+            ledger, accTx, work->published[i], i + 1 == count);
+
+        // Release the JSON as soon as it has been sent.
+        work->published[i].msg.reset();
+        work->published[i].json.reset();
+        work->published[i].notify.clear();
+    }
+}
+
+void
+NetworkOPsImp::pubValidatedTransaction(
+    std::shared_ptr<ReadView const> const& ledger,
+    const AcceptedLedgerTx& transaction,
+    PublishedTransaction& published,
+    bool last)
+{
+    // Serialized once for all of the subscribers it is sent to
+    MultiApiSharedJson const& msg = *published.msg;
 
     {
         std::lock_guard sl(mSubLock);
@@ -3207,7 +3409,7 @@ NetworkOPsImp::pubValidatedTransaction(
             if (p)
             {
                 p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                    msg.select(apiVersionSelector(p->getApiVersion())), true);
                 ++it;
             }
             else
@@ -3223,7 +3425,7 @@ NetworkOPsImp::pubValidatedTransaction(
             if (p)
             {
                 p->send(
-                    jvObj.select(apiVersionSelector(p->getApiVersion())), true);
+                    msg.select(apiVersionSelector(p->getApiVersion())), true);
                 ++it;
             }
             else
@@ -3232,70 +3434,27 @@ NetworkOPsImp::pubValidatedTransaction(
     }
 
     if (transaction.getResult() == tesSUCCESS)
-        app_.getOrderBookDB().processTxn(ledger, transaction, jvObj);
+        app_.getOrderBookDB().processTxn(ledger, transaction, msg);
 
-    pubAccountTransaction(ledger, transaction, last);
+    pubAccountTransaction(ledger, transaction, published, last);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
     std::shared_ptr<ReadView const> const& ledger,
     AcceptedLedgerTx const& transaction,
+    PublishedTransaction& published,
     bool last)
 {
-    hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
-    int iAccepted = 0;
-
     std::vector<SubAccountHistoryInfo> accountHistoryNotify;
     auto const currLedgerSeq = ledger->seq();
     {
         std::lock_guard sl(mSubLock);
 
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
+        if (!mSubAccountHistory.empty())
         {
             for (auto const& affectedAccount : transaction.getAffected())
             {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
-                if (auto simiIt = mSubAccount.find(affectedAccount);
-                    simiIt != mSubAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iAccepted;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-
                 if (auto histoIt = mSubAccountHistory.find(affectedAccount);
                     histoIt != mSubAccountHistory.end())
                 {
@@ -3330,24 +3489,22 @@ NetworkOPsImp::pubAccountTransaction(
 
     JLOG(m_journal.trace())
         << "pubAccountTransaction: "
-        << "proposed=" << iProposed << ", accepted=" << iAccepted;
+        << "proposed=" << published.proposed
+        << ", accepted=" << published.accepted;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
+    if (!published.notify.empty() || !accountHistoryNotify.empty())
     {
-        auto const& stTxn = transaction.getTxn();
-
-        // Create two different Json objects, for different API versions
-        auto const metaRef = std::ref(transaction.getMeta());
-        auto const trResult = transaction.getResult();
-        MultiApiJson jvObj = transJson(stTxn, trResult, true, ledger, metaRef);
-
-        for (InfoSub::ref isrListener : notify)
+        MultiApiSharedJson const& msg = *published.msg;
+        for (InfoSub::ref isrListener : published.notify)
         {
             isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
+                msg.select(apiVersionSelector(isrListener->getApiVersion())),
                 true);
         }
 
+        // The account history streams are sent the JSON itself, with the
+        // fields particular to each of them added as it goes.
+        MultiApiJson& jvObj = *published.json;
         if (last)
             jvObj.set(jss::account_history_boundary, true);
 
@@ -3375,44 +3532,16 @@ NetworkOPsImp::pubProposedAccountTransaction(
     std::shared_ptr<STTx const> const& tx,
     TER result)
 {
+    if (mSubRTAccount.empty())
+        return;
+
     hash_set<InfoSub::pointer> notify;
-    int iProposed = 0;
+    std::size_t iProposed = 0;
 
     std::vector<SubAccountHistoryInfo> accountHistoryNotify;
 
-    {
-        std::lock_guard sl(mSubLock);
-
-        if (mSubRTAccount.empty())
-            return;
-
-        if (!mSubAccount.empty() || !mSubRTAccount.empty() ||
-            !mSubAccountHistory.empty())
-        {
-            for (auto const& affectedAccount : tx->getMentionedAccounts())
-            {
-                if (auto simiIt = mSubRTAccount.find(affectedAccount);
-                    simiIt != mSubRTAccount.end())
-                {
-                    auto it = simiIt->second.begin();
-
-                    while (it != simiIt->second.end())
-                    {
-                        InfoSub::pointer p = it->second.lock();
-
-                        if (p)
-                        {
-                            notify.insert(p);
-                            ++it;
-                            ++iProposed;
-                        }
-                        else
-                            it = simiIt->second.erase(it);
-                    }
-                }
-            }
-        }
-    }
+    for (auto const& affectedAccount : tx->getMentionedAccounts())
+        iProposed += mSubRTAccount.collect(affectedAccount, notify);
 
     JLOG(m_journal.trace()) << "pubProposedAccountTransaction: " << iProposed;
 
@@ -3421,9 +3550,10 @@ NetworkOPsImp::pubProposedAccountTransaction(
         // Create two different Json objects, for different API versions
         MultiApiJson jvObj = transJson(tx, result, false, ledger, std::nullopt);
 
+        MultiApiSharedJson const msg{jvObj};
         for (InfoSub::ref isrListener : notify)
             isrListener->send(
-                jvObj.select(apiVersionSelector(isrListener->getApiVersion())),
+                msg.select(apiVersionSelector(isrListener->getApiVersion())),
                 true);
 
         assert(
@@ -3452,7 +3582,7 @@ NetworkOPsImp::subAccount(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
+    auto& subMap = rt ? mSubRTAccount : mSubAccount;
 
     for (auto const& naAccountID : vnaAccountIDs)
     {
@@ -3460,26 +3590,7 @@ NetworkOPsImp::subAccount(
             << "subAccount: account: " << toBase58(naAccountID);
 
         isrListener->insertSubAccountInfo(naAccountID, rt);
-    }
-
-    std::lock_guard sl(mSubLock);
-
-    for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-        if (simIterator == subMap.end())
-        {
-            // Not found, note that account has a new single listner.
-            SubMapType usisElement;
-            usisElement[isrListener->getSeq()] = isrListener;
-            // VFALCO NOTE This is making a needless copy of naAccountID
-            subMap.insert(simIterator, make_pair(naAccountID, usisElement));
-        }
-        else
-        {
-            // Found, note that the account has another listener.
-            simIterator->second[isrListener->getSeq()] = isrListener;
-        }
+        subMap.insert(naAccountID, isrListener);
     }
 }
 
@@ -3505,26 +3616,10 @@ NetworkOPsImp::unsubAccountInternal(
     hash_set<AccountID> const& vnaAccountIDs,
     bool rt)
 {
-    std::lock_guard sl(mSubLock);
-
-    SubInfoMapType& subMap = rt ? mSubRTAccount : mSubAccount;
+    auto& subMap = rt ? mSubRTAccount : mSubAccount;
 
     for (auto const& naAccountID : vnaAccountIDs)
-    {
-        auto simIterator = subMap.find(naAccountID);
-
-        if (simIterator != subMap.end())
-        {
-            // Found
-            simIterator->second.erase(uSeq);
-
-            if (simIterator->second.empty())
-            {
-                // Don't need hash entry.
-                subMap.erase(simIterator);
-            }
-        }
-    }
+        subMap.erase(naAccountID, uSeq);
 }
 
 void
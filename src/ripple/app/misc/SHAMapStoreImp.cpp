@@ -136,6 +136,8 @@ SHAMapStoreImp::SHAMapStoreImp(
         {
             backOff_ = std::chrono::milliseconds{temp};
         }
+        if (get_if_exists(section, "copy_latency_microseconds", temp))
+            copyLatencyTarget_ = std::chrono::microseconds{temp};
         if (get_if_exists(section, "age_threshold_seconds", temp))
             ageThreshold_ = std::chrono::seconds{temp};
         if (get_if_exists(section, "recovery_wait_seconds", temp))
@@ -261,12 +263,26 @@ SHAMapStoreImp::fdRequired() const
 bool
 SHAMapStoreImp::copyNode(std::uint64_t& nodeCount, SHAMapTreeNode const& node)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetchNodeObject(
-        node.getHash().as_uint256(),
-        0,
-        NodeStore::FetchType::synchronous,
-        true);
+    using namespace std::chrono;
+
+    // Copy a single record from node to dbRotating_. Most of the records
+    // were moved when they were last read, and only cost a lookup.
+    auto const start = steady_clock::now();
+    dbRotating_->fetchNodeObject(node.getHash().as_uint256());
+    auto const latency =
+        duration_cast<microseconds>(steady_clock::now() - start);
+
+    // Slow down while the disk is busy, over about the last 16 reads, so
+    // that fetches for everything else aren't held up behind the copy.
+    copyLatency_ += (latency - copyLatency_) / 16;
+    if (copyLatency_ > copyLatencyTarget_)
+    {
+        auto const pause = std::min<microseconds>(
+            copyLatency_ - copyLatencyTarget_, backOff_);
+        std::this_thread::sleep_for(pause);
+        copyPaused_ += pause;
+    }
+
     if (!(++nodeCount % checkHealthInterval_))
     {
         if (healthWait() == stopping)
@@ -358,12 +374,16 @@ SHAMapStoreImp::run()
                 << app_.getOPs().strOperatingMode(false) << " age "
                 << ledgerMaster_->getValidatedLedgerAge().count() << 's';
 
+            auto const rotateStart = std::chrono::steady_clock::now();
             clearPrior(lastRotated);
             if (healthWait() == stopping)
                 return;
 
             JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
             std::uint64_t nodeCount = 0;
+            auto const copyStart = std::chrono::steady_clock::now();
+            copyLatency_ = std::chrono::microseconds{0};
+            copyPaused_ = std::chrono::microseconds{0};
 
             try
             {
@@ -385,8 +405,17 @@ SHAMapStoreImp::run()
             if (healthWait() == stopping)
                 return;
             // Only log if we completed without a "health" abort
-            JLOG(journal_.debug()) << "copied ledger " << validatedSeq
-                                   << " nodecount " << nodeCount;
+            JLOG(journal_.debug())
+                << "copied ledger " << validatedSeq << " nodecount "
+                << nodeCount << " in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - copyStart)
+                       .count()
+                << "ms, paused "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       copyPaused_)
+                       .count()
+                << "ms";
 
             JLOG(journal_.debug()) << "freshening caches";
             freshenCaches();
@@ -419,7 +448,12 @@ SHAMapStoreImp::run()
                     return std::move(newBackend);
                 });
 
-            JLOG(journal_.warn()) << "finished rotation " << validatedSeq;
+            JLOG(journal_.warn())
+                << "finished rotation " << validatedSeq << " in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - rotateStart)
+                       .count()
+                << "ms";
         }
     }
 }
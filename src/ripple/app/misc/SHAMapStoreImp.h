@@ -103,6 +103,14 @@ private:
     bool advisoryDelete_ = false;
     std::uint32_t deleteBatch_ = 100;
     std::chrono::milliseconds backOff_{100};
+    /// The average time to read a node that the copy of the state before a
+    /// rotation aims for. While reads are slower, the copy pauses.
+    /// See also: "copy_latency_microseconds" in rippled-example.cfg
+    std::chrono::microseconds copyLatencyTarget_{1000};
+    // Moving average of the time to read a node being copied
+    std::chrono::microseconds copyLatency_{0};
+    // Time the copy has paused for
+    std::chrono::microseconds copyPaused_{0};
     std::chrono::seconds ageThreshold_{60};
     /// If  the node is out of sync during an online_delete healthWait()
     /// call, sleep the thread for this time, and continue checking until
@@ -196,8 +204,7 @@ private:
 
         for (auto const& key : cache.getKeys())
         {
-            dbRotating_->fetchNodeObject(
-                key, 0, NodeStore::FetchType::synchronous, true);
+            dbRotating_->fetchNodeObject(key);
             if (!(++check % checkHealthInterval_) && healthWait() == stopping)
                 return true;
         }
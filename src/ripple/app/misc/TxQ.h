@@ -21,6 +21,7 @@
 #define RIPPLE_TXQ_H_INCLUDED
 
 #include <ripple/app/tx/applySteps.h>
+#include <ripple/basics/hardened_hash.h>
 #include <ripple/ledger/ApplyView.h>
 #include <ripple/ledger/OpenView.h>
 #include <ripple/protocol/RippleLedgerHash.h>
@@ -29,6 +30,8 @@
 #include <ripple/protocol/TER.h>
 #include <boost/circular_buffer.hpp>
 #include <boost/intrusive/set.hpp>
+#include <array>
+#include <mutex>
 #include <optional>
 
 namespace ripple {
@@ -360,7 +363,8 @@ public:
     doRPC(Application& app) const;
 
 private:
-    // Implementation for nextQueuableSeq().  The passed lock must be held.
+    // Implementation for nextQueuableSeq().  The passed lock must be held,
+    // and be either mutex_ or the lock of the account's shard.
     SeqProxy
     nextQueuableSeqImpl(
         std::shared_ptr<SLE const> const& sleAccount,
@@ -514,6 +518,10 @@ private:
         /// to put each MaybeTx object into more than one
         /// set without copies, pointers, etc.
         boost::intrusive::set_member_hook<> byFeeListHook;
+        /// Used by the TxQ::CandidateHook and TxQ::CandidateSet below
+        /// while the transaction could be applied to the open ledger
+        /// ahead of the rest of its account's queue.
+        boost::intrusive::set_member_hook<> candidateHook;
 
         /// The complete transaction.
         std::shared_ptr<STTx const> txn;
@@ -752,8 +760,51 @@ private:
     using FeeMultiSet = boost::intrusive::
         multiset<MaybeTx, FeeHook, boost::intrusive::compare<OrderCandidates>>;
 
+    using CandidateHook = boost::intrusive::member_hook<
+        MaybeTx,
+        boost::intrusive::set_member_hook<>,
+        &MaybeTx::candidateHook>;
+
+    using CandidateSet = boost::intrusive::multiset<
+        MaybeTx,
+        CandidateHook,
+        boost::intrusive::compare<OrderCandidates>>;
+
     using AccountMap = std::map<AccountID, TxQAccount>;
 
+    /** The accounts in the queue are split into shards with a lock each,
+        so that the queue of one account can be read without waiting for
+        transactions to be applied from or to the rest of the queue.
+
+        Accounts are only added, removed or modified with both mutex_ and
+        the account's shard locked, so they may be read with either.
+    */
+    struct AccountShard
+    {
+        std::mutex mutable mutex;
+        AccountMap accounts;
+    };
+
+    static constexpr std::size_t accountShardCount = 16;
+
+    /** The figures reported by getMetrics(), copied out whenever the queue
+        or the fee metrics change.
+    */
+    struct PublishedMetrics
+    {
+        std::size_t txCount = 0;
+        std::optional<std::size_t> txQMaxSize;
+        FeeLevel64 minProcessingFeeLevel;
+        std::size_t txnsExpected = 0;
+        FeeLevel64 escalationMultiplier;
+
+        FeeMetrics::Snapshot
+        snapshot() const
+        {
+            return {txnsExpected, escalationMultiplier};
+        }
+    };
+
     /// Setup parameters used to control the behavior of the queue
     Setup const setup_;
     /// Journal
@@ -770,13 +821,19 @@ private:
         locked mutex_
     */
     FeeMultiSet byFee_;
+    /** The transactions in byFee_ that could be applied to the open
+        ledger now: every ticketed transaction, and the first sequence
+        based transaction of each account. `accept` only walks these.
+        @note This member must always and only be accessed under
+        locked mutex_
+    */
+    CandidateSet candidates_;
     /** All of the accounts which currently have any transactions
         in the queue. Entries are created and destroyed dynamically
         as transactions are added and removed.
-        @note This member must always and only be accessed under
-        locked mutex_
+        @note See AccountShard for the locks this member needs.
     */
-    AccountMap byAccount_;
+    std::array<AccountShard, accountShardCount> byAccount_;
     /** Maximum number of transactions allowed in the queue based
         on the current metrics. If uninitialized, there is no limit,
         but that condition cannot last for long in practice.
@@ -793,12 +850,42 @@ private:
     LedgerHash parentHash_{beast::zero};
 #endif
 
-    /** Most queue operations are done under the master lock,
-        but use this mutex for the RPC "fee" command, which isn't.
+    /** Guards the queue while transactions are added to it, applied
+        from it, or expire.
     */
     std::mutex mutable mutex_;
 
+    /** The metrics of the queue as of its last change.
+        @note This member must always and only be accessed under
+        locked metricsMutex_
+    */
+    PublishedMetrics published_;
+    std::mutex mutable metricsMutex_;
+
 private:
+    AccountShard&
+    accountShard(AccountID const& account)
+    {
+        return byAccount_[shardIndex(account, accountShardCount)];
+    }
+
+    AccountShard const&
+    accountShard(AccountID const& account) const
+    {
+        return byAccount_[shardIndex(account, accountShardCount)];
+    }
+
+    /// Copy the metrics of the queue out to published_.
+    void
+    publishMetrics(std::lock_guard<std::mutex> const&);
+
+    /** Link the first sequence based transaction of the account into
+        candidates_, and unlink the one that follows it, after the front
+        of the account's queue changed.
+    */
+    void
+    updateCandidates(TxQAccount& txQAccount);
+
     /// Is the queue at least `fillPercentage` full?
     template <size_t fillPercentage = 100>
     bool
@@ -820,11 +907,11 @@ private:
     /// Erase and return the next entry in byFee_ (lower fee level)
     FeeMultiSet::iterator_type erase(FeeMultiSet::const_iterator_type);
     /** Erase and return the next entry for the account (if fee level
-        is higher), or next entry in byFee_ (lower fee level).
+        is higher), or next entry in candidates_ (lower fee level).
         Used to get the next "applyable" MaybeTx for accept().
     */
-    FeeMultiSet::iterator_type eraseAndAdvance(
-        FeeMultiSet::const_iterator_type);
+    CandidateSet::iterator_type eraseAndAdvance(
+        CandidateSet::const_iterator_type);
     /// Erase a range of items, based on TxQAccount::TxMap iterators
     TxQAccount::TxMap::iterator
     erase(
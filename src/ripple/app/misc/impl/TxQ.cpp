@@ -23,6 +23,7 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/basics/mulDiv.h>
+#include <ripple/basics/scope.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/protocol/st.h>
@@ -354,13 +355,49 @@ TxQ::TxQAccount::remove(SeqProxy seqProx)
 TxQ::TxQ(Setup const& setup, beast::Journal j)
     : setup_(setup), j_(j), feeMetrics_(setup, j), maxSize_(std::nullopt)
 {
+    std::lock_guard lock(mutex_);
+    publishMetrics(lock);
 }
 
 TxQ::~TxQ()
 {
+    candidates_.clear();
     byFee_.clear();
 }
 
+void
+TxQ::publishMetrics(std::lock_guard<std::mutex> const&)
+{
+    auto const snapshot = feeMetrics_.getSnapshot();
+
+    std::lock_guard lock(metricsMutex_);
+    published_.txCount = byFee_.size();
+    published_.txQMaxSize = maxSize_;
+    published_.minProcessingFeeLevel =
+        isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel;
+    published_.txnsExpected = snapshot.txnsExpected;
+    published_.escalationMultiplier = snapshot.escalationMultiplier;
+}
+
+void
+TxQ::updateCandidates(TxQAccount& txQAccount)
+{
+    auto& txs = txQAccount.transactions;
+    auto const frontIter = txs.begin();
+    if (frontIter == txs.end())
+        return;
+
+    // Tickets are always candidates, but only the first sequence based
+    // transaction can be applied before the others.
+    if (frontIter->first.isSeq() &&
+        !frontIter->second.candidateHook.is_linked())
+        candidates_.insert(frontIter->second);
+
+    if (auto const nextIter = std::next(frontIter); nextIter != txs.end() &&
+        nextIter->first.isSeq() && nextIter->second.candidateHook.is_linked())
+        candidates_.erase(candidates_.iterator_to(nextIter->second));
+}
+
 template <size_t fillPercentage>
 bool
 TxQ::isFull() const
@@ -399,7 +436,7 @@ TxQ::canBeHeld(
     }
 
     // Allow if the account is not in the queue at all.
-    if (accountIter == byAccount_.end())
+    if (accountIter == accountShard(tx[sfAccount]).accounts.end())
         return tesSUCCESS;
 
     // Allow this tx to replace another one.
@@ -440,24 +477,29 @@ auto
 TxQ::erase(TxQ::FeeMultiSet::const_iterator_type candidateIter)
     -> FeeMultiSet::iterator_type
 {
-    auto& txQAccount = byAccount_.at(candidateIter->account);
+    auto const& account = candidateIter->account;
+    auto& txQAccount = accountShard(account).accounts.at(account);
     auto const seqProx = candidateIter->seqProxy;
+    if (candidateIter->candidateHook.is_linked())
+        candidates_.erase(candidates_.iterator_to(*candidateIter));
     auto const newCandidateIter = byFee_.erase(candidateIter);
     // Now that the candidate has been removed from the
-    // intrusive list remove it from the TxQAccount
+    // intrusive lists remove it from the TxQAccount
     // so the memory can be freed.
     auto const found = txQAccount.remove(seqProx);
     (void)found;
     assert(found);
+    updateCandidates(txQAccount);
 
     return newCandidateIter;
 }
 
 auto
-TxQ::eraseAndAdvance(TxQ::FeeMultiSet::const_iterator_type candidateIter)
-    -> FeeMultiSet::iterator_type
+TxQ::eraseAndAdvance(TxQ::CandidateSet::const_iterator_type candidateIter)
+    -> CandidateSet::iterator_type
 {
-    auto& txQAccount = byAccount_.at(candidateIter->account);
+    auto const& account = candidateIter->account;
+    auto& txQAccount = accountShard(account).accounts.at(account);
     auto const accountIter =
         txQAccount.transactions.find(candidateIter->seqProxy);
     assert(accountIter != txQAccount.transactions.end());
@@ -468,7 +510,7 @@ TxQ::eraseAndAdvance(TxQ::FeeMultiSet::const_iterator_type candidateIter)
     assert(
         candidateIter->seqProxy.isTicket() ||
         accountIter == txQAccount.transactions.begin());
-    assert(byFee_.iterator_to(accountIter->second) == candidateIter);
+    assert(candidates_.iterator_to(accountIter->second) == candidateIter);
     auto const accountNextIter = std::next(accountIter);
 
     // Check if the next transaction for this account is earlier in the queue,
@@ -477,13 +519,16 @@ TxQ::eraseAndAdvance(TxQ::FeeMultiSet::const_iterator_type candidateIter)
     bool const useAccountNext =
         accountNextIter != txQAccount.transactions.end() &&
         accountNextIter->first > candidateIter->seqProxy &&
-        (feeNextIter == byFee_.end() ||
-         byFee_.value_comp()(accountNextIter->second, *feeNextIter));
+        (feeNextIter == candidates_.end() ||
+         candidates_.value_comp()(accountNextIter->second, *feeNextIter));
 
-    auto const candidateNextIter = byFee_.erase(candidateIter);
+    byFee_.erase(byFee_.iterator_to(accountIter->second));
+    auto const candidateNextIter = candidates_.erase(candidateIter);
     txQAccount.transactions.erase(accountIter);
+    // The next transaction for the account, if any, is now a candidate.
+    updateCandidates(txQAccount);
 
-    return useAccountNext ? byFee_.iterator_to(accountNextIter->second)
+    return useAccountNext ? candidates_.iterator_to(accountNextIter->second)
                           : candidateNextIter;
 }
 
@@ -496,8 +541,12 @@ TxQ::erase(
     for (auto it = begin; it != end; ++it)
     {
         byFee_.erase(byFee_.iterator_to(it->second));
+        if (it->second.candidateHook.is_linked())
+            candidates_.erase(candidates_.iterator_to(it->second));
     }
-    return txQAccount.transactions.erase(begin, end);
+    auto const next = txQAccount.transactions.erase(begin, end);
+    updateCandidates(txQAccount);
+    return next;
 }
 
 std::pair<TER, bool>
@@ -765,9 +814,16 @@ TxQ::apply(
 
     std::lock_guard lock(mutex_);
 
+    // Whatever becomes of the transaction, let readers see the queue as it
+    // is once we are done with it.
+    scope_exit publish([this, &lock] { publishMetrics(lock); });
+
+    auto& shard = accountShard(account);
+    std::lock_guard accountLock(shard.mutex);
+
     // accountIter is not const because it may be updated further down.
-    AccountMap::iterator accountIter = byAccount_.find(account);
-    bool const accountIsInQueue = accountIter != byAccount_.end();
+    AccountMap::iterator accountIter = shard.accounts.find(account);
+    bool const accountIsInQueue = accountIter != shard.accounts.end();
 
     // _If_ the account is in the queue, then ignore any sequence-based
     // queued transactions that slipped into the ledger while we were not
@@ -1243,7 +1299,13 @@ TxQ::apply(
                 << account << ") out of the queue.";
             return {telCAN_NOT_QUEUE_FULL, false};
         }
-        auto const& endAccount = byAccount_.at(lastRIter->account);
+        // No reader ever waits for a second shard, and only one writer
+        // holds mutex_, so locking the last account's shard is safe.
+        auto& endShard = accountShard(lastRIter->account);
+        std::unique_lock<std::mutex> endLock;
+        if (&endShard != &shard)
+            endLock = std::unique_lock(endShard.mutex);
+        auto const& endAccount = endShard.accounts.at(lastRIter->account);
         auto endEffectiveFeeLevel = [&]() {
             // Compute the average of all the txs for the endAccount,
             // but only if the last tx in the queue has a lower fee
@@ -1305,7 +1367,7 @@ TxQ::apply(
         // Create a new TxQAccount object and add the byAccount lookup.
         bool created;
         std::tie(accountIter, created) =
-            byAccount_.emplace(account, TxQAccount(tx));
+            shard.accounts.emplace(account, TxQAccount(tx));
         (void)created;
         assert(created);
     }
@@ -1320,8 +1382,12 @@ TxQ::apply(
     auto& candidate = accountIter->second.add(
         {tx, transactionID, feeLevelPaid, flags, pfresult});
 
-    // Then index it into the byFee lookup.
+    // Then index it into the byFee and candidate lookups.
     byFee_.insert(candidate);
+    if (candidate.seqProxy.isTicket())
+        candidates_.insert(candidate);
+    else
+        updateCandidates(accountIter->second);
     JLOG(j_.debug()) << "Added transaction " << candidate.txID
                      << " with result " << transToken(pfresult.ter) << " from "
                      << (accountIsInQueue ? "existing" : "new") << " account "
@@ -1348,6 +1414,11 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
 {
     std::lock_guard lock(mutex_);
 
+    // Expired transactions may belong to any account.
+    std::array<std::unique_lock<std::mutex>, accountShardCount> accountLocks;
+    for (std::size_t i = 0; i < accountShardCount; ++i)
+        accountLocks[i] = std::unique_lock(byAccount_[i].mutex);
+
     feeMetrics_.update(app, view, timeLeap, setup_);
     auto const& snapshot = feeMetrics_.getSnapshot();
 
@@ -1362,7 +1433,9 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
     {
         if (candidateIter->lastValid && *candidateIter->lastValid <= ledgerSeq)
         {
-            byAccount_.at(candidateIter->account).dropPenalty = true;
+            accountShard(candidateIter->account)
+                .accounts.at(candidateIter->account)
+                .dropPenalty = true;
             candidateIter = erase(candidateIter);
         }
         else
@@ -1373,25 +1446,29 @@ TxQ::processClosedLedger(Application& app, ReadView const& view, bool timeLeap)
 
     // Remove any TxQAccounts that don't have candidates
     // under them
-    for (auto txQAccountIter = byAccount_.begin();
-         txQAccountIter != byAccount_.end();)
+    for (auto& shard : byAccount_)
     {
-        if (txQAccountIter->second.empty())
-            txQAccountIter = byAccount_.erase(txQAccountIter);
-        else
-            ++txQAccountIter;
+        for (auto txQAccountIter = shard.accounts.begin();
+             txQAccountIter != shard.accounts.end();)
+        {
+            if (txQAccountIter->second.empty())
+                txQAccountIter = shard.accounts.erase(txQAccountIter);
+            else
+                ++txQAccountIter;
+        }
     }
+
+    publishMetrics(lock);
 }
 
 /*
     How the txs are moved from the queue to the new open ledger.
 
-    1. Iterate over the txs from highest fee level to lowest.
-        For each tx:
-        a) Is this the first tx in the queue for this account?
-            No: Skip this tx. We'll come back to it later.
-            Yes: Continue to the next sub-step.
-        b) Is the tx fee level less than the current required
+    1. Iterate over the candidates from highest fee level to lowest.
+        Only the first sequence-based tx of each account and the
+        ticket-based txs are candidates, so no other tx is visited.
+        For each candidate:
+        a) Is the tx fee level less than the current required
                 fee level?
             Yes: Stop iterating. Continue to the next step.
             No: Try to apply the transaction. Did it apply?
@@ -1427,23 +1504,16 @@ TxQ::accept(Application& app, OpenView& view)
 
     auto const metricsSnapshot = feeMetrics_.getSnapshot();
 
-    for (auto candidateIter = byFee_.begin(); candidateIter != byFee_.end();)
+    for (auto candidateIter = candidates_.begin();
+         candidateIter != candidates_.end();)
     {
-        auto& account = byAccount_.at(candidateIter->account);
-        auto const beginIter = account.transactions.begin();
-        if (candidateIter->seqProxy.isSeq() &&
-            candidateIter->seqProxy > beginIter->first)
-        {
-            // There is a sequence transaction at the front of the queue and
-            // candidate has a later sequence, so skip this candidate.  We
-            // need to process sequence-based transactions in sequence order.
-            JLOG(j_.trace())
-                << "Skipping queued transaction " << candidateIter->txID
-                << " from account " << candidateIter->account
-                << " as it is not the first.";
-            candidateIter++;
-            continue;
-        }
+        auto& shard = accountShard(candidateIter->account);
+        std::lock_guard accountLock(shard.mutex);
+        auto& account = shard.accounts.at(candidateIter->account);
+        // We need to process sequence-based transactions in sequence order.
+        assert(
+            candidateIter->seqProxy.isTicket() ||
+            candidateIter->seqProxy == account.transactions.begin()->first);
         auto const requiredFeeLevel =
             getRequiredFeeLevel(view, tapNONE, metricsSnapshot, lock);
         auto const feeLevelPaid = candidateIter->feeLevel;
@@ -1530,9 +1600,8 @@ TxQ::accept(Application& app, OpenView& view)
                             << transToken(txnResult)
                             << ". Removing last item from account "
                             << account.account;
-                        auto endIter = byFee_.iterator_to(dropRIter->second);
-                        if (endIter != candidateIter)
-                            erase(endIter);
+                        if (&dropRIter->second != &*candidateIter)
+                            erase(byFee_.iterator_to(dropRIter->second));
                         ++candidateIter;
                     }
                 }
@@ -1564,29 +1633,42 @@ TxQ::accept(Application& app, OpenView& view)
     // was the fastest method tried to repopulate the list.
     // Other methods included: create a new list and moving items over one at a
     // time, create a new list and merge the old list into it.
+    candidates_.clear();
     byFee_.clear();
 
     MaybeTx::parentHashComp = parentHash;
 
-    for (auto& [_, account] : byAccount_)
+    for (auto& shard : byAccount_)
     {
-        for (auto& [_, candidate] : account.transactions)
+        for (auto& [_, account] : shard.accounts)
         {
-            byFee_.insert(candidate);
+            for (auto& [_, candidate] : account.transactions)
+            {
+                byFee_.insert(candidate);
+                if (candidate.seqProxy.isTicket())
+                    candidates_.insert(candidate);
+            }
+            updateCandidates(account);
         }
     }
     assert(byFee_.size() == startingSize);
 
+    publishMetrics(lock);
+
     return ledgerChanged;
 }
 
 // Public entry point for nextQueuableSeq().
 //
-// Acquires a lock and calls the implementation.
+// Acquires the lock of the account's shard and calls the implementation.
 SeqProxy
 TxQ::nextQueuableSeq(std::shared_ptr<SLE const> const& sleAccount) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (!sleAccount || sleAccount->getType() != ltACCOUNT_ROOT)
+        return SeqProxy::sequence(0);
+
+    auto const& shard = accountShard((*sleAccount)[sfAccount]);
+    std::lock_guard<std::mutex> lock(shard.mutex);
     return nextQueuableSeqImpl(sleAccount, lock);
 }
 
@@ -1609,8 +1691,9 @@ TxQ::nextQueuableSeqImpl(
     SeqProxy const acctSeqProx = SeqProxy::sequence((*sleAccount)[sfSequence]);
 
     // If the account is not in the queue then acctSeqProx is good enough.
-    auto const accountIter = byAccount_.find((*sleAccount)[sfAccount]);
-    if (accountIter == byAccount_.end() ||
+    auto const& accounts = accountShard((*sleAccount)[sfAccount]).accounts;
+    auto const accountIter = accounts.find((*sleAccount)[sfAccount]);
+    if (accountIter == accounts.end() ||
         accountIter->second.transactions.empty())
         return acctSeqProx;
 
@@ -1677,9 +1760,8 @@ TxQ::tryDirectApply(
         return {};
 
     FeeLevel64 const requiredFeeLevel = [this, &view, flags]() {
-        std::lock_guard lock(mutex_);
-        return getRequiredFeeLevel(
-            view, flags, feeMetrics_.getSnapshot(), lock);
+        std::lock_guard lock(metricsMutex_);
+        return getRequiredFeeLevel(view, flags, published_.snapshot(), lock);
     }();
 
     // If the transaction's fee is high enough we may be able to put the
@@ -1706,9 +1788,12 @@ TxQ::tryDirectApply(
             // If the applied transaction replaced a transaction in the
             // queue then remove the replaced transaction.
             std::lock_guard lock(mutex_);
+            scope_exit publish([this, &lock] { publishMetrics(lock); });
 
-            AccountMap::iterator accountIter = byAccount_.find(account);
-            if (accountIter != byAccount_.end())
+            auto& shard = accountShard(account);
+            std::lock_guard accountLock(shard.mutex);
+            AccountMap::iterator accountIter = shard.accounts.find(account);
+            if (accountIter != shard.accounts.end())
             {
                 TxQAccount& txQAcct = accountIter->second;
                 if (auto const existingIter =
@@ -1749,17 +1834,18 @@ TxQ::getMetrics(OpenView const& view) const
 {
     Metrics result;
 
-    std::lock_guard lock(mutex_);
-
-    auto const snapshot = feeMetrics_.getSnapshot();
+    auto const published = [this]() {
+        std::lock_guard lock(metricsMutex_);
+        return published_;
+    }();
+    auto const snapshot = published.snapshot();
 
-    result.txCount = byFee_.size();
-    result.txQMaxSize = maxSize_;
+    result.txCount = published.txCount;
+    result.txQMaxSize = published.txQMaxSize;
     result.txInLedger = view.txCount();
     result.txPerLedger = snapshot.txnsExpected;
     result.referenceFeeLevel = baseLevel;
-    result.minProcessingFeeLevel =
-        isFull() ? byFee_.rbegin()->feeLevel + FeeLevel64{1} : baseLevel;
+    result.minProcessingFeeLevel = published.minProcessingFeeLevel;
     result.medFeeLevel = snapshot.escalationMultiplier;
     result.openLedgerFeeLevel = FeeMetrics::scaleFeeLevel(snapshot, view);
 
@@ -1773,16 +1859,17 @@ TxQ::getTxRequiredFeeAndSeq(
 {
     auto const account = (*tx)[sfAccount];
 
-    std::lock_guard lock(mutex_);
-
-    auto const snapshot = feeMetrics_.getSnapshot();
+    auto const snapshot = [this]() {
+        std::lock_guard lock(metricsMutex_);
+        return published_.snapshot();
+    }();
     auto const baseFee = calculateBaseFee(view, *tx);
     auto const fee = FeeMetrics::scaleFeeLevel(snapshot, view);
 
     auto const sle = view.read(keylet::account(account));
 
     std::uint32_t const accountSeq = sle ? (*sle)[sfSequence] : 0;
-    std::uint32_t const availableSeq = nextQueuableSeqImpl(sle, lock).value();
+    std::uint32_t const availableSeq = nextQueuableSeq(sle).value();
     return {
         mulDiv(fee, baseFee, baseLevel)
             .value_or(XRPAmount(std::numeric_limits<std::int64_t>::max())),
@@ -1795,11 +1882,12 @@ TxQ::getAccountTxs(AccountID const& account) const
 {
     std::vector<TxDetails> result;
 
-    std::lock_guard lock(mutex_);
+    auto const& shard = accountShard(account);
+    std::lock_guard lock(shard.mutex);
 
-    AccountMap::const_iterator const accountIter{byAccount_.find(account)};
+    AccountMap::const_iterator const accountIter{shard.accounts.find(account)};
 
-    if (accountIter == byAccount_.end() ||
+    if (accountIter == shard.accounts.end() ||
         accountIter->second.transactions.empty())
         return result;
 
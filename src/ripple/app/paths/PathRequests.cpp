@@ -21,15 +21,24 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/PerfLog.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <algorithm>
+#include <condition_variable>
 
 namespace ripple {
 
+namespace {
+
+// The most threads that update path requests at once
+constexpr std::size_t maxUpdateJobs = 8;
+
+}  // namespace
+
 /** Get the current RippleLineCache, updating it if necessary.
     Get the correct ledger to use.
 */
@@ -58,8 +67,20 @@ PathRequests::getLineCache(
         // Assign to the local before the member, because the member is a
         // weak_ptr, and will immediately discard it if there are no other
         // references.
+        auto const previous = std::move(lineCache);
         lineCache_ = lineCache = std::make_shared<RippleLineCache>(
-            ledger, app_.journal("RippleLineCache"));
+            ledger, app_.journal("RippleLineCache"), lineIndex_);
+
+        // Start from the lines of the parent ledger that this one left as
+        // they were.
+        if (!ledger->open())
+        {
+            auto const touched = lineIndex_->advance(*ledger);
+            if (touched && previous &&
+                previous->getLedger()->info().hash ==
+                    ledger->info().parentHash)
+                lineCache->carryOver(*previous, *touched);
+        }
     }
     return lineCache;
 }
@@ -70,21 +91,37 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
     auto event =
         app_.getJobQueue().makeLoadEvent(jtPATH_FIND, "PathRequest::updateAll");
 
-    std::vector<PathRequest::wptr> requests;
-    std::shared_ptr<RippleLineCache> cache;
+    // The requests of a pass are updated in parallel, by jobs and by this
+    // thread, against the same cache. Each request is claimed by one
+    // thread at a time, so its own state needs no more locking.
+    struct Work
+    {
+        std::vector<PathRequest::wptr> requests;
+        std::shared_ptr<RippleLineCache> cache;
+        bool newRequests = false;
+        std::atomic<bool> mustBreak{false};
+        std::atomic<int> processed{0};
+        std::atomic<int> removed{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t next = 0;
+        std::size_t running = 0;
+    };
+
+    auto work = std::make_shared<Work>();
 
     // Get the ledger and cache we should be using
     {
         std::lock_guard sl(mLock);
-        requests = requests_;
-        cache = getLineCache(inLedger, true);
+        work->requests = requests_;
+        work->cache = getLineCache(inLedger, true);
     }
 
-    bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    work->newRequests = app_.getLedgerMaster().isNewPathRequest();
 
-    JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
-                           << ", " << requests.size() << " requests";
+    JLOG(mJournal.trace()) << "updateAll seq="
+                           << work->cache->getLedger()->seq() << ", "
+                           << work->requests.size() << " requests";
 
     int processed = 0, removed = 0;
 
@@ -99,93 +136,144 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
         return nullptr;
     };
 
-    do
-    {
-        JLOG(mJournal.trace()) << "updateAll looping";
-        for (auto const& wr : requests)
-        {
-            if (app_.getJobQueue().isStopping())
-                break;
-
-            auto request = wr.lock();
-            bool remove = true;
-            JLOG(mJournal.trace())
-                << "updateAll request " << (request ? "" : "not ") << "found";
+    auto const updateRequest = [this, getSubscriber](
+                                   Work& w, PathRequest::wptr const& wr) {
+        auto request = wr.lock();
+        bool remove = true;
+        JLOG(mJournal.trace())
+            << "updateAll request " << (request ? "" : "not ") << "found";
 
-            if (request)
+        if (request)
+        {
+            auto continueCallback = [&getSubscriber, &request]() {
+                // This callback is used by doUpdate to determine whether to
+                // continue working. If getSubscriber returns null, that
+                // indicates that this request is no longer relevant.
+                return (bool)getSubscriber(request);
+            };
+            auto const start = std::chrono::steady_clock::now();
+            auto const reportUpdate = [this, start]() {
+                using namespace std::chrono;
+                app_.getPerfLog().phaseFinish(
+                    "pathRequest.update",
+                    duration_cast<microseconds>(steady_clock::now() - start));
+            };
+            if (!request->needsUpdate(
+                    w.newRequests, w.cache->getLedger()->seq()))
+                remove = false;
+            else
             {
-                auto continueCallback = [&getSubscriber, &request]() {
-                    // This callback is used by doUpdate to determine whether to
-                    // continue working. If getSubscriber returns null, that
-                    // indicates that this request is no longer relevant.
-                    return (bool)getSubscriber(request);
-                };
-                if (!request->needsUpdate(
-                        newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                if (auto ipSub = getSubscriber(request))
                 {
-                    if (auto ipSub = getSubscriber(request))
+                    if (!ipSub->getConsumer().warn())
                     {
-                        if (!ipSub->getConsumer().warn())
+                        // Release the shared ptr to the subscriber so that
+                        // it can be freed if the client disconnects, and
+                        // thus fail to lock later.
+                        ipSub.reset();
+                        Json::Value update = request->doUpdate(
+                            w.cache, false, continueCallback);
+                        request->updateComplete();
+                        reportUpdate();
+                        update[jss::type] = "path_find";
+                        if ((ipSub = getSubscriber(request)))
                         {
-                            // Release the shared ptr to the subscriber so that
-                            // it can be freed if the client disconnects, and
-                            // thus fail to lock later.
-                            ipSub.reset();
-                            Json::Value update = request->doUpdate(
-                                cache, false, continueCallback);
-                            request->updateComplete();
-                            update[jss::type] = "path_find";
-                            if ((ipSub = getSubscriber(request)))
-                            {
-                                ipSub->send(update, false);
-                                remove = false;
-                                ++processed;
-                            }
+                            ipSub->send(update, false);
+                            remove = false;
+                            ++w.processed;
                         }
                     }
-                    else if (request->hasCompletion())
-                    {
-                        // One-shot request with completion function
-                        request->doUpdate(cache, false);
-                        request->updateComplete();
-                        ++processed;
-                    }
+                }
+                else if (request->hasCompletion())
+                {
+                    // One-shot request with completion function
+                    request->doUpdate(w.cache, false);
+                    request->updateComplete();
+                    reportUpdate();
+                    ++w.processed;
                 }
             }
+        }
 
-            if (remove)
-            {
-                std::lock_guard sl(mLock);
-
-                // Remove any dangling weak pointers or weak
-                // pointers that refer to this path request.
-                auto ret = std::remove_if(
-                    requests_.begin(),
-                    requests_.end(),
-                    [&removed, &request](auto const& wl) {
-                        auto r = wl.lock();
-
-                        if (r && r != request)
-                            return false;
-                        ++removed;
-                        return true;
-                    });
-
-                requests_.erase(ret, requests_.end());
-            }
+        if (remove)
+        {
+            std::lock_guard sl(mLock);
+
+            // Remove any dangling weak pointers or weak
+            // pointers that refer to this path request.
+            auto ret = std::remove_if(
+                requests_.begin(),
+                requests_.end(),
+                [&w, &request](auto const& wl) {
+                    auto r = wl.lock();
+
+                    if (r && r != request)
+                        return false;
+                    ++w.removed;
+                    return true;
+                });
+
+            requests_.erase(ret, requests_.end());
+        }
+
+        // We weren't handling new requests and then
+        // there was a new request
+        if (!w.newRequests && app_.getLedgerMaster().isNewPathRequest())
+            w.mustBreak = true;
+    };
+
+    // Update the next unclaimed request. Returns false once there are none
+    // left, or the pass must stop.
+    auto const updateNext = [this, updateRequest](Work& w) {
+        PathRequest::wptr wr;
+        {
+            std::lock_guard lock(w.mutex);
+            if (w.next == w.requests.size() || w.mustBreak ||
+                app_.getJobQueue().isStopping())
+                return false;
+            wr = w.requests[w.next++];
+            ++w.running;
+        }
 
-            mustBreak =
-                !newRequests && app_.getLedgerMaster().isNewPathRequest();
+        updateRequest(w, wr);
 
-            // We weren't handling new requests and then
-            // there was a new request
-            if (mustBreak)
+        std::lock_guard lock(w.mutex);
+        if (--w.running == 0)
+            w.cv.notify_all();
+        return true;
+    };
+
+    do
+    {
+        JLOG(mJournal.trace()) << "updateAll looping";
+
+        auto const jobs = std::min<std::size_t>(
+            std::max<std::size_t>(work->requests.size(), 1) - 1,
+            maxUpdateJobs - 1);
+        for (std::size_t i = 0; i < jobs; ++i)
+        {
+            if (!app_.getJobQueue().addJob(
+                    jtPATH_UPDATE,
+                    "PathRequest::update",
+                    [work, updateNext]() {
+                        while (updateNext(*work))
+                            ;
+                    }))
                 break;
         }
 
-        if (mustBreak)
+        while (updateNext(*work))
+            ;
+        {
+            std::unique_lock lock(work->mutex);
+            work->cv.wait(lock, [&] { return work->running == 0; });
+        }
+
+        processed += work->processed;
+        removed += work->removed;
+        bool newRequests = work->newRequests;
+
+        if (work->mustBreak)
         {  // a new request came in while we were working
             newRequests = true;
         }
@@ -201,13 +289,18 @@ PathRequests::updateAll(std::shared_ptr<ReadView const> const& inLedger)
         }
 
         {
-            // Get the latest requests, cache, and ledger for next pass
+            // Get the latest requests, cache, and ledger for next pass.
+            // Jobs of the last pass that have yet to start find no work
+            // left in it.
+            auto next = std::make_shared<Work>();
             std::lock_guard sl(mLock);
 
             if (requests_.empty())
                 break;
-            requests = requests_;
-            cache = getLineCache(cache->getLedger(), false);
+            next->requests = requests_;
+            next->cache = getLineCache(work->cache->getLedger(), false);
+            next->newRequests = newRequests;
+            work = std::move(next);
         }
     } while (!app_.getJobQueue().isStopping());
 
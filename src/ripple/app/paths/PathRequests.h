@@ -23,6 +23,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/PathRequest.h>
 #include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/paths/TrustLineIndex.h>
 #include <ripple/core/Job.h>
 #include <atomic>
 #include <mutex>
@@ -38,7 +39,10 @@ public:
         Application& app,
         beast::Journal journal,
         beast::insight::Collector::ptr const& collector)
-        : app_(app), mJournal(journal), mLastIdentifier(0)
+        : app_(app)
+        , mJournal(journal)
+        , lineIndex_(std::make_shared<TrustLineIndex>())
+        , mLastIdentifier(0)
     {
         mFast = collector->make_event("pathfind_fast");
         mFull = collector->make_event("pathfind_full");
@@ -114,6 +118,9 @@ private:
     // Use a RippleLineCache
     std::weak_ptr<RippleLineCache> lineCache_;
 
+    // The trust lines of accounts, kept across line caches
+    std::shared_ptr<TrustLineIndex> lineIndex_;
+
     std::atomic<int> mLastIdentifier;
 
     std::recursive_mutex mutable mLock;
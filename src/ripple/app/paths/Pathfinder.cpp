@@ -30,6 +30,10 @@
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/PaymentSandbox.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 #include <tuple>
 
 /*
@@ -72,6 +76,9 @@ namespace {
 // good paths with this arbitrary cut off.
 constexpr std::size_t PATHFINDER_MAX_COMPLETE_PATHS = 1000;
 
+// The most threads that rank the paths of one pathfinder at once.
+constexpr std::size_t PATHFINDER_MAX_RANK_JOBS = 4;
+
 struct AccountCandidate
 {
     int priority;
@@ -509,32 +516,92 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
+    // The paths are ranked in parallel, by jobs and by this thread. Each
+    // ranks against a sandbox of its own over the shared ledger, and the
+    // ranks are kept in the order of the paths, so the result is the same
+    // as ranking them one after another.
+    struct Work
     {
-        if (continueCallback && !continueCallback())
-            return;
-        auto const& currentPath = paths[i];
-        if (!currentPath.empty())
-        {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity(
-                currentPath, saMinDstAmount, liquidity, uQuality);
-            if (resultCode != tesSUCCESS)
-            {
-                JLOG(j_.debug())
-                    << "findPaths: dropping : " << transToken(resultCode)
-                    << ": " << currentPath.getJson(JsonOptions::none);
-            }
-            else
+        std::size_t count;
+        std::vector<std::optional<PathRank>> ranks;
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> stopped{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+    };
+
+    auto work = std::make_shared<Work>();
+    work->count = paths.size();
+    work->ranks.resize(paths.size());
+
+    // Rank the next unclaimed path. Returns false once there are none left.
+    auto const rankNext =
+        [this, &paths, &saMinDstAmount, &continueCallback](Work& w) {
+            auto const i = w.next++;
+            if (i >= w.count)
+                return false;
+
+            if (w.stopped || (continueCallback && !continueCallback()))
+                w.stopped = true;
+            else if (auto const& currentPath = paths[i]; !currentPath.empty())
             {
-                JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
-                                 << currentPath.getJson(JsonOptions::none);
+                STAmount liquidity;
+                uint64_t uQuality;
+                auto const resultCode = getPathLiquidity(
+                    currentPath, saMinDstAmount, liquidity, uQuality);
+                if (resultCode != tesSUCCESS)
+                {
+                    JLOG(j_.debug())
+                        << "findPaths: dropping : " << transToken(resultCode)
+                        << ": " << currentPath.getJson(JsonOptions::none);
+                }
+                else
+                {
+                    JLOG(j_.debug())
+                        << "findPaths: quality: " << uQuality << ": "
+                        << currentPath.getJson(JsonOptions::none);
 
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
+                    w.ranks[i] = PathRank{
+                        uQuality, currentPath.size(), liquidity, int(i)};
+                }
             }
-        }
+
+            std::lock_guard lock(w.mutex);
+            if (++w.done == w.count)
+                w.cv.notify_all();
+            return true;
+        };
+
+    // Jobs that start after every path is claimed do nothing, so they may
+    // safely outlive this call.
+    auto const jobs = std::min<std::size_t>(
+        std::max<std::size_t>(paths.size(), 1) - 1,
+        PATHFINDER_MAX_RANK_JOBS - 1);
+    for (std::size_t i = 0; i < jobs; ++i)
+    {
+        if (!app_.getJobQueue().addJob(
+                jtPATH_UPDATE, "Pathfinder::rankPaths", [work, rankNext]() {
+                    while (rankNext(*work))
+                        ;
+                }))
+            break;
+    }
+
+    while (rankNext(*work))
+        ;
+    {
+        std::unique_lock lock(work->mutex);
+        work->cv.wait(lock, [&] { return work->done == work->count; });
+    }
+
+    if (work->stopped)
+        return;
+
+    for (auto& rank : work->ranks)
+    {
+        if (rank)
+            rankedPaths.push_back(std::move(*rank));
     }
 
     // Sort paths by:
@@ -20,13 +20,17 @@
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/app/paths/TrustLine.h>
 #include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/View.h>
+
+#include <optional>
 
 namespace ripple {
 
 RippleLineCache::RippleLineCache(
     std::shared_ptr<ReadView const> const& ledger,
-    beast::Journal j)
-    : ledger_(ledger), journal_(j)
+    beast::Journal j,
+    std::shared_ptr<TrustLineIndex> index)
+    : ledger_(ledger), index_(std::move(index)), journal_(j)
 {
     JLOG(journal_.debug()) << "created for ledger " << ledger_->info().seq;
 }
@@ -38,6 +42,71 @@ RippleLineCache::~RippleLineCache()
                            << totalLineCount_ << " distinct trust lines.";
 }
 
+void
+RippleLineCache::carryOver(
+    RippleLineCache& previous,
+    hash_set<AccountID> const& touched)
+{
+    assert(previous.ledger_->info().hash == ledger_->info().parentHash);
+
+    std::scoped_lock sl(mLock, previous.mLock);
+    for (auto const& [key, lines] : previous.lines_)
+    {
+        if (touched.count(key.account_))
+            continue;
+
+        AccountKey const newKey(
+            key.account_, key.direction_, hasher_(key.account_));
+        if (lines_.emplace(newKey, lines).second && lines)
+            totalLineCount_ += lines->size();
+    }
+
+    JLOG(journal_.debug()) << "carried over " << lines_.size()
+                           << " accounts from ledger "
+                           << previous.ledger_->info().seq;
+}
+
+std::vector<PathFindTrustLine>
+RippleLineCache::readLines(AccountID const& accountID, LineDirection direction)
+{
+    std::vector<PathFindTrustLine> items;
+    auto const add = [&](std::shared_ptr<SLE const> const& sle) {
+        auto item = PathFindTrustLine::makeItem(accountID, sle);
+        if (item &&
+            (direction == LineDirection::outgoing || !item->getNoRipple()))
+            items.push_back(std::move(*item));
+    };
+
+    if (index_)
+    {
+        if (auto const keys = index_->find(accountID, *ledger_))
+        {
+            for (auto const& key : *keys)
+                add(ledger_->read(Keylet(ltRIPPLE_STATE, key)));
+            items.shrink_to_fit();
+            return items;
+        }
+    }
+
+    // Walk the owner directory, and remember where the lines are for next
+    // time.
+    std::vector<uint256> keys;
+    forEachItem(
+        *ledger_, accountID, [&](std::shared_ptr<SLE const> const& sle) {
+            if (sle && sle->getType() == ltRIPPLE_STATE)
+                keys.push_back(sle->key());
+            add(sle);
+        });
+
+    if (index_)
+        index_->insert(accountID, *ledger_, std::move(keys));
+
+    // This list may be around for a while, so free up any unneeded
+    // capacity
+    items.shrink_to_fit();
+    return items;
+}
+
 std::shared_ptr<std::vector<PathFindTrustLine>>
 RippleLineCache::getRippleLines(
     AccountID const& accountID,
@@ -51,63 +120,83 @@ RippleLineCache::getRippleLines(
                                              : LineDirection::outgoing,
         hash);
 
-    std::lock_guard sl(mLock);
+    // The lines are read from the ledger without holding the lock, so that
+    // requests being updated in parallel don't wait on each other. If two
+    // read the same lines at once, the first to finish is kept.
+    std::optional<std::vector<PathFindTrustLine>> lines;
+    std::unique_lock sl(mLock);
+
+    for (;;)
+    {
+        if (auto iter = lines_.find(key); iter != lines_.end())
+        {
+            JLOG(journal_.trace())
+                << "getRippleLines for ledger " << ledger_->info().seq
+                << " found existing lines for " << accountID;
+            return iter->second;
+        }
 
-    auto [it, inserted] = [&]() {
         if (auto otheriter = lines_.find(otherkey); otheriter != lines_.end())
         {
             // The whole point of using the direction flag is to reduce the
-            // number of trust line objects held in memory. Ensure that there is
-            // only a single set of trustlines in the cache per account.
-            auto const size = otheriter->second ? otheriter->second->size() : 0;
-            JLOG(journal_.info())
-                << "Request for "
-                << (direction == LineDirection::outgoing ? "outgoing"
-                                                         : "incoming")
-                << " trust lines for account " << accountID << " found " << size
-                << (direction == LineDirection::outgoing ? " incoming"
-                                                         : " outgoing")
-                << " trust lines. "
-                << (direction == LineDirection::outgoing
-                        ? "Deleting the subset of incoming"
-                        : "Returning the superset of outgoing")
-                << " trust lines. ";
-            if (direction == LineDirection::outgoing)
+            // number of trust line objects held in memory. Ensure that there
+            // is only a single set of trustlines in the cache per account.
+            auto const size =
+                otheriter->second ? otheriter->second->size() : 0;
+            if (direction == LineDirection::incoming || lines)
             {
-                // This request is for the outgoing set, but there is already a
-                // subset of incoming lines in the cache. Erase that subset
-                // to be replaced by the full set. The full set will be built
-                // below, and will be returned, if needed, on subsequent calls
-                // for either value of outgoing.
-                assert(size <= totalLineCount_);
-                totalLineCount_ -= size;
-                lines_.erase(otheriter);
+                JLOG(journal_.info())
+                    << "Request for "
+                    << (direction == LineDirection::outgoing ? "outgoing"
+                                                             : "incoming")
+                    << " trust lines for account " << accountID << " found "
+                    << size
+                    << (direction == LineDirection::outgoing ? " incoming"
+                                                             : " outgoing")
+                    << " trust lines. "
+                    << (direction == LineDirection::outgoing
+                            ? "Deleting the subset of incoming"
+                            : "Returning the superset of outgoing")
+                    << " trust lines. ";
             }
-            else
+            if (direction == LineDirection::incoming)
             {
                 // This request is for the incoming set, but there is
-                // already a superset of the outgoing trust lines in the cache.
-                // The path finding engine will disregard the non-rippling trust
-                // lines, so to prevent them from being stored twice, return the
-                // outgoing set.
-                key = otherkey;
-                return std::pair{otheriter, false};
+                // already a superset of the outgoing trust lines in the
+                // cache. The path finding engine will disregard the
+                // non-rippling trust lines, so to prevent them from being
+                // stored twice, return the outgoing set.
+                return otheriter->second;
+            }
+
+            // This request is for the outgoing set, but there is already a
+            // subset of incoming lines in the cache. Erase that subset to be
+            // replaced by the full set. The full set will be built below,
+            // and will be returned, if needed, on subsequent calls for
+            // either value of outgoing.
+            if (lines)
+            {
+                assert(size <= totalLineCount_);
+                totalLineCount_ -= size;
+                lines_.erase(otheriter);
             }
         }
-        return lines_.emplace(key, nullptr);
-    }();
 
-    if (inserted)
+        if (lines)
+            break;
+
+        sl.unlock();
+        lines = readLines(accountID, direction);
+        sl.lock();
+    }
+
+    auto [it, inserted] = lines_.emplace(key, nullptr);
+    assert(inserted);
+    if (lines->size())
     {
-        assert(it->second == nullptr);
-        auto lines =
-            PathFindTrustLine::getItems(accountID, *ledger_, direction);
-        if (lines.size())
-        {
-            it->second = std::make_shared<std::vector<PathFindTrustLine>>(
-                std::move(lines));
-            totalLineCount_ += it->second->size();
-        }
+        it->second = std::make_shared<std::vector<PathFindTrustLine>>(
+            std::move(*lines));
+        totalLineCount_ += it->second->size();
     }
 
     assert(!it->second || (it->second->size() > 0));
@@ -117,8 +206,8 @@ RippleLineCache::getRippleLines(
                            << (key.direction_ == LineDirection::outgoing
                                    ? " outgoing"
                                    : " incoming")
-                           << " lines for " << (inserted ? "new " : "existing ")
-                           << accountID << " out of a total of "
+                           << " lines for new " << accountID
+                           << " out of a total of "
                            << lines_.size() << " accounts and "
                            << totalLineCount_ << " trust lines";
 
@@ -22,6 +22,7 @@
 
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/paths/TrustLine.h>
+#include <ripple/app/paths/TrustLineIndex.h>
 #include <ripple/basics/CountedObject.h>
 #include <ripple/basics/hardened_hash.h>
 
@@ -36,11 +37,29 @@ namespace ripple {
 class RippleLineCache final : public CountedObject<RippleLineCache>
 {
 public:
+    /** Create a cache of the trust lines in a ledger.
+
+        @param index Where to look for the keys of an account's trust lines
+                     before walking its owner directory, and to record them
+                     after, if anywhere.
+    */
     explicit RippleLineCache(
         std::shared_ptr<ReadView const> const& l,
-        beast::Journal j);
+        beast::Journal j,
+        std::shared_ptr<TrustLineIndex> index = {});
     ~RippleLineCache();
 
+    /** Take the lines of the accounts a ledger didn't change from the cache
+        of its parent.
+
+        @param previous The cache of the parent ledger
+        @param touched The accounts whose trust lines the ledger changed
+    */
+    void
+    carryOver(
+        RippleLineCache& previous,
+        hash_set<AccountID> const& touched);
+
     std::shared_ptr<ReadView const> const&
     getLedger() const
     {
@@ -63,10 +82,14 @@ public:
     getRippleLines(AccountID const& accountID, LineDirection direction);
 
 private:
+    std::vector<PathFindTrustLine>
+    readLines(AccountID const& accountID, LineDirection direction);
+
     std::mutex mLock;
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr<ReadView const> ledger_;
+    std::shared_ptr<TrustLineIndex> index_;
 
     beast::Journal journal_;
 
@@ -0,0 +1,268 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/TrustLineIndex.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/SField.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/TxMeta.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+// A trust line created, modified or deleted by a transaction
+struct LineChange
+{
+    uint256 key;
+    AccountID low;
+    AccountID high;
+    SField const* type;
+};
+
+// The trust lines changed by the transactions of a ledger, in the order
+// they were applied. Returns std::nullopt if the metadata does not say.
+std::optional<std::vector<LineChange>>
+lineChanges(ReadView const& ledger)
+{
+    std::vector<std::pair<std::uint32_t, LineChange>> changes;
+
+    for (auto const& [tx, meta] : ledger.txs)
+    {
+        if (!meta)
+            return std::nullopt;
+
+        auto const index = meta->getFieldU32(sfTransactionIndex);
+        for (auto const& node : meta->getFieldArray(sfAffectedNodes))
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+
+            auto const& type = node.getFName();
+            auto const fields = dynamic_cast<STObject const*>(
+                node.peekAtPField(
+                    type == sfCreatedNode ? sfNewFields : sfFinalFields));
+            if (!fields || !fields->isFieldPresent(sfLowLimit) ||
+                !fields->isFieldPresent(sfHighLimit))
+                return std::nullopt;
+
+            changes.emplace_back(
+                index,
+                LineChange{
+                    node.getFieldH256(sfLedgerIndex),
+                    fields->getFieldAmount(sfLowLimit).getIssuer(),
+                    fields->getFieldAmount(sfHighLimit).getIssuer(),
+                    &type});
+        }
+    }
+
+    std::stable_sort(
+        changes.begin(), changes.end(), [](auto const& a, auto const& b) {
+            return a.first < b.first;
+        });
+
+    std::vector<LineChange> result;
+    result.reserve(changes.size());
+    for (auto& change : changes)
+        result.push_back(std::move(change.second));
+    return result;
+}
+
+}  // namespace
+
+std::optional<hash_set<AccountID>>
+TrustLineIndex::advance(ReadView const& ledger)
+{
+    if (ledger.open())
+        return std::nullopt;
+
+    uint256 parentHash;
+    {
+        std::lock_guard lock(mutex_);
+        if (seq_ != 0 && ledger.info().hash == hash_)
+            return std::nullopt;
+        parentHash = hash_;
+    }
+
+    // Read the metadata without holding the lock, so that lookups of the
+    // lines as of the parent ledger aren't held up.
+    std::optional<std::vector<LineChange>> changes;
+    if (parentHash.isNonZero() && ledger.info().parentHash == parentHash)
+        changes = lineChanges(ledger);
+
+    std::lock_guard lock(mutex_);
+    if (!changes || hash_ != parentHash)
+    {
+        clear();
+        seq_ = ledger.seq();
+        hash_ = ledger.info().hash;
+        return std::nullopt;
+    }
+
+    hash_set<AccountID> touched;
+    for (auto const& change : *changes)
+    {
+        for (auto const& account : {change.low, change.high})
+        {
+            touched.insert(account);
+
+            if (change.type == &sfModifiedNode)
+                continue;
+            auto keys = lookup(account);
+            if (!keys)
+                continue;
+
+            if (change.type == &sfCreatedNode)
+                keys->push_back(change.key);
+            else
+                keys->erase(
+                    std::remove(keys->begin(), keys->end(), change.key),
+                    keys->end());
+            replace(account, std::move(*keys));
+        }
+    }
+
+    seq_ = ledger.seq();
+    hash_ = ledger.info().hash;
+
+    if (keys_.size() + changedLines_ > maxLines)
+        clear();
+    else if (changed_.size() > slots_.size() / 4 + minCompact)
+        compact();
+
+    return touched;
+}
+
+std::optional<std::vector<uint256>>
+TrustLineIndex::find(AccountID const& account, ReadView const& ledger) const
+{
+    std::lock_guard lock(mutex_);
+    if (!reflects(ledger))
+        return std::nullopt;
+    return lookup(account);
+}
+
+void
+TrustLineIndex::insert(
+    AccountID const& account,
+    ReadView const& ledger,
+    std::vector<uint256> keys)
+{
+    std::lock_guard lock(mutex_);
+    if (!reflects(ledger) || changed_.count(account) || slots_.count(account))
+        return;
+
+    if (keys_.size() + changedLines_ + keys.size() > maxLines)
+        return;
+
+    changedLines_ += keys.size();
+    changed_.emplace(account, std::move(keys));
+}
+
+std::size_t
+TrustLineIndex::size() const
+{
+    std::lock_guard lock(mutex_);
+    auto count = changed_.size();
+    for (auto const& [account, slot] : slots_)
+        count += changed_.count(account) ? 0 : 1;
+    return count;
+}
+
+bool
+TrustLineIndex::reflects(ReadView const& ledger) const
+{
+    return seq_ != 0 && !ledger.open() && ledger.seq() == seq_ &&
+        ledger.info().hash == hash_;
+}
+
+std::optional<std::vector<uint256>>
+TrustLineIndex::lookup(AccountID const& account) const
+{
+    if (auto iter = changed_.find(account); iter != changed_.end())
+        return iter->second;
+
+    if (auto iter = slots_.find(account); iter != slots_.end())
+    {
+        return std::vector<uint256>(
+            keys_.begin() + offsets_[iter->second],
+            keys_.begin() + offsets_[iter->second + 1]);
+    }
+
+    return std::nullopt;
+}
+
+void
+TrustLineIndex::replace(AccountID const& account, std::vector<uint256> keys)
+{
+    auto& entry = changed_[account];
+    changedLines_ -= entry.size();
+    changedLines_ += keys.size();
+    entry = std::move(keys);
+}
+
+void
+TrustLineIndex::compact()
+{
+    hash_map<AccountID, std::uint32_t> slots;
+    std::vector<std::uint32_t> offsets;
+    std::vector<uint256> keys;
+
+    slots.reserve(slots_.size() + changed_.size());
+    offsets.reserve(slots_.size() + changed_.size() + 1);
+    keys.reserve(keys_.size() + changedLines_);
+
+    auto const add = [&](AccountID const& account, auto first, auto last) {
+        slots.emplace(account, offsets.size());
+        offsets.push_back(keys.size());
+        keys.insert(keys.end(), first, last);
+    };
+
+    for (auto const& [account, slot] : slots_)
+    {
+        if (!changed_.count(account))
+            add(account,
+                keys_.begin() + offsets_[slot],
+                keys_.begin() + offsets_[slot + 1]);
+    }
+    for (auto const& [account, lines] : changed_)
+        add(account, lines.begin(), lines.end());
+    offsets.push_back(keys.size());
+
+    slots_.swap(slots);
+    offsets_.swap(offsets);
+    keys_.swap(keys);
+    changed_.clear();
+    changedLines_ = 0;
+}
+
+void
+TrustLineIndex::clear()
+{
+    slots_.clear();
+    offsets_.clear();
+    keys_.clear();
+    changed_.clear();
+    changedLines_ = 0;
+}
+
+}  // namespace ripple
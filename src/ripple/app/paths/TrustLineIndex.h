@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_PATHS_TRUSTLINEINDEX_H_INCLUDED
+#define RIPPLE_APP_PATHS_TRUSTLINEINDEX_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/AccountID.h>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** The trust lines of accounts, kept from ledger to ledger.
+
+    The index learns the lines of an account the first time they are read
+    from its owner directory. From then on it follows the lines created and
+    deleted by the transactions of each ledger, so that they need not be
+    looked for again.
+
+    The keys of the lines of all the accounts are stored in one array, in
+    compressed sparse row form: each account has an offset into it. The
+    lines of accounts that changed since are kept apart, until enough have
+    changed that it is worth merging them back.
+*/
+class TrustLineIndex
+{
+public:
+    /** Bring the index up to a closed ledger.
+
+        @return The accounts whose trust lines were created, modified or
+                deleted by the ledger, if the index reflected its parent;
+                otherwise std::nullopt, and unless the index already
+                reflects the ledger, it starts over.
+    */
+    std::optional<hash_set<AccountID>>
+    advance(ReadView const& ledger);
+
+    /** The keys of the trust lines of an account.
+
+        @return std::nullopt if the lines of the account in `ledger` are
+                not known.
+    */
+    std::optional<std::vector<uint256>>
+    find(AccountID const& account, ReadView const& ledger) const;
+
+    /** Learn the trust lines of an account, as read from `ledger`. */
+    void
+    insert(
+        AccountID const& account,
+        ReadView const& ledger,
+        std::vector<uint256> keys);
+
+    /** The number of accounts whose trust lines are known. */
+    std::size_t
+    size() const;
+
+private:
+    // The most trust lines kept, over all accounts
+    static constexpr std::size_t maxLines = 1 << 22;
+
+    // The arrays are rebuilt once more than a quarter of the accounts, and
+    // more than this many, changed since they were last built.
+    static constexpr std::size_t minCompact = 16;
+
+    bool
+    reflects(ReadView const& ledger) const;
+
+    std::optional<std::vector<uint256>>
+    lookup(AccountID const& account) const;
+
+    void
+    replace(AccountID const& account, std::vector<uint256> keys);
+
+    void
+    compact();
+
+    void
+    clear();
+
+    std::mutex mutable mutex_;
+
+    // The ledger the index reflects
+    LedgerIndex seq_ = 0;
+    uint256 hash_;
+
+    // The lines of account `slots_[a]` are keys_[offsets_[a]] up to
+    // keys_[offsets_[a + 1]].
+    hash_map<AccountID, std::uint32_t> slots_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<uint256> keys_;
+
+    // The lines of the accounts that changed since the arrays were built
+    hash_map<AccountID, std::vector<uint256>> changed_;
+    std::size_t changedLines_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
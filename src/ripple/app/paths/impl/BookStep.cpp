@@ -837,11 +837,20 @@ template <class TIn, class TOut, class TDerived>
 std::optional<std::variant<Quality, AMMOffer<TIn, TOut>>>
 BookStep<TIn, TOut, TDerived>::tip(ReadView const& view) const
 {
-    // This can be simplified (and sped up) if directories are never empty.
-    Sandbox sb(&view, tapNONE);
-    BookTip bt(sb, book_);
+    auto const clobTip = [&]() -> std::optional<Quality> {
+        // This can be simplified (and sped up) if directories are never empty.
+        Sandbox sb(&view, tapNONE);
+        BookTip bt(sb, book_);
+        if (bt.step(j_))
+            return bt.quality();
+        return std::nullopt;
+    };
+    // The strands of a payment are ranked against the payment's sandbox,
+    // which remembers the tips of the books it has been asked about. AMM
+    // offers depend on the AMMContext as well, so they are always made anew.
+    auto const psb = dynamic_cast<PaymentSandbox const*>(&view);
     auto const clobQuality =
-        bt.step(j_) ? std::optional<Quality>(bt.quality()) : std::nullopt;
+        psb ? psb->bookTipQuality(book_, clobTip) : clobTip();
     // Don't pass in clobQuality. For one-path it returns the offer as
     // the pool balances and the resulting quality is Spot Price Quality.
     // For multi-path it returns the actual offer.
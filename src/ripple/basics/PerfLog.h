@@ -138,6 +138,16 @@ public:
     virtual void
     jobFinish(JobType const type, microseconds dur, int instance) = 0;
 
+    /**
+     * Log completion of a timed phase of work, such as a step of closing
+     * a ledger
+     *
+     * @param phase Name of the phase
+     * @param dur Duration of the phase in microseconds
+     */
+    virtual void
+    phaseFinish(char const* phase, microseconds dur) = 0;
+
     /**
      * Render performance counters in Json
      *
@@ -45,6 +45,15 @@ namespace ripple {
 
     @note Callers must not modify data objects that are stored in the cache
           unless they hold their own lock over all cache operations.
+
+    When PartitionLocks is true, every partition of the underlying map is
+    guarded by its own lock. Operations on a single key (fetch, canonicalize,
+    del, ...) only take the lock of the partition holding that key, so
+    lookups of unrelated keys no longer contend, and each partition is swept
+    while the others remain available. Whole-cache operations still take the
+    cache mutex followed by every partition lock. peekMutex() is not
+    available in this mode because the cache mutex no longer guards
+    individual entries.
 */
 template <
     class Key,
@@ -52,11 +61,13 @@ template <
     bool IsKeyCache = false,
     class Hash = hardened_hash<>,
     class KeyEqual = std::equal_to<Key>,
-    class Mutex = std::recursive_mutex>
+    class Mutex = std::recursive_mutex,
+    bool PartitionLocks = false>
 class TaggedCache
 {
 public:
     using mutex_type = Mutex;
+    using partition_mutex_type = std::mutex;
     using key_type = Key;
     using mapped_type = T;
     using clock_type = beast::abstract_clock<std::chrono::steady_clock>;
@@ -82,6 +93,7 @@ public:
         , m_cache_count(0)
         , m_hits(0)
         , m_misses(0)
+        , m_partitionMutexes(PartitionLocks ? m_cache.partitions() : 0)
     {
     }
 
@@ -98,6 +110,7 @@ public:
     size() const
     {
         std::lock_guard lock(m_mutex);
+        auto const partitionLocks = lockAllPartitions();
         return m_cache.size();
     }
 
@@ -105,6 +118,7 @@ public:
     setTargetSize(int s)
     {
         std::lock_guard lock(m_mutex);
+        auto const partitionLocks = lockAllPartitions();
         m_target_size = s;
 
         if (s > 0)
@@ -140,29 +154,28 @@ public:
     int
     getCacheSize() const
     {
-        std::lock_guard lock(m_mutex);
         return m_cache_count;
     }
 
     int
     getTrackSize() const
     {
-        std::lock_guard lock(m_mutex);
-        return m_cache.size();
+        return size();
     }
 
     float
     getHitRate()
     {
-        std::lock_guard lock(m_mutex);
-        auto const total = static_cast<float>(m_hits + m_misses);
-        return m_hits * (100.0f / std::max(1.0f, total));
+        std::uint64_t const hits = m_hits;
+        auto const total = static_cast<float>(hits + m_misses);
+        return hits * (100.0f / std::max(1.0f, total));
     }
 
     void
     clear()
     {
         std::lock_guard lock(m_mutex);
+        auto const partitionLocks = lockAllPartitions();
         m_cache.clear();
         m_cache_count = 0;
     }
@@ -171,6 +184,7 @@ public:
     reset()
     {
         std::lock_guard lock(m_mutex);
+        auto const partitionLocks = lockAllPartitions();
         m_cache.clear();
         m_cache_count = 0;
         m_hits = 0;
@@ -184,9 +198,10 @@ public:
     bool
     touch_if_exists(KeyComparable const& key)
     {
-        std::lock_guard lock(m_mutex);
-        auto const iter(m_cache.find(key));
-        if (iter == m_cache.end())
+        auto const lock = lockPartition(key);
+        auto& partition = m_cache.partitionMap(key);
+        auto const iter(partition.find(key));
+        if (iter == partition.end())
         {
             ++m_stats.misses;
             return false;
@@ -215,22 +230,28 @@ public:
         {
             std::lock_guard lock(m_mutex);
 
+            // With partition locks the entry count is only a snapshot: other
+            // threads may keep inserting while the partitions are swept.
+            std::size_t const cacheSize = [this] {
+                auto const partitionLocks = lockAllPartitions();
+                return m_cache.size();
+            }();
+
             if (m_target_size == 0 ||
-                (static_cast<int>(m_cache.size()) <= m_target_size))
+                (static_cast<int>(cacheSize) <= m_target_size))
             {
                 when_expire = now - m_target_age;
             }
             else
             {
-                when_expire =
-                    now - m_target_age * m_target_size / m_cache.size();
+                when_expire = now - m_target_age * m_target_size / cacheSize;
 
                 clock_type::duration const minimumAge(std::chrono::seconds(1));
                 if (when_expire > (now - minimumAge))
                     when_expire = now - minimumAge;
 
                 JLOG(m_journal.trace())
-                    << m_name << " is growing fast " << m_cache.size() << " of "
+                    << m_name << " is growing fast " << cacheSize << " of "
                     << m_target_size << " aging at "
                     << (now - when_expire).count() << " of "
                     << m_target_age.count();
@@ -246,6 +267,7 @@ public:
                     when_expire,
                     now,
                     m_cache.map()[p],
+                    p,
                     allStuffToSweep[p],
                     allRemovals,
                     lock));
@@ -270,11 +292,12 @@ public:
     {
         // Remove from cache, if !valid, remove from map too. Returns true if
         // removed from cache
-        std::lock_guard lock(m_mutex);
+        auto const lock = lockPartition(key);
+        auto& partition = m_cache.partitionMap(key);
 
-        auto cit = m_cache.find(key);
+        auto cit = partition.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == partition.end())
             return false;
 
         Entry& entry = cit->second;
@@ -289,7 +312,7 @@ public:
         }
 
         if (!valid || entry.isExpired())
-            m_cache.erase(cit);
+            partition.erase(cit);
 
         return ret;
     }
@@ -316,13 +339,14 @@ public:
     {
         // Return canonical value, store if needed, refresh in cache
         // Return values: true=we had the data already
-        std::lock_guard lock(m_mutex);
+        auto const lock = lockPartition(key);
+        auto& partition = m_cache.partitionMap(key);
 
-        auto cit = m_cache.find(key);
+        auto cit = partition.find(key);
 
-        if (cit == m_cache.end())
+        if (cit == partition.end())
         {
-            m_cache.emplace(
+            partition.emplace(
                 std::piecewise_construct,
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
@@ -395,7 +419,7 @@ public:
     std::shared_ptr<T>
     fetch(const key_type& key)
     {
-        std::lock_guard<mutex_type> l(m_mutex);
+        auto const l = lockPartition(key);
         auto ret = initialFetch(key, l);
         if (!ret)
             ++m_misses;
@@ -419,9 +443,9 @@ public:
     auto
     insert(key_type const& key) -> std::enable_if_t<IsKeyCache, ReturnType>
     {
-        std::lock_guard lock(m_mutex);
+        auto const lock = lockPartition(key);
         clock_type::time_point const now(m_clock.now());
-        auto [it, inserted] = m_cache.emplace(
+        auto [it, inserted] = m_cache.partitionMap(key).emplace(
             std::piecewise_construct,
             std::forward_as_tuple(key),
             std::forward_as_tuple(now));
@@ -451,6 +475,10 @@ public:
     mutex_type&
     peekMutex()
     {
+        static_assert(
+            !PartitionLocks,
+            "The cache mutex does not guard entries when partition locks "
+            "are enabled");
         return m_mutex;
     }
 
@@ -461,6 +489,7 @@ public:
 
         {
             std::lock_guard lock(m_mutex);
+            auto const partitionLocks = lockAllPartitions();
             v.reserve(m_cache.size());
             for (auto const& _ : m_cache)
                 v.push_back(_.first);
@@ -474,11 +503,11 @@ public:
     double
     rate() const
     {
-        std::lock_guard lock(m_mutex);
-        auto const tot = m_hits + m_misses;
+        std::uint64_t const hits = m_hits;
+        auto const tot = hits + m_misses;
         if (tot == 0)
             return 0;
-        return double(m_hits) / tot;
+        return double(hits) / tot;
     }
 
     /** Fetch an item from the cache.
@@ -491,7 +520,7 @@ public:
     fetch(key_type const& digest, Handler const& h)
     {
         {
-            std::lock_guard l(m_mutex);
+            auto const l = lockPartition(digest);
             if (auto ret = initialFetch(digest, l))
                 return ret;
         }
@@ -500,10 +529,10 @@ public:
         if (!sle)
             return {};
 
-        std::lock_guard l(m_mutex);
+        auto const l = lockPartition(digest);
         ++m_misses;
-        auto const [it, inserted] =
-            m_cache.emplace(digest, Entry(m_clock.now(), std::move(sle)));
+        auto const [it, inserted] = m_cache.partitionMap(digest).emplace(
+            digest, Entry(m_clock.now(), std::move(sle)));
         if (!inserted)
             it->second.touch(m_clock.now());
         return it->second.ptr;
@@ -511,11 +540,50 @@ public:
     // End CachedSLEs functions.
 
 private:
+    using partition_lock_type = std::conditional_t<
+        PartitionLocks,
+        std::unique_lock<partition_mutex_type>,
+        std::unique_lock<mutex_type>>;
+
+    /** Lock whatever guards the entry for key.
+        That is the partition lock when partition locks are enabled, and the
+        cache mutex otherwise.
+    */
+    template <class KeyComparable>
+    [[nodiscard]] partition_lock_type
+    lockPartition(KeyComparable const& key) const
+    {
+        if constexpr (PartitionLocks)
+            return partition_lock_type(
+                m_partitionMutexes[m_cache.partition(key)].mutex);
+        else
+            return partition_lock_type(m_mutex);
+    }
+
+    /** Lock every partition, in index order.
+        Must be called with m_mutex held. Does nothing (and returns no
+        locks) when partition locks are disabled, because m_mutex already
+        guards the entries.
+    */
+    [[nodiscard]] std::vector<std::unique_lock<partition_mutex_type>>
+    lockAllPartitions() const
+    {
+        std::vector<std::unique_lock<partition_mutex_type>> locks;
+        if constexpr (PartitionLocks)
+        {
+            locks.reserve(m_partitionMutexes.size());
+            for (auto& p : m_partitionMutexes)
+                locks.emplace_back(p.mutex);
+        }
+        return locks;
+    }
+
     std::shared_ptr<T>
-    initialFetch(key_type const& key, std::lock_guard<mutex_type> const& l)
+    initialFetch(key_type const& key, partition_lock_type const& l)
     {
-        auto cit = m_cache.find(key);
-        if (cit == m_cache.end())
+        auto& partition = m_cache.partitionMap(key);
+        auto cit = partition.find(key);
+        if (cit == partition.end())
             return {};
 
         Entry& entry = cit->second;
@@ -534,7 +602,7 @@ private:
             return entry.ptr;
         }
 
-        m_cache.erase(cit);
+        partition.erase(cit);
         return {};
     }
 
@@ -546,10 +614,10 @@ private:
         {
             beast::insight::Gauge::value_type hit_rate(0);
             {
-                std::lock_guard lock(m_mutex);
-                auto const total(m_hits + m_misses);
+                std::uint64_t const hits = m_hits;
+                auto const total(hits + m_misses);
                 if (total != 0)
-                    hit_rate = (m_hits * 100) / total;
+                    hit_rate = (hits * 100) / total;
             }
             m_stats.hit_rate.set(hit_rate);
         }
@@ -575,8 +643,8 @@ private:
         beast::insight::Gauge size;
         beast::insight::Gauge hit_rate;
 
-        std::size_t hits;
-        std::size_t misses;
+        std::atomic<std::size_t> hits;
+        std::atomic<std::size_t> misses;
     };
 
     class KeyOnlyEntry
@@ -655,11 +723,17 @@ private:
         clock_type::time_point const& when_expire,
         [[maybe_unused]] clock_type::time_point const& now,
         typename KeyValueCacheType::map_type& partition,
+        std::size_t partitionIndex,
         SweptPointersVector& stuffToSweep,
         std::atomic<int>& allRemovals,
         std::lock_guard<std::recursive_mutex> const&)
     {
-        return std::thread([&, this]() {
+        return std::thread([&, partitionIndex, this]() {
+            std::unique_lock<partition_mutex_type> partitionLock;
+            if constexpr (PartitionLocks)
+                partitionLock = std::unique_lock(
+                    m_partitionMutexes[partitionIndex].mutex);
+
             int cacheRemovals = 0;
             int mapRemovals = 0;
 
@@ -729,11 +803,17 @@ private:
         clock_type::time_point const& when_expire,
         clock_type::time_point const& now,
         typename KeyOnlyCacheType::map_type& partition,
+        std::size_t partitionIndex,
         SweptPointersVector&,
         std::atomic<int>& allRemovals,
         std::lock_guard<std::recursive_mutex> const&)
     {
-        return std::thread([&, this]() {
+        return std::thread([&, partitionIndex, this]() {
+            std::unique_lock<partition_mutex_type> partitionLock;
+            if constexpr (PartitionLocks)
+                partitionLock = std::unique_lock(
+                    m_partitionMutexes[partitionIndex].mutex);
+
             int cacheRemovals = 0;
             int mapRemovals = 0;
 
@@ -787,10 +867,18 @@ private:
     clock_type::duration m_target_age;
 
     // Number of items cached
-    int m_cache_count;
+    std::atomic<int> m_cache_count;
     cache_type m_cache;  // Hold strong reference to recent objects
-    std::uint64_t m_hits;
-    std::uint64_t m_misses;
+    std::atomic<std::uint64_t> m_hits;
+    std::atomic<std::uint64_t> m_misses;
+
+    // One lock per partition of m_cache, only used with PartitionLocks.
+    // Padded to avoid false sharing between neighbouring partitions.
+    struct alignas(64) PartitionMutex
+    {
+        partition_mutex_type mutable mutex;
+    };
+    std::vector<PartitionMutex> m_partitionMutexes;
 };
 
 }  // namespace ripple
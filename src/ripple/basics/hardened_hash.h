@@ -115,6 +115,20 @@ public:
     }
 };
 
+/** Returns which of `count` shards a key belongs in.
+
+    The key is hashed with a seed chosen at startup, so keys made to share
+    their leading bytes, like vanity account IDs, still spread evenly over
+    the shards.
+*/
+template <class Key>
+std::size_t
+shardIndex(Key const& key, std::size_t count)
+{
+    static hardened_hash<> const hasher;
+    return hasher(key) % count;
+}
+
 }  // namespace ripple
 
 #endif
@@ -255,12 +255,31 @@ public:
         return partitions_;
     }
 
+    /** Returns the index of the partition that holds (or would hold) key. */
+    std::size_t
+    partition(key_type const& key) const
+    {
+        return partitioner(key);
+    }
+
     partition_map_type&
     map()
     {
         return map_;
     }
 
+    /** Returns the map of the partition that holds (or would hold) key.
+
+        Finding, inserting and erasing through it only touches that
+        partition, whereas the iterators of the whole map step into the
+        others. Use it where only that partition is locked.
+    */
+    map_type&
+    partitionMap(key_type const& key)
+    {
+        return map_[partitioner(key)];
+    }
+
     iterator
     begin()
     {
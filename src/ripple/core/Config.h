@@ -232,6 +232,14 @@ public:
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
 
+    // Apply the transactions carried over to a new open ledger
+    // speculatively in parallel
+    bool SPECULATIVE_APPLY = false;
+
+    // Prefetch the ledger entries and check the signatures of consensus
+    // transactions in parallel while building a ledger
+    bool PARALLEL_LEDGER_BUILD = false;
+
     // Work queue limits. 10000 transactions is 2 full seconds of slowdown at
     // 5000/s.
     int MAX_TRANSACTIONS = 10'000;
@@ -246,6 +254,10 @@ public:
     int IO_WORKERS = 0;        // io svc thread count. default: 2
     int PREFETCH_WORKERS = 0;  // prefetch thread count. default: 4
 
+    // Whether the job queue workers steal jobs from each other's run queues
+    // instead of sharing a single queue
+    bool WORKERS_STEAL = false;
+
     // Can only be set in code, specifically unit tests
     bool FORCE_MULTI_THREAD = false;
 
@@ -94,9 +94,12 @@ struct ConfigSection
 #define SECTION_VALIDATOR_TOKEN "validator_token"
 #define SECTION_VETO_AMENDMENTS "veto_amendments"
 #define SECTION_WORKERS "workers"
+#define SECTION_WORKERS_SCHEDULER "workers_scheduler"
 #define SECTION_IO_WORKERS "io_workers"
 #define SECTION_PREFETCH_WORKERS "prefetch_workers"
 #define SECTION_LEDGER_REPLAY "ledger_replay"
+#define SECTION_SPECULATIVE_APPLY "speculative_apply"
+#define SECTION_PARALLEL_LEDGER_BUILD "parallel_ledger_build"
 #define SECTION_BETA_RPC_API "beta_rpc_api"
 #define SECTION_SWEEP_INTERVAL "sweep_interval"
 #define SECTION_NETWORK_ID "network_id"
@@ -29,6 +29,9 @@
 #include <boost/coroutine/all.hpp>
 #include <boost/range/begin.hpp>  // workaround for boost 1.72 bug
 #include <boost/range/end.hpp>    // workaround for boost 1.72 bug
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace ripple {
 
@@ -140,12 +143,19 @@ public:
 
     using JobFunction = std::function<void()>;
 
+    /** Create the JobQueue.
+
+        @param workStealing If true, jobs of types without a running limit
+            are kept in a run queue per worker thread instead of in the
+            single shared set, and idle workers steal from each other.
+    */
     JobQueue(
         int threadCount,
         beast::insight::Collector::ptr const& collector,
         beast::Journal journal,
         Logs& logs,
-        perf::PerfLog& perfLog);
+        perf::PerfLog& perfLog,
+        bool workStealing = false);
     ~JobQueue();
 
     /** Adds a job to the JobQueue.
@@ -242,9 +252,22 @@ private:
 
     using JobDataMap = std::map<JobType, JobTypeData>;
 
+    // The jobs of one worker when work stealing is enabled. They are kept
+    // in the same order as m_jobSet so the worker, or a thief, always takes
+    // the job with the highest priority.
+    struct RunQueue
+    {
+        std::mutex mutex;
+        std::set<Job> jobs;
+
+        // The type of the first job, or jtINVALID if there is none. This is
+        // read without the lock to decide which queue to take from.
+        std::atomic<int> top{jtINVALID};
+    };
+
     beast::Journal m_journal;
     mutable std::mutex m_mutex;
-    std::uint64_t m_lastJob;
+    std::atomic<std::uint64_t> m_lastJob;
     std::set<Job> m_jobSet;
     JobCounter jobCounter_;
     std::atomic_bool stopping_{false};
@@ -258,6 +281,20 @@ private:
     // The number of suspended coroutines
     int nSuspend_ = 0;
 
+    bool const workStealing_;
+    std::vector<std::unique_ptr<RunQueue>> runQueues_;
+    std::atomic<std::size_t> nextQueue_{0};
+
+    // The number of jobs in the run queues, or taken from them and not yet
+    // finished
+    std::atomic<int> localCount_{0};
+
+    // When work stealing, the number of tasks signaled for jobs in m_jobSet
+    // that no worker has claimed yet, and the type of the first job in
+    // m_jobSet if that number is not zero.
+    int sharedRunnable_ = 0;
+    std::atomic<int> sharedTop_{jtINVALID};
+
     Workers m_workers;
 
     // Statistics tracking
@@ -287,6 +324,41 @@ private:
         std::string const& name,
         JobFunction const& func);
 
+    // Signals a worker to run a job from m_jobSet.
+    //
+    // Invariants:
+    //  The calling thread owns the JobLock
+    void
+    signalShared();
+
+    // Recomputes sharedTop_.
+    //
+    // Invariants:
+    //  The calling thread owns the JobLock
+    void
+    updateSharedTop();
+
+    // Adds a job to a run queue. Jobs added from a worker thread go to the
+    // queue of that worker, others are spread over all the queues.
+    void
+    addLocalJob(Job&& job);
+
+    // Takes the job with the highest priority from the run queues or from
+    // m_jobSet, for a worker when work stealing is enabled.
+    //
+    // Returns true if the job came from a run queue, in which case the
+    // JobTypeData counts are already updated. Otherwise it behaves as
+    // getNextJob.
+    bool
+    takeJob(Job& job, int instance);
+
+    // True if no job is waiting or running.
+    //
+    // Invariants:
+    //  The calling thread owns the JobLock
+    bool
+    idle() const;
+
     // Returns the next Job we should run now.
     //
     // RunnableJob:
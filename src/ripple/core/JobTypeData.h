@@ -23,6 +23,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/beast/insight/Collector.h>
 #include <ripple/core/JobTypeInfo.h>
+#include <atomic>
 
 namespace ripple {
 
@@ -39,13 +40,13 @@ public:
     JobTypeInfo const& info;
 
     /* The number of jobs waiting */
-    int waiting;
+    std::atomic<int> waiting;
 
     /* The number presently running */
-    int running;
+    std::atomic<int> running;
 
     /* And the number we deferred executing because of job limits */
-    int deferred;
+    std::atomic<int> deferred;
 
     /* Notification callbacks */
     beast::insight::Event dequeue;
@@ -89,6 +89,7 @@ private:
         add(jtCLIENT_WEBSOCKET,  "clientWebsocket",      maxLimit,  2000ms,  5000ms);
         add(jtRPC,               "RPC",                  maxLimit,     0ms,     0ms);
         add(jtUPDATE_PF,         "updatePaths",                 1,     0ms,     0ms);
+        add(jtPATH_UPDATE,       "updatePathsPart",      maxLimit,     0ms,     0ms);
         add(jtTRANSACTION,       "transaction",          maxLimit,   250ms,  1000ms);
         add(jtBATCH,             "batch",                maxLimit,   250ms,  1000ms);
         add(jtADVANCE,           "advanceLedger",        maxLimit,     0ms,     0ms);
@@ -677,6 +677,18 @@ Config::loadFromString(std::string const& fileContents)
                 ": must be between 1 and 1024 inclusive.");
     }
 
+    if (getSingleSection(secConfig, SECTION_WORKERS_SCHEDULER, strTemp, j_))
+    {
+        if (boost::iequals(strTemp, "stealing"))
+            WORKERS_STEAL = true;
+        else if (boost::iequals(strTemp, "shared"))
+            WORKERS_STEAL = false;
+        else
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_WORKERS_SCHEDULER
+                ": must be 'shared' or 'stealing'.");
+    }
+
     if (getSingleSection(secConfig, SECTION_IO_WORKERS, strTemp, j_))
     {
         IO_WORKERS = beast::lexicalCastThrow<int>(strTemp);
@@ -703,6 +715,12 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_SPECULATIVE_APPLY, strTemp, j_))
+        SPECULATIVE_APPLY = beast::lexicalCastThrow<bool>(strTemp);
+
+    if (getSingleSection(secConfig, SECTION_PARALLEL_LEDGER_BUILD, strTemp, j_))
+        PARALLEL_LEDGER_BUILD = beast::lexicalCastThrow<bool>(strTemp);
+
     if (exists(SECTION_REDUCE_RELAY))
     {
         auto sec = section(SECTION_REDUCE_RELAY);
@@ -20,25 +20,47 @@
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/JobQueue.h>
+#include <algorithm>
+#include <limits>
 #include <mutex>
+#include <thread>
 
 namespace ripple {
 
+namespace {
+
+// The JobQueue whose worker owns the current thread, and the index of that
+// worker's run queue. Jobs added from a worker go to its own run queue.
+thread_local JobQueue const* ownerQueue = nullptr;
+thread_local std::size_t ownerIndex = 0;
+
+}  // namespace
+
 JobQueue::JobQueue(
     int threadCount,
     beast::insight::Collector::ptr const& collector,
     beast::Journal journal,
     Logs& logs,
-    perf::PerfLog& perfLog)
+    perf::PerfLog& perfLog,
+    bool workStealing)
     : m_journal(journal)
     , m_lastJob(0)
     , m_invalidJobData(JobTypes::instance().getInvalid(), collector, logs)
     , m_processCount(0)
+    , workStealing_(workStealing)
     , m_workers(*this, &perfLog, "JobQueue", threadCount)
     , perfLog_(perfLog)
     , m_collector(collector)
 {
-    JLOG(m_journal.info()) << "Using " << threadCount << "  threads";
+    JLOG(m_journal.info()) << "Using " << threadCount << "  threads"
+                           << (workStealing_ ? " with work stealing" : "");
+
+    if (workStealing_)
+    {
+        runQueues_.reserve(std::max(threadCount, 1));
+        for (int i = 0; i < std::max(threadCount, 1); ++i)
+            runQueues_.push_back(std::make_unique<RunQueue>());
+    }
 
     hook = m_collector->make_hook(std::bind(&JobQueue::collect, this));
     job_count = m_collector->make_gauge("job_count");
@@ -70,8 +92,15 @@ JobQueue::~JobQueue()
 void
 JobQueue::collect()
 {
+    std::size_t count = 0;
+    for (auto const& queue : runQueues_)
+    {
+        std::lock_guard lock(queue->mutex);
+        count += queue->jobs.size();
+    }
+
     std::lock_guard lock(m_mutex);
-    job_count = m_jobSet.size();
+    job_count = m_jobSet.size() + count;
 }
 
 bool
@@ -97,6 +126,14 @@ JobQueue::addRefCountedJob(
         (type >= jtCLIENT && type <= jtCLIENT_WEBSOCKET) ||
         m_workers.getNumberOfThreads() > 0);
 
+    // Jobs whose type has no limit never wait on other jobs of their type,
+    // so they can bypass the shared set.
+    if (workStealing_ && getJobLimit(type) == std::numeric_limits<int>::max())
+    {
+        addLocalJob(Job(type, name, ++m_lastJob, data.load(), func));
+        return true;
+    }
+
     {
         std::lock_guard lock(m_mutex);
         auto result =
@@ -112,7 +149,7 @@ JobQueue::addRefCountedJob(
 
         if (data.waiting + data.running < getJobLimit(type))
         {
-            m_workers.addTask();
+            signalShared();
         }
         else
         {
@@ -120,10 +157,54 @@ JobQueue::addRefCountedJob(
             ++data.deferred;
         }
         ++data.waiting;
+        updateSharedTop();
     }
     return true;
 }
 
+void
+JobQueue::signalShared()
+{
+    if (workStealing_)
+        ++sharedRunnable_;
+    m_workers.addTask();
+}
+
+void
+JobQueue::updateSharedTop()
+{
+    if (workStealing_)
+    {
+        sharedTop_ = sharedRunnable_ > 0 ? m_jobSet.begin()->getType()
+                                         : jtINVALID;
+    }
+}
+
+void
+JobQueue::addLocalJob(Job&& job)
+{
+    JobType const type = job.getType();
+    JobTypeData& data(getJobTypeData(type));
+
+    std::size_t const index = ownerQueue == this
+        ? ownerIndex
+        : nextQueue_++ % runQueues_.size();
+    RunQueue& queue = *runQueues_[index];
+
+    // Count the job before any worker can take it
+    ++localCount_;
+    ++data.waiting;
+    perfLog_.jobQueue(type);
+
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.insert(std::move(job));
+        queue.top = queue.jobs.begin()->getType();
+    }
+
+    m_workers.addTask();
+}
+
 int
 JobQueue::getJobCount(JobType t) const
 {
@@ -131,7 +212,7 @@ JobQueue::getJobCount(JobType t) const
 
     JobDataMap::const_iterator c = m_jobData.find(t);
 
-    return (c == m_jobData.end()) ? 0 : c->second.waiting;
+    return (c == m_jobData.end()) ? 0 : c->second.waiting.load();
 }
 
 int
@@ -254,7 +335,13 @@ void
 JobQueue::rendezvous()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+    cv_.wait(lock, [this] { return idle(); });
+}
+
+bool
+JobQueue::idle() const
+{
+    return m_processCount == 0 && m_jobSet.empty() && localCount_ == 0;
 }
 
 JobTypeData&
@@ -284,10 +371,10 @@ JobQueue::stop()
         // `Job::doJob` and the return of `JobQueue::processTask`. That is why
         // we must wait on the condition variable to make these assertions.
         std::unique_lock<std::mutex> lock(m_mutex);
-        cv_.wait(
-            lock, [this] { return m_processCount == 0 && m_jobSet.empty(); });
+        cv_.wait(lock, [this] { return idle(); });
         assert(m_processCount == 0);
         assert(m_jobSet.empty());
+        assert(localCount_ == 0);
         assert(nSuspend_ == 0);
         stopped_ = true;
     }
@@ -341,22 +428,89 @@ JobQueue::finishJob(JobType type)
         assert(data.running + data.waiting >= getJobLimit(type));
 
         --data.deferred;
-        m_workers.addTask();
+        signalShared();
     }
 
     --data.running;
+    updateSharedTop();
+}
+
+bool
+JobQueue::takeJob(Job& job, int instance)
+{
+    std::size_t const own = instance % runQueues_.size();
+    ownerQueue = this;
+    ownerIndex = own;
+
+    for (;;)
+    {
+        // Find the run queue whose first job has the highest priority,
+        // preferring our own on ties.
+        std::size_t from = own;
+        int best = runQueues_[own]->top;
+        for (std::size_t i = 1; i < runQueues_.size(); ++i)
+        {
+            std::size_t const index = (own + i) % runQueues_.size();
+            int const top = runQueues_[index]->top;
+            if (top > best)
+            {
+                best = top;
+                from = index;
+            }
+        }
+
+        if (sharedTop_ > best)
+        {
+            std::lock_guard lock(m_mutex);
+            if (sharedRunnable_ > 0)
+            {
+                --sharedRunnable_;
+                getNextJob(job);
+                ++m_processCount;
+                updateSharedTop();
+                return false;
+            }
+        }
+        else if (best != jtINVALID)
+        {
+            RunQueue& queue = *runQueues_[from];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.extract(queue.jobs.begin()).value());
+                queue.top = queue.jobs.empty()
+                    ? jtINVALID
+                    : queue.jobs.begin()->getType();
+
+                JobTypeData& data(getJobTypeData(job.getType()));
+                --data.waiting;
+                ++data.running;
+                return true;
+            }
+        }
+
+        // Every task that was signaled has a job waiting for it, but another
+        // worker took the one we saw first. Look again.
+        std::this_thread::yield();
+    }
 }
 
 void
 JobQueue::processTask(int instance)
 {
     JobType type;
+    bool fromRunQueue = false;
 
     {
         using namespace std::chrono;
         Job::clock_type::time_point const start_time(Job::clock_type::now());
         {
             Job job;
+            if (workStealing_)
+            {
+                fromRunQueue = takeJob(job, instance);
+            }
+            else
             {
                 std::lock_guard lock(m_mutex);
                 getNextJob(job);
@@ -386,13 +540,27 @@ JobQueue::processTask(int instance)
         }
     }
 
+    if (fromRunQueue)
+    {
+        // Jobs from the run queues have no limit, so there is nothing
+        // deferred to signal.
+        --getJobTypeData(type).running;
+        if (--localCount_ == 0)
+        {
+            std::lock_guard lock(m_mutex);
+            if (idle())
+                cv_.notify_all();
+        }
+        return;
+    }
+
     {
         std::lock_guard lock(m_mutex);
         // Job should be destroyed before stopping
         // otherwise destructors with side effects can access
         // parent objects that are already destroyed.
         finishJob(type);
-        if (--m_processCount == 0 && m_jobSet.empty())
+        if (--m_processCount == 0 && idle())
             cv_.notify_all();
     }
 
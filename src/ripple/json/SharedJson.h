@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_SHAREDJSON_H_INCLUDED
+#define RIPPLE_JSON_SHAREDJSON_H_INCLUDED
+
+#include <ripple/json/MultivarJson.h>
+#include <ripple/json/json_value.h>
+#include <ripple/json/json_writer.h>
+
+#include <array>
+#include <concepts>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace ripple {
+
+/** A JSON message that is sent to many recipients.
+
+    The message is serialized the first time its text is needed, and the
+    immutable result is then shared by every recipient rather than made
+    again for each one.
+
+    The JSON value is referenced, not copied, and must outlive this object.
+    The text is made without synchronization, so a SharedJson must not be
+    used from more than one thread at a time.
+*/
+class SharedJson
+{
+public:
+    explicit SharedJson(Json::Value const& json) : json_(&json)
+    {
+    }
+
+    Json::Value const&
+    json() const
+    {
+        return *json_;
+    }
+
+    /** The compact serialization of the message, made on first use. */
+    std::shared_ptr<std::string const> const&
+    text() const
+    {
+        if (!text_)
+        {
+            auto text = std::make_shared<std::string>();
+            Json::stream(*json_, [&](void const* data, std::size_t n) {
+                text->append(static_cast<char const*>(data), n);
+            });
+            text_ = std::move(text);
+        }
+        return text_;
+    }
+
+private:
+    Json::Value const* json_;
+    mutable std::shared_ptr<std::string const> text_;
+};
+
+/** A SharedJson for each of the values in a MultivarJson. */
+template <std::size_t Size>
+class MultivarSharedJson
+{
+public:
+    explicit MultivarSharedJson(MultivarJson<Size> const& json)
+        : shared_([&]<std::size_t... index>(std::index_sequence<index...>) {
+            return std::array<SharedJson, Size>{SharedJson{json.val[index]}...};
+        }(std::make_index_sequence<Size>{}))
+    {
+    }
+
+    SharedJson const&
+    select(auto&& selector) const
+        requires std::same_as<std::size_t, decltype(selector())>
+    {
+        return shared_[selector()];
+    }
+
+private:
+    std::array<SharedJson, Size> shared_;
+};
+
+using MultiApiSharedJson = MultivarSharedJson<MultiApiJson::size>;
+
+}  // namespace ripple
+
+#endif
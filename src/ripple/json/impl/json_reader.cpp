@@ -21,11 +21,21 @@
 #include <ripple/json/json_reader.h>
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <istream>
 #include <string>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define RIPPLE_JSON_SSE2 1
+#include <emmintrin.h>
+#else
+#define RIPPLE_JSON_SSE2 0
+#endif
+
 namespace Json {
 // Implementation of class Reader
 // ////////////////////////////////
@@ -67,16 +77,485 @@ codePointToUTF8(unsigned int cp)
     return result;
 }
 
+// Plain JSON
+// //////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Returns the first quote or backslash in [p, end), or end.
+const char*
+findQuoteOrEscape(const char* p, const char* end)
+{
+#if RIPPLE_JSON_SSE2
+    auto const quote = _mm_set1_epi8('"');
+    auto const escape = _mm_set1_epi8('\\');
+
+    while (end - p >= 16)
+    {
+        auto const chunk =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        auto const mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, escape)));
+
+        if (mask != 0)
+            return p + std::countr_zero(static_cast<unsigned>(mask));
+
+        p += 16;
+    }
+#endif
+
+    while (p != end && *p != '"' && *p != '\\')
+        ++p;
+
+    return p;
+}
+
+bool
+isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Returns the first character in [p, end) that is not whitespace, or end.
+const char*
+skipSpaces(const char* p, const char* end)
+{
+    // Compact documents have no whitespace at all, so check one character
+    // before looking at a whole block.
+    if (p == end || !isSpace(*p))
+        return p;
+
+#if RIPPLE_JSON_SSE2
+    auto const space = _mm_set1_epi8(' ');
+    auto const tab = _mm_set1_epi8('\t');
+    auto const cr = _mm_set1_epi8('\r');
+    auto const lf = _mm_set1_epi8('\n');
+
+    while (end - p >= 16)
+    {
+        auto const chunk =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        auto const spaces = _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        auto const mask = ~_mm_movemask_epi8(spaces) & 0xffff;
+
+        if (mask != 0)
+            return p + std::countr_zero(static_cast<unsigned>(mask));
+
+        p += 16;
+    }
+#endif
+
+    while (p != end && isSpace(*p))
+        ++p;
+
+    return p;
+}
+
+int
+hexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Parses documents that are plain JSON into exactly the Value the Reader
+// would produce. It gives up, rather than report an error, on anything
+// that isn't: comments, errors, duplicate members, numbers out of range or
+// too deep nesting. The Reader then parses the document the slow way, and
+// either accepts it or explains what is wrong with it.
+class PlainParser
+{
+public:
+    PlainParser(const char* begin, const char* end) : p_(begin), end_(end)
+    {
+    }
+
+    bool
+    parse(Value& root)
+    {
+        p_ = skipSpaces(p_, end_);
+        if (!readValue(root, 0))
+            return false;
+
+        if (!root.isNull() && !root.isArray() && !root.isObject())
+            return false;
+
+        return skipSpaces(p_, end_) == end_;
+    }
+
+private:
+    bool
+    readValue(Value& value, unsigned depth)
+    {
+        if (depth > Reader::nest_limit || p_ == end_)
+            return false;
+
+        switch (*p_)
+        {
+            case '{':
+                return readObject(value, depth);
+
+            case '[':
+                return readArray(value, depth);
+
+            case '"':
+                buffer_.clear();
+                if (!readString(buffer_))
+                    return false;
+                value = buffer_;
+                return true;
+
+            case 't':
+                value = true;
+                return match("true", 4);
+
+            case 'f':
+                value = false;
+                return match("false", 5);
+
+            case 'n':
+                value = Value();
+                return match("null", 4);
+
+            default:
+                return readNumber(value);
+        }
+    }
+
+    bool
+    readObject(Value& value, unsigned depth)
+    {
+        value = Value(objectValue);
+        p_ = skipSpaces(p_ + 1, end_);
+
+        if (p_ != end_ && *p_ == '}')
+        {
+            ++p_;
+            return true;
+        }
+
+        while (true)
+        {
+            if (p_ == end_ || *p_ != '"')
+                return false;
+
+            buffer_.clear();
+            if (!readString(buffer_))
+                return false;
+
+            p_ = skipSpaces(p_, end_);
+            if (p_ == end_ || *p_ != ':')
+                return false;
+
+            p_ = skipSpaces(p_ + 1, end_);
+
+            // Duplicate names are an error
+            auto const size = value.size();
+            Value& member = value[buffer_];
+            if (value.size() == size)
+                return false;
+
+            if (!readValue(member, depth + 1))
+                return false;
+
+            p_ = skipSpaces(p_, end_);
+            if (p_ == end_)
+                return false;
+
+            char const c = *p_++;
+            if (c == '}')
+                return true;
+            if (c != ',')
+                return false;
+
+            p_ = skipSpaces(p_, end_);
+        }
+    }
+
+    bool
+    readArray(Value& value, unsigned depth)
+    {
+        value = Value(arrayValue);
+        p_ = skipSpaces(p_ + 1, end_);
+
+        if (p_ != end_ && *p_ == ']')
+        {
+            ++p_;
+            return true;
+        }
+
+        for (Value::UInt index = 0;; ++index)
+        {
+            if (!readValue(value[index], depth + 1))
+                return false;
+
+            p_ = skipSpaces(p_, end_);
+            if (p_ == end_)
+                return false;
+
+            char const c = *p_++;
+            if (c == ']')
+                return true;
+            if (c != ',')
+                return false;
+
+            p_ = skipSpaces(p_, end_);
+        }
+    }
+
+    // Decodes the string starting at the opening quote, the same way as
+    // Reader::decodeString, appending it to decoded.
+    bool
+    readString(std::string& decoded)
+    {
+        ++p_;
+
+        while (true)
+        {
+            auto const stop = findQuoteOrEscape(p_, end_);
+            decoded.append(p_, stop);
+            p_ = stop;
+
+            if (p_ == end_)
+                return false;
+
+            if (*p_++ == '"')
+                return true;
+
+            if (p_ == end_)
+                return false;
+
+            switch (*p_++)
+            {
+                case '"':
+                    decoded += '"';
+                    break;
+
+                case '/':
+                    decoded += '/';
+                    break;
+
+                case '\\':
+                    decoded += '\\';
+                    break;
+
+                case 'b':
+                    decoded += '\b';
+                    break;
+
+                case 'f':
+                    decoded += '\f';
+                    break;
+
+                case 'n':
+                    decoded += '\n';
+                    break;
+
+                case 'r':
+                    decoded += '\r';
+                    break;
+
+                case 't':
+                    decoded += '\t';
+                    break;
+
+                case 'u': {
+                    unsigned int unicode;
+                    if (!readUnicodeEscape(unicode))
+                        return false;
+
+                    if (unicode >= 0xD800 && unicode <= 0xDBFF)
+                    {
+                        // surrogate pairs
+                        unsigned int surrogatePair;
+                        if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u')
+                            return false;
+
+                        p_ += 2;
+                        if (!readUnicodeEscape(surrogatePair))
+                            return false;
+
+                        unicode = 0x10000 + ((unicode & 0x3FF) << 10) +
+                            (surrogatePair & 0x3FF);
+                    }
+
+                    decoded += codePointToUTF8(unicode);
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+        }
+    }
+
+    bool
+    readUnicodeEscape(unsigned int& unicode)
+    {
+        if (end_ - p_ < 4)
+            return false;
+
+        unicode = 0;
+
+        for (int index = 0; index < 4; ++index)
+        {
+            auto const digit = hexDigit(*p_++);
+            if (digit < 0)
+                return false;
+            unicode = unicode * 16 + digit;
+        }
+
+        return true;
+    }
+
+    // Takes the same characters as Reader::readNumber, and decodes them the
+    // same way as Reader::decodeNumber and Reader::decodeDouble.
+    bool
+    readNumber(Value& value)
+    {
+        auto const start = p_;
+        bool const isNegative = *p_ == '-';
+
+        if (isNegative)
+            ++p_;
+
+        auto const digits = p_;
+        while (p_ != end_ && *p_ >= '0' && *p_ <= '9')
+            ++p_;
+        auto const integerEnd = p_;
+
+        while (p_ != end_ &&
+               ((*p_ >= '0' && *p_ <= '9') || *p_ == '.' || *p_ == 'e' ||
+                *p_ == 'E' || *p_ == '+' || *p_ == '-'))
+            ++p_;
+
+        if (integerEnd == digits)
+            return false;
+
+        if (integerEnd != p_)
+            return readDouble(start, integerEnd, value);
+
+        std::int64_t decoded = 0;
+        for (auto c = digits; c != p_; ++c)
+        {
+            decoded = (decoded * 10) + (*c - '0');
+            if (decoded > Value::maxUInt)
+                return false;
+        }
+
+        if (isNegative)
+        {
+            decoded = -decoded;
+            if (decoded < Value::minInt)
+                return false;
+            value = static_cast<Value::Int>(decoded);
+        }
+        else if (decoded <= Value::maxInt)
+            value = static_cast<Value::Int>(decoded);
+        else
+            value = static_cast<Value::UInt>(decoded);
+
+        return true;
+    }
+
+    // Only numbers that sscanf would consume entirely are taken, so that
+    // strtod produces the same value as the Reader.
+    bool
+    readDouble(const char* start, const char* integerEnd, Value& value)
+    {
+        auto digits = [this](const char* p) {
+            auto const begin = p;
+            while (p != p_ && *p >= '0' && *p <= '9')
+                ++p;
+            return p == begin ? nullptr : p;
+        };
+
+        auto p = integerEnd;
+        if (*p == '.')
+        {
+            p = digits(p + 1);
+            if (!p)
+                return false;
+        }
+
+        if (p != p_ && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            if (p != p_ && (*p == '+' || *p == '-'))
+                ++p;
+            p = digits(p);
+            if (!p)
+                return false;
+        }
+
+        if (p != p_)
+            return false;
+
+        constexpr std::size_t bufferSize = 32;
+        auto const length = static_cast<std::size_t>(p_ - start);
+        if (length <= bufferSize)
+        {
+            char buffer[bufferSize + 1];
+            memcpy(buffer, start, length);
+            buffer[length] = 0;
+            value = std::strtod(buffer, nullptr);
+        }
+        else
+        {
+            std::string const buffer(start, p_);
+            value = std::strtod(buffer.c_str(), nullptr);
+        }
+
+        return true;
+    }
+
+    bool
+    match(const char* literal, std::size_t length)
+    {
+        if (static_cast<std::size_t>(end_ - p_) < length ||
+            memcmp(p_, literal, length) != 0)
+            return false;
+
+        p_ += length;
+        return true;
+    }
+
+    const char* p_;
+    const char* const end_;
+
+    // Holds each string while it is decoded
+    std::string buffer_;
+};
+
+}  // namespace
+
 // Class Reader
 // //////////////////////////////////////////////////////////////////
 
 bool
 Reader::parse(std::string const& document, Value& root)
 {
+    // Plain JSON is parsed in place. The document is only copied when the
+    // full parser needs it to report the locations of errors.
+    if (parsePlain(document.data(), document.data() + document.size(), root))
+    {
+        errors_.clear();
+        return true;
+    }
+
     document_ = document;
     const char* begin = document_.c_str();
     const char* end = begin + document_.length();
-    return parse(begin, end, root);
+    return parseTokens(begin, end, root);
 }
 
 bool
@@ -96,6 +575,29 @@ Reader::parse(std::istream& sin, Value& root)
 
 bool
 Reader::parse(const char* beginDoc, const char* endDoc, Value& root)
+{
+    if (parsePlain(beginDoc, endDoc, root))
+    {
+        errors_.clear();
+        return true;
+    }
+
+    return parseTokens(beginDoc, endDoc, root);
+}
+
+bool
+Reader::parsePlain(Location begin, Location end, Value& root)
+{
+    Value value;
+    if (!PlainParser(begin, end).parse(value))
+        return false;
+
+    root.swap(value);
+    return true;
+}
+
+bool
+Reader::parseTokens(const char* beginDoc, const char* endDoc, Value& root)
 {
     begin_ = beginDoc;
     end_ = endDoc;
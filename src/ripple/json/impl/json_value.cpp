@@ -23,6 +23,9 @@
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 
+#include <tuple>
+#include <new>
+
 namespace Json {
 
 const Value Value::null;
@@ -89,6 +92,133 @@ static struct DummyValueAllocatorInitializer
     }
 } dummyValueAllocatorInitializer;
 
+namespace {
+
+// A thread's cache of the freed blocks of one size.
+//
+// Building a response allocates a node for every member and element, and
+// most of them are freed again once it is sent, so keeping the blocks
+// around saves going through the heap for each of them. The cache itself
+// is trivially destructible, so it can still be used, by falling back to
+// the heap, while the thread's other objects are destroyed.
+template <std::size_t Size>
+class BlockCache
+{
+    struct Block
+    {
+        Block* next;
+    };
+
+    static_assert(Size >= sizeof(Block));
+
+    // The most blocks a thread keeps, so that a thread that frees what
+    // others allocated doesn't keep hold of all of it.
+    static constexpr std::size_t limit = 4096;
+
+    enum class State : unsigned char { unused, live, dead };
+
+    struct Reaper
+    {
+        ~Reaper()
+        {
+            while (head_)
+            {
+                auto const block = head_;
+                head_ = block->next;
+                ::operator delete(block);
+            }
+            count_ = 0;
+            state_ = State::dead;
+        }
+    };
+
+    static thread_local Block* head_;
+    static thread_local std::size_t count_;
+    static thread_local State state_;
+
+    static bool
+    live()
+    {
+        if (state_ == State::unused)
+        {
+            // Frees the cache when the thread exits.
+            thread_local Reaper reaper;
+            state_ = State::live;
+        }
+        return state_ == State::live;
+    }
+
+public:
+    static void*
+    allocate()
+    {
+        if (live() && head_)
+        {
+            auto const block = head_;
+            head_ = block->next;
+            --count_;
+            return block;
+        }
+        return ::operator new(Size);
+    }
+
+    static void
+    deallocate(void* p)
+    {
+        if (!live() || count_ >= limit)
+            return ::operator delete(p);
+        auto const block = static_cast<Block*>(p);
+        block->next = head_;
+        head_ = block;
+        ++count_;
+    }
+};
+
+template <std::size_t Size>
+thread_local typename BlockCache<Size>::Block* BlockCache<Size>::head_ =
+    nullptr;
+
+template <std::size_t Size>
+thread_local std::size_t BlockCache<Size>::count_ = 0;
+
+template <std::size_t Size>
+thread_local typename BlockCache<Size>::State BlockCache<Size>::state_ =
+    BlockCache<Size>::State::unused;
+
+template <class T, class... Args>
+T*
+make(Args&&... args)
+{
+    void* const p = BlockCache<sizeof(T)>::allocate();
+    try
+    {
+        return new (p) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        BlockCache<sizeof(T)>::deallocate(p);
+        throw;
+    }
+}
+
+template <class T>
+void
+destroy(T* p)
+{
+    p->~T();
+    BlockCache<sizeof(T)>::deallocate(p);
+}
+
+// Member names are usually StaticStrings, so equal names are often the
+// same pointer.
+int
+compareNames(const char* x, const char* y)
+{
+    return x == y ? 0 : strcmp(x, y);
+}
+
+}  // namespace
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -123,17 +253,31 @@ Value::CZString::CZString(const CZString& other)
 {
 }
 
+Value::CZString::CZString(CZString&& other) noexcept
+    : cstr_(other.cstr_), index_(other.index_)
+{
+    other.cstr_ = 0;
+}
+
 Value::CZString::~CZString()
 {
     if (cstr_ && index_ == duplicate)
         valueAllocator()->releaseMemberName(const_cast<char*>(cstr_));
 }
 
+Value::CZString&
+Value::CZString::operator=(CZString&& other) noexcept
+{
+    std::swap(cstr_, other.cstr_);
+    std::swap(index_, other.index_);
+    return *this;
+}
+
 bool
 Value::CZString::operator<(const CZString& other) const
 {
     if (cstr_ && other.cstr_)
-        return strcmp(cstr_, other.cstr_) < 0;
+        return compareNames(cstr_, other.cstr_) < 0;
 
     return index_ < other.index_;
 }
@@ -142,7 +286,7 @@ bool
 Value::CZString::operator==(const CZString& other) const
 {
     if (cstr_ && other.cstr_)
-        return strcmp(cstr_, other.cstr_) == 0;
+        return compareNames(cstr_, other.cstr_) == 0;
 
     return index_ == other.index_;
 }
@@ -165,6 +309,89 @@ Value::CZString::isStaticString() const
     return index_ == noDuplication;
 }
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class Value::ObjectValues
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+void*
+Value::allocateNode(std::size_t size)
+{
+    if (size <= 64)
+        return BlockCache<64>::allocate();
+    if (size <= 128)
+        return BlockCache<128>::allocate();
+    return ::operator new(size);
+}
+
+void
+Value::deallocateNode(void* p, std::size_t size) noexcept
+{
+    if (size <= 64)
+        return BlockCache<64>::deallocate(p);
+    if (size <= 128)
+        return BlockCache<128>::deallocate(p);
+    ::operator delete(p);
+}
+
+Value const*
+Value::ObjectValues::find(CZString const& key) const
+{
+    auto const it = map_.find(key);
+    if (it == map_.end())
+        return nullptr;
+    return &it->second;
+}
+
+Value&
+Value::ObjectValues::resolve(CZString const& key)
+{
+    // Appending is the common case, for arrays as well as for objects
+    // written in order.
+    auto hint = map_.end();
+    if (!map_.empty() && !(std::prev(hint)->first < key))
+    {
+        hint = map_.lower_bound(key);
+        if (hint != map_.end() && hint->first == key)
+            return hint->second;
+    }
+
+    return map_
+        .emplace_hint(
+            hint,
+            std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple())
+        ->second;
+}
+
+bool
+Value::ObjectValues::erase(CZString const& key, Value& removed)
+{
+    auto const it = map_.find(key);
+    if (it == map_.end())
+        return false;
+
+    removed = std::move(it->second);
+    map_.erase(it);
+    return true;
+}
+
+bool
+operator==(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return x.map_ == y.map_;
+}
+
+bool
+operator<(Value::ObjectValues const& x, Value::ObjectValues const& y)
+{
+    return x.map_ < y.map_;
+}
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -199,7 +426,7 @@ Value::Value(ValueType type) : type_(type), allocated_(0)
 
         case arrayValue:
         case objectValue:
-            value_.map_ = new ObjectValues();
+            value_.map_ = make<ObjectValues>();
             break;
 
         case booleanValue:
@@ -273,7 +500,7 @@ Value::Value(const Value& other) : type_(other.type_)
 
         case arrayValue:
         case objectValue:
-            value_.map_ = new ObjectValues(*other.value_.map_);
+            value_.map_ = make<ObjectValues>(*other.value_.map_);
             break;
 
         default:
@@ -301,7 +528,7 @@ Value::~Value()
         case arrayValue:
         case objectValue:
             if (value_.map_)
-                delete value_.map_;
+                destroy(value_.map_);
             break;
 
         default:
@@ -717,11 +944,7 @@ Value::size() const
 
         case arrayValue:  // size of the array is highest index + 1
             if (!value_.map_->empty())
-            {
-                ObjectValues::const_iterator itLast = value_.map_->end();
-                --itLast;
-                return (*itLast).first.index() + 1;
-            }
+                return std::prev(value_.map_->end())->first.index() + 1;
 
             return 0;
 
@@ -775,15 +998,7 @@ Value::operator[](UInt index)
     if (type_ == nullValue)
         *this = Value(arrayValue);
 
-    CZString key(index);
-    ObjectValues::iterator it = value_.map_->lower_bound(key);
-
-    if (it != value_.map_->end() && (*it).first == key)
-        return (*it).second;
-
-    ObjectValues::value_type defaultValue(key, null);
-    it = value_.map_->insert(it, defaultValue);
-    return (*it).second;
+    return value_.map_->resolve(CZString(index));
 }
 
 const Value&
@@ -794,13 +1009,8 @@ Value::operator[](UInt index) const
     if (type_ == nullValue)
         return null;
 
-    CZString key(index);
-    ObjectValues::const_iterator it = value_.map_->find(key);
-
-    if (it == value_.map_->end())
-        return null;
-
-    return (*it).second;
+    auto const value = value_.map_->find(CZString(index));
+    return value ? *value : null;
 }
 
 Value&
@@ -819,15 +1029,7 @@ Value::resolveReference(const char* key, bool isStatic)
 
     CZString actualKey(
         key, isStatic ? CZString::noDuplication : CZString::duplicateOnCopy);
-    ObjectValues::iterator it = value_.map_->lower_bound(actualKey);
-
-    if (it != value_.map_->end() && (*it).first == actualKey)
-        return (*it).second;
-
-    ObjectValues::value_type defaultValue(actualKey, null);
-    it = value_.map_->insert(it, defaultValue);
-    Value& value = (*it).second;
-    return value;
+    return value_.map_->resolve(actualKey);
 }
 
 Value
@@ -851,13 +1053,9 @@ Value::operator[](const char* key) const
     if (type_ == nullValue)
         return null;
 
-    CZString actualKey(key, CZString::noDuplication);
-    ObjectValues::const_iterator it = value_.map_->find(actualKey);
-
-    if (it == value_.map_->end())
-        return null;
-
-    return (*it).second;
+    auto const value =
+        value_.map_->find(CZString(key, CZString::noDuplication));
+    return value ? *value : null;
 }
 
 Value&
@@ -911,14 +1109,9 @@ Value::removeMember(const char* key)
     if (type_ == nullValue)
         return null;
 
-    CZString actualKey(key, CZString::noDuplication);
-    ObjectValues::iterator it = value_.map_->find(actualKey);
-
-    if (it == value_.map_->end())
+    Value old;
+    if (!value_.map_->erase(CZString(key, CZString::noDuplication), old))
         return null;
-
-    Value old(it->second);
-    value_.map_->erase(it);
     return old;
 }
 
@@ -958,7 +1151,7 @@ Value::getMemberNames() const
     ObjectValues::const_iterator itEnd = value_.map_->end();
 
     for (; it != itEnd; ++it)
-        members.push_back(std::string((*it).first.c_str()));
+        members.push_back(std::string(it->first.c_str()));
 
     return members;
 }
@@ -72,19 +72,7 @@ ValueIteratorBase::computeDistance(const SelfType& other) const
         return 0;
     }
 
-    // Usage of std::distance is not portable (does not compile with Sun Studio
-    // 12 RogueWave STL, which is the one used by default). Using a portable
-    // hand-made version for non random iterator instead:
-    //   return difference_type( std::distance( current_, other.current_ ) );
-    difference_type myDistance = 0;
-
-    for (Value::ObjectValues::iterator it = current_; it != other.current_;
-         ++it)
-    {
-        ++myDistance;
-    }
-
-    return myDistance;
+    return difference_type(std::distance(current_, other.current_));
 }
 
 bool
@@ -107,7 +95,7 @@ ValueIteratorBase::copy(const SelfType& other)
 Value
 ValueIteratorBase::key() const
 {
-    const Value::CZString czstring = (*current_).first;
+    auto const& czstring = current_->first;
 
     if (czstring.c_str())
     {
@@ -123,7 +111,7 @@ ValueIteratorBase::key() const
 UInt
 ValueIteratorBase::index() const
 {
-    const Value::CZString czstring = (*current_).first;
+    auto const& czstring = current_->first;
 
     if (!czstring.c_str())
         return czstring.index();
@@ -134,7 +122,7 @@ ValueIteratorBase::index() const
 const char*
 ValueIteratorBase::memberName() const
 {
-    const char* name = (*current_).first.c_str();
+    const char* name = current_->first.c_str();
     return name ? name : "";
 }
 
@@ -26,12 +26,23 @@
 #include <ripple/json/json_value.h>
 #include <boost/asio/buffer.hpp>
 #include <stack>
+#include <vector>
+
+namespace ripple {
+class json_reader_test;
+class json_reader_bench_test;
+}  // namespace ripple
 
 namespace Json {
 
 /** \brief Unserialize a <a HREF="http://www.json.org">JSON</a> document into a
  * Value.
  *
+ * Documents that are plain JSON, which is nearly all of them, are parsed by
+ * a fast path that scans strings and whitespace with vector instructions
+ * where they are available. Anything else, including comments, errors and
+ * documents that break a limit, is left to the original tokenizing parser,
+ * so the result and the error messages are the same either way.
  */
 class Reader
 {
@@ -90,6 +101,18 @@ public:
     static constexpr unsigned nest_limit{25};
 
 private:
+    friend class ripple::json_reader_test;
+    friend class ripple::json_reader_bench_test;
+
+    /** Parses a document if it is plain JSON, leaving root unchanged if
+        it is not.
+    */
+    static bool
+    parsePlain(Location begin, Location end, Value& root);
+
+    bool
+    parseTokens(Location begin, Location end, Value& root);
+
     enum TokenType {
         tokenEndOfStream = 0,
         tokenObjectBegin,
@@ -128,7 +151,7 @@ private:
         Location extra_;
     };
 
-    using Errors = std::deque<ErrorInfo>;
+    using Errors = std::vector<ErrorInfo>;
 
     bool
     expectToken(TokenType type, Token& token, const char* message);
@@ -196,7 +219,7 @@ private:
     void
     skipCommentTokens(Token& token);
 
-    using Nodes = std::stack<Value*>;
+    using Nodes = std::stack<Value*, std::vector<Value*>>;
     Nodes nodes_;
     Errors errors_;
     std::string document_;
@@ -23,6 +23,7 @@
 #include <ripple/json/json_forwards.h>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -171,9 +172,12 @@ private:
         CZString(int index);
         CZString(const char* cstr, DuplicationPolicy allocate);
         CZString(const CZString& other);
+        CZString(CZString&& other) noexcept;
         ~CZString();
         CZString&
         operator=(const CZString& other) = delete;
+        CZString&
+        operator=(CZString&& other) noexcept;
         bool
         operator<(const CZString& other) const;
         bool
@@ -190,8 +194,141 @@ private:
         int index_;
     };
 
+    // Hands out the nodes of ObjectValues from small per-thread caches of
+    // freed blocks instead of the heap.
+    static void*
+    allocateNode(std::size_t size);
+
+    static void
+    deallocateNode(void* p, std::size_t size) noexcept;
+
+    template <class T>
+    struct NodeAllocator
+    {
+        using value_type = T;
+
+        NodeAllocator() = default;
+
+        template <class U>
+        NodeAllocator(NodeAllocator<U> const&) noexcept
+        {
+        }
+
+        T*
+        allocate(std::size_t n)
+        {
+            if (n != 1)
+                return std::allocator<T>().allocate(n);
+            return static_cast<T*>(allocateNode(sizeof(T)));
+        }
+
+        void
+        deallocate(T* p, std::size_t n) noexcept
+        {
+            if (n != 1)
+                return std::allocator<T>().deallocate(p, n);
+            deallocateNode(p, sizeof(T));
+        }
+
+        template <class U>
+        bool
+        operator==(NodeAllocator<U> const&) const noexcept
+        {
+            return true;
+        }
+
+        template <class U>
+        bool
+        operator!=(NodeAllocator<U> const&) const noexcept
+        {
+            return false;
+        }
+    };
+
 public:
-    using ObjectValues = std::map<CZString, Value>;
+    /** The members of an object, or the elements of an array.
+
+        This is an ordered map, so adding or removing a member is
+        logarithmic in the size of the object however the members arrive,
+        and doesn't invalidate iterators to the others. Its nodes come from
+        per-thread caches, since most JSON is built and thrown away in
+        quick succession.
+    */
+    class ObjectValues
+    {
+        using Map = std::map<
+            CZString,
+            Value,
+            std::less<CZString>,
+            NodeAllocator<std::pair<CZString const, Value>>>;
+
+    public:
+        using iterator = Map::iterator;
+        using const_iterator = Map::const_iterator;
+
+        std::size_t
+        size() const
+        {
+            return map_.size();
+        }
+
+        bool
+        empty() const
+        {
+            return map_.empty();
+        }
+
+        iterator
+        begin()
+        {
+            return map_.begin();
+        }
+
+        iterator
+        end()
+        {
+            return map_.end();
+        }
+
+        const_iterator
+        begin() const
+        {
+            return map_.begin();
+        }
+
+        const_iterator
+        end() const
+        {
+            return map_.end();
+        }
+
+        void
+        clear()
+        {
+            map_.clear();
+        }
+
+        /** Returns the value with a key, or nullptr if there is none. */
+        Value const*
+        find(CZString const& key) const;
+
+        /** Returns the value with a key, adding a null value if needed. */
+        Value&
+        resolve(CZString const& key);
+
+        /** Removes the value with a key, returning whether there was one. */
+        bool
+        erase(CZString const& key, Value& removed);
+
+        friend bool
+        operator==(ObjectValues const& x, ObjectValues const& y);
+
+        friend bool
+        operator<(ObjectValues const& x, ObjectValues const& y);
+
+    private:
+        Map map_;
+    };
 
 public:
     /** \brief Create a default Value of the given type.
@@ -25,7 +25,16 @@
 #include <ripple/protocol/STLedgerEntry.h>
 
 namespace ripple {
-using CachedSLEs = TaggedCache<uint256, SLE const>;
+// Looked up from many threads while applying transactions, so each
+// partition gets its own lock.
+using CachedSLEs = TaggedCache<
+    uint256,
+    SLE const,
+    /*IsKeyCache*/ false,
+    hardened_hash<>,
+    std::equal_to<uint256>,
+    std::recursive_mutex,
+    /*PartitionLocks*/ true>;
 }
 
 #endif  // RIPPLE_LEDGER_CACHEDSLES_H_INCLUDED
@@ -29,6 +29,7 @@
 #include <boost/container/pmr/polymorphic_allocator.hpp>
 
 #include <functional>
+#include <map>
 #include <utility>
 
 namespace ripple {
@@ -46,6 +47,19 @@ struct open_ledger_t
 
 extern open_ledger_t const open_ledger;
 
+/** Single transaction construction tag.
+
+    Views constructed with this tag expect to hold the
+    changes of a single transaction, so they start out
+    with a small buffer for them.
+*/
+struct single_tx_t
+{
+    explicit single_tx_t() = default;
+};
+
+extern single_tx_t const single_tx;
+
 //------------------------------------------------------------------------------
 
 /** Writable ledger view that accumulates state and tx changes.
@@ -60,6 +74,9 @@ private:
     // It is unclear how the size initially chosen in qalloc.
     static constexpr size_t initialBufferSize = kilobytes(256);
 
+    // Initial size of the buffer for views of a single transaction.
+    static constexpr size_t singleTxBufferSize = kilobytes(1);
+
     class txs_iter_impl;
 
     struct txData
@@ -170,6 +187,13 @@ public:
     */
     OpenView(ReadView const* base, std::shared_ptr<void const> hold = nullptr);
 
+    /** Construct a view to apply a single transaction to.
+
+        Like the constructor above, but starts with a small
+        buffer, since the view holds a single transaction.
+    */
+    OpenView(single_tx_t, ReadView const* base);
+
     /** Returns true if this reflects an open ledger. */
     bool
     open() const override
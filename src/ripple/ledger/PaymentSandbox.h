@@ -20,11 +20,15 @@
 #ifndef RIPPLE_LEDGER_PAYMENTSANDBOX_H_INCLUDED
 #define RIPPLE_LEDGER_PAYMENTSANDBOX_H_INCLUDED
 
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/Sandbox.h>
 #include <ripple/ledger/detail/ApplyViewBase.h>
 #include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Book.h>
+#include <ripple/protocol/Quality.h>
 #include <map>
+#include <optional>
 #include <utility>
 
 namespace ripple {
@@ -178,6 +182,52 @@ public:
     ownerCountHook(AccountID const& account, std::uint32_t count)
         const override;
 
+    // Every change to the ledger entries in this view goes through one of
+    // these, so that the remembered book tips are forgotten.
+    /** @{ */
+    std::shared_ptr<SLE>
+    peek(Keylet const& k) override;
+
+    void
+    erase(std::shared_ptr<SLE> const& sle) override;
+
+    void
+    insert(std::shared_ptr<SLE> const& sle) override;
+
+    void
+    update(std::shared_ptr<SLE> const& sle) override;
+
+    void
+    rawErase(std::shared_ptr<SLE> const& sle) override;
+
+    void
+    rawInsert(std::shared_ptr<SLE> const& sle) override;
+
+    void
+    rawReplace(std::shared_ptr<SLE> const& sle) override;
+    /** @} */
+
+    /** Return the quality of the best offer in an order book.
+
+        The quality is computed by calling `f` the first time a book is
+        asked for, and is remembered until the ledger entries in this view
+        next change. The strands of a payment are ranked against the same
+        view and often share books, so this saves walking the same book
+        directories over and over.
+
+        `f` must compute the quality from the contents of this view alone.
+    */
+    template <class F>
+    std::optional<Quality>
+    bookTipQuality(Book const& book, F&& f) const
+    {
+        if (auto const it = bookTips_.find(book); it != bookTips_.end())
+            return it->second;
+        auto const quality = f();
+        bookTips_.emplace(book, quality);
+        return quality;
+    }
+
     /** Apply changes to base view.
 
         `to` must contain contents identical to the parent
@@ -205,6 +255,7 @@ public:
 private:
     detail::DeferredCredits tab_;
     PaymentSandbox const* ps_ = nullptr;
+    mutable hash_map<Book, std::optional<Quality>> bookTips_;
 };
 
 }  // namespace ripple
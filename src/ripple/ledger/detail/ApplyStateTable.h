@@ -25,6 +25,7 @@
 #include <ripple/ledger/OpenView.h>
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
+#include <ripple/ledger/detail/KeyedTable.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/TxMeta.h>
 #include <memory>
@@ -46,7 +47,7 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+    using items_t = KeyedTable<std::pair<Action, std::shared_ptr<SLE>>>;
 
     items_t items_;
     XRPAmount dropsDestroyed_{0};
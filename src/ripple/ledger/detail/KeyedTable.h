@@ -0,0 +1,394 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_KEYEDTABLE_H_INCLUDED
+#define RIPPLE_LEDGER_KEYEDTABLE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** A table of items by ledger key, for the state tables of views.
+
+    Items are kept in a flat array in the order they were added, with an
+    open addressing hash index, so that finding, adding and changing an
+    item takes no ordered comparisons and no allocation of its own. The
+    order of the keys is only worked out when the table is iterated or
+    searched for a successor, and then only for the items added since the
+    last time.
+
+    Like a view, a table may be read by several threads at once, but not
+    while it is being changed. Any change invalidates iterators.
+*/
+template <class T>
+class KeyedTable
+{
+public:
+    using key_type = uint256;
+    using value_type = std::pair<key_type, T>;
+
+private:
+    // Items in the order they were added. Erased items are left empty
+    // until the table is compacted.
+    std::vector<std::optional<value_type>> items_;
+
+    // The hash index: one more than the position of an item, or zero.
+    std::vector<std::uint32_t> slots_;
+
+    std::size_t size_ = 0;
+
+    // The positions of the items in key order. It holds the items added
+    // before sortedCount_, and may hold erased ones while erased_ is set.
+    mutable std::vector<std::uint32_t> order_;
+    mutable std::size_t sortedCount_ = 0;
+    mutable bool erased_ = false;
+    mutable std::atomic<bool> sorted_{true};
+    mutable std::mutex sortMutex_;
+
+public:
+    class const_iterator
+    {
+        KeyedTable const* table_ = nullptr;
+        std::vector<std::uint32_t>::const_iterator iter_;
+
+        friend class KeyedTable;
+
+        const_iterator(
+            KeyedTable const* table,
+            std::vector<std::uint32_t>::const_iterator iter)
+            : table_(table), iter_(iter)
+        {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = KeyedTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        const_iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return *table_->items_[*iter_];
+        }
+
+        pointer
+        operator->() const
+        {
+            return &**this;
+        }
+
+        const_iterator&
+        operator++()
+        {
+            ++iter_;
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+            auto const prev = *this;
+            ++iter_;
+            return prev;
+        }
+
+        friend bool
+        operator==(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return lhs.iter_ == rhs.iter_;
+        }
+
+        friend bool
+        operator!=(const_iterator const& lhs, const_iterator const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    KeyedTable() = default;
+
+    KeyedTable(KeyedTable const& other)
+        : items_(other.items_), slots_(other.slots_), size_(other.size_)
+    {
+        // Another thread may be sorting the other table while reading it.
+        std::lock_guard lock(other.sortMutex_);
+        order_ = other.order_;
+        sortedCount_ = other.sortedCount_;
+        erased_ = other.erased_;
+        sorted_ = other.sorted_.load();
+    }
+
+    KeyedTable(KeyedTable&& other)
+        : items_(std::move(other.items_))
+        , slots_(std::move(other.slots_))
+        , size_(other.size_)
+        , order_(std::move(other.order_))
+        , sortedCount_(other.sortedCount_)
+        , erased_(other.erased_)
+        , sorted_(other.sorted_.load())
+    {
+        other.size_ = 0;
+        other.sortedCount_ = 0;
+        other.sorted_ = true;
+    }
+
+    KeyedTable&
+    operator=(KeyedTable const&) = delete;
+    KeyedTable&
+    operator=(KeyedTable&&) = delete;
+
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    /** Returns the item with a key, or nullptr. */
+    T*
+    find(key_type const& key)
+    {
+        auto const slot = findSlot(key);
+        if (!slot)
+            return nullptr;
+        return &items_[slots_[*slot] - 1]->second;
+    }
+
+    T const*
+    find(key_type const& key) const
+    {
+        return const_cast<KeyedTable&>(*this).find(key);
+    }
+
+    /** Adds an item constructed from `args` unless the key is present.
+
+        @return The item with the key, and whether it was added.
+    */
+    template <class... Args>
+    std::pair<T*, bool>
+    emplace(key_type const& key, Args&&... args)
+    {
+        if ((size_ + 1) * 2 > slots_.size())
+            rehash(std::max<std::size_t>(16, slots_.size() * 2));
+
+        auto const mask = slots_.size() - 1;
+        auto slot = hash(key) & mask;
+        for (; slots_[slot] != 0; slot = (slot + 1) & mask)
+        {
+            auto& item = *items_[slots_[slot] - 1];
+            if (item.first == key)
+                return {&item.second, false};
+        }
+
+        items_.emplace_back(
+            std::in_place,
+            std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        slots_[slot] = static_cast<std::uint32_t>(items_.size());
+        ++size_;
+        sorted_.store(false, std::memory_order_relaxed);
+        return {&items_.back()->second, true};
+    }
+
+    /** Removes the item with a key, if there is one. */
+    void
+    erase(key_type const& key)
+    {
+        auto const slot = findSlot(key);
+        if (!slot)
+            return;
+
+        items_[slots_[*slot] - 1].reset();
+        --size_;
+        erased_ = true;
+        sorted_.store(false, std::memory_order_relaxed);
+
+        // Shift back the items after the hole that may move into it, so
+        // that no probe sequence is broken.
+        auto const mask = slots_.size() - 1;
+        auto hole = *slot;
+        for (auto next = (hole + 1) & mask; slots_[next] != 0;
+             next = (next + 1) & mask)
+        {
+            auto const home = hash(items_[slots_[next] - 1]->first) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+        }
+        slots_[hole] = 0;
+
+        if (items_.size() > 64 && items_.size() > 2 * size_)
+            compact();
+    }
+
+    /** Iteration in key order. */
+    const_iterator
+    begin() const
+    {
+        sort();
+        return {this, order_.begin()};
+    }
+
+    const_iterator
+    end() const
+    {
+        sort();
+        return {this, order_.end()};
+    }
+
+    /** Returns the first item with a key greater than `key`. */
+    const_iterator
+    upper_bound(key_type const& key) const
+    {
+        sort();
+        return {
+            this,
+            std::upper_bound(
+                order_.begin(),
+                order_.end(),
+                key,
+                [this](key_type const& k, std::uint32_t i) {
+                    return k < items_[i]->first;
+                })};
+    }
+
+private:
+    static std::size_t
+    hash(key_type const& key)
+    {
+        static hardened_hash<> const hasher;
+        return hasher(key);
+    }
+
+    std::optional<std::size_t>
+    findSlot(key_type const& key) const
+    {
+        if (slots_.empty())
+            return std::nullopt;
+
+        auto const mask = slots_.size() - 1;
+        for (auto slot = hash(key) & mask; slots_[slot] != 0;
+             slot = (slot + 1) & mask)
+        {
+            if (items_[slots_[slot] - 1]->first == key)
+                return slot;
+        }
+        return std::nullopt;
+    }
+
+    void
+    rehash(std::size_t capacity)
+    {
+        slots_.assign(capacity, 0);
+        auto const mask = capacity - 1;
+        for (std::size_t i = 0; i < items_.size(); ++i)
+        {
+            if (!items_[i])
+                continue;
+            auto slot = hash(items_[i]->first) & mask;
+            while (slots_[slot] != 0)
+                slot = (slot + 1) & mask;
+            slots_[slot] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+
+    // Drop the erased items
+    void
+    compact()
+    {
+        items_.erase(
+            std::remove_if(
+                items_.begin(),
+                items_.end(),
+                [](auto const& item) { return !item; }),
+            items_.end());
+        rehash(slots_.size());
+        order_.clear();
+        sortedCount_ = 0;
+        erased_ = false;
+    }
+
+    // Bring the key order up to date
+    void
+    sort() const
+    {
+        if (sorted_.load(std::memory_order_acquire))
+            return;
+
+        std::lock_guard lock(sortMutex_);
+        if (sorted_.load(std::memory_order_relaxed))
+            return;
+
+        if (erased_)
+        {
+            order_.erase(
+                std::remove_if(
+                    order_.begin(),
+                    order_.end(),
+                    [this](std::uint32_t i) { return !items_[i]; }),
+                order_.end());
+            erased_ = false;
+        }
+
+        auto const less = [this](std::uint32_t a, std::uint32_t b) {
+            return items_[a]->first < items_[b]->first;
+        };
+        auto const sorted = order_.size();
+        for (auto i = sortedCount_; i < items_.size(); ++i)
+        {
+            if (items_[i])
+                order_.push_back(static_cast<std::uint32_t>(i));
+        }
+        std::sort(order_.begin() + sorted, order_.end(), less);
+        std::inplace_merge(
+            order_.begin(), order_.begin() + sorted, order_.end(), less);
+        sortedCount_ = items_.size();
+
+        sorted_.store(true, std::memory_order_release);
+    }
+};
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
@@ -22,11 +22,8 @@
 
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
+#include <ripple/ledger/detail/KeyedTable.h>
 
-#include <boost/container/pmr/monotonic_buffer_resource.hpp>
-#include <boost/container/pmr/polymorphic_allocator.hpp>
-
-#include <map>
 #include <utility>
 
 namespace ripple {
@@ -37,24 +34,9 @@ class RawStateTable
 {
 public:
     using key_type = ReadView::key_type;
-    // Initial size for the monotonic_buffer_resource used for allocations
-    // The size was chosen from the old `qalloc` code (which this replaces).
-    // It is unclear how the size initially chosen in qalloc.
-    static constexpr size_t initialBufferSize = kilobytes(256);
-
-    RawStateTable()
-        : monotonic_resource_{std::make_unique<
-              boost::container::pmr::monotonic_buffer_resource>(
-              initialBufferSize)}
-        , items_{monotonic_resource_.get()} {};
-
-    RawStateTable(RawStateTable const& rhs)
-        : monotonic_resource_{std::make_unique<
-              boost::container::pmr::monotonic_buffer_resource>(
-              initialBufferSize)}
-        , items_{rhs.items_, monotonic_resource_.get()}
-        , dropsDestroyed_{rhs.dropsDestroyed_} {};
 
+    RawStateTable() = default;
+    RawStateTable(RawStateTable const&) = default;
     RawStateTable(RawStateTable&&) = default;
 
     RawStateTable&
@@ -112,25 +94,14 @@ private:
         Action action;
         std::shared_ptr<SLE> sle;
 
-        // Constructor needed for emplacement in std::map
+        // Constructor needed for emplacement in the table
         sleAction(Action action_, std::shared_ptr<SLE> const& sle_)
             : action(action_), sle(sle_)
         {
         }
     };
 
-    // Use boost::pmr functionality instead of the std::pmr
-    // functions b/c clang does not support pmr yet (as-of 9/2020)
-    using items_t = std::map<
-        key_type,
-        sleAction,
-        std::less<key_type>,
-        boost::container::pmr::polymorphic_allocator<
-            std::pair<const key_type, sleAction>>>;
-    // monotonic_resource_ must outlive `items_`. Make a pointer so it may be
-    // easily moved.
-    std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>
-        monotonic_resource_;
+    using items_t = KeyedTable<sleAction>;
     items_t items_;
 
     XRPAmount dropsDestroyed_{0};
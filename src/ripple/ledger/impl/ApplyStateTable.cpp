@@ -267,10 +267,10 @@ ApplyStateTable::apply(
 bool
 ApplyStateTable::exists(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const found = items_.find(k.key);
+    if (!found)
         return base.exists(k);
-    auto const& item = iter->second;
+    auto const& item = *found;
     auto const& sle = item.second;
     switch (item.first)
     {
@@ -293,7 +293,7 @@ ApplyStateTable::succ(
     std::optional<key_type> const& last) const -> std::optional<key_type>
 {
     std::optional<key_type> next = key;
-    items_t::const_iterator iter;
+    std::pair<Action, std::shared_ptr<SLE>> const* found;
     // Find base successor that is
     // not also deleted in our list
     do
@@ -301,10 +301,10 @@ ApplyStateTable::succ(
         next = base.succ(*next, last);
         if (!next)
             break;
-        iter = items_.find(*next);
-    } while (iter != items_.end() && iter->second.first == Action::erase);
+        found = items_.find(*next);
+    } while (found && found->first == Action::erase);
     // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key); iter != items_.end(); ++iter)
+    for (auto iter = items_.upper_bound(key); iter != items_.end(); ++iter)
     {
         if (iter->second.first != Action::erase)
         {
@@ -324,10 +324,10 @@ ApplyStateTable::succ(
 std::shared_ptr<SLE const>
 ApplyStateTable::read(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const found = items_.find(k.key);
+    if (!found)
         return base.read(k);
-    auto const& item = iter->second;
+    auto const& item = *found;
     auto const& sle = item.second;
     switch (item.first)
     {
@@ -346,22 +346,18 @@ ApplyStateTable::read(ReadView const& base, Keylet const& k) const
 std::shared_ptr<SLE>
 ApplyStateTable::peek(ReadView const& base, Keylet const& k)
 {
-    auto iter = items_.lower_bound(k.key);
-    if (iter == items_.end() || iter->first != k.key)
+    auto const found = items_.find(k.key);
+    if (!found)
     {
         auto const sle = base.read(k);
         if (!sle)
             return nullptr;
         // Make our own copy
-        using namespace std;
-        iter = items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::cache, make_shared<SLE>(*sle)));
-        return iter->second.second;
+        auto const result = items_.emplace(
+            sle->key(), Action::cache, std::make_shared<SLE>(*sle));
+        return result.first->second;
     }
-    auto const& item = iter->second;
+    auto const& item = *found;
     auto const& sle = item.second;
     switch (item.first)
     {
@@ -380,10 +376,10 @@ ApplyStateTable::peek(ReadView const& base, Keylet const& k)
 void
 ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto const found = items_.find(sle->key());
+    if (!found)
         LogicError("ApplyStateTable::erase: missing key");
-    auto& item = iter->second;
+    auto& item = *found;
     if (item.second != sle)
         LogicError("ApplyStateTable::erase: unknown SLE");
     switch (item.first)
@@ -392,7 +388,7 @@ ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
             LogicError("ApplyStateTable::erase: double erase");
             break;
         case Action::insert:
-            items_.erase(iter);
+            items_.erase(sle->key());
             break;
         case Action::cache:
         case Action::modify:
@@ -404,21 +400,17 @@ ApplyStateTable::erase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    using namespace std;
-    auto const result = items_.emplace(
-        piecewise_construct,
-        forward_as_tuple(sle->key()),
-        forward_as_tuple(Action::erase, sle));
+    auto const result = items_.emplace(sle->key(), Action::erase, sle);
     if (result.second)
         return;
-    auto& item = result.first->second;
+    auto& item = *result.first;
     switch (item.first)
     {
         case Action::erase:
             LogicError("ApplyStateTable::rawErase: double erase");
             break;
         case Action::insert:
-            items_.erase(result.first);
+            items_.erase(sle->key());
             break;
         case Action::cache:
         case Action::modify:
@@ -431,18 +423,10 @@ ApplyStateTable::rawErase(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::insert, sle));
+    auto const result = items_.emplace(sle->key(), Action::insert, sle);
+    if (result.second)
         return;
-    }
-    auto& item = iter->second;
+    auto& item = *result.first;
     switch (item.first)
     {
         case Action::cache:
@@ -461,18 +445,10 @@ ApplyStateTable::insert(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::replace(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.lower_bound(sle->key());
-    if (iter == items_.end() || iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(
-            iter,
-            piecewise_construct,
-            forward_as_tuple(sle->key()),
-            forward_as_tuple(Action::modify, sle));
+    auto const result = items_.emplace(sle->key(), Action::modify, sle);
+    if (result.second)
         return;
-    }
-    auto& item = iter->second;
+    auto& item = *result.first;
     switch (item.first)
     {
         case Action::erase:
@@ -490,10 +466,10 @@ ApplyStateTable::replace(ReadView const& base, std::shared_ptr<SLE> const& sle)
 void
 ApplyStateTable::update(ReadView const& base, std::shared_ptr<SLE> const& sle)
 {
-    auto const iter = items_.find(sle->key());
-    if (iter == items_.end())
+    auto const found = items_.find(sle->key());
+    if (!found)
         LogicError("ApplyStateTable::update: missing key");
-    auto& item = iter->second;
+    auto& item = *found;
     if (item.second != sle)
         LogicError("ApplyStateTable::update: unknown SLE");
     switch (item.first)
@@ -560,10 +536,9 @@ ApplyStateTable::getForMod(
         }
     }
     {
-        auto iter = items_.find(key);
-        if (iter != items_.end())
+        if (auto const found = items_.find(key))
         {
-            auto const& item = iter->second;
+            auto const& item = *found;
             if (item.first == Action::erase)
             {
                 // The Destination of an Escrow or a PayChannel may have been
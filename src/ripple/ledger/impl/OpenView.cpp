@@ -23,6 +23,7 @@
 namespace ripple {
 
 open_ledger_t const open_ledger{};
+single_tx_t const single_tx{};
 
 class OpenView::txs_iter_impl : public txs_type::iter_base
 {
@@ -120,6 +121,18 @@ OpenView::OpenView(ReadView const* base, std::shared_ptr<void const> hold)
 {
 }
 
+OpenView::OpenView(single_tx_t, ReadView const* base)
+    : monotonic_resource_{std::make_unique<
+          boost::container::pmr::monotonic_buffer_resource>(
+          singleTxBufferSize)}
+    , txs_{monotonic_resource_.get()}
+    , rules_(base->rules())
+    , info_(base->info())
+    , base_(base)
+    , open_(base->open())
+{
+}
+
 std::size_t
 OpenView::txCount() const
 {
@@ -250,6 +250,56 @@ PaymentSandbox::adjustOwnerCountHook(
     tab_.ownerCount(account, cur, next);
 }
 
+std::shared_ptr<SLE>
+PaymentSandbox::peek(Keylet const& k)
+{
+    // The caller may modify the entry
+    bookTips_.clear();
+    return ApplyViewBase::peek(k);
+}
+
+void
+PaymentSandbox::erase(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::erase(sle);
+}
+
+void
+PaymentSandbox::insert(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::insert(sle);
+}
+
+void
+PaymentSandbox::update(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::update(sle);
+}
+
+void
+PaymentSandbox::rawErase(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::rawErase(sle);
+}
+
+void
+PaymentSandbox::rawInsert(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::rawInsert(sle);
+}
+
+void
+PaymentSandbox::rawReplace(std::shared_ptr<SLE> const& sle)
+{
+    bookTips_.clear();
+    ApplyViewBase::rawReplace(sle);
+}
+
 void
 PaymentSandbox::apply(RawView& to)
 {
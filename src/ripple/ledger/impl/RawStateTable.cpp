@@ -180,10 +180,10 @@ bool
 RawStateTable::exists(ReadView const& base, Keylet const& k) const
 {
     assert(k.key.isNonZero());
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const found = items_.find(k.key);
+    if (!found)
         return base.exists(k);
-    auto const& item = iter->second;
+    auto const& item = *found;
     if (item.action == Action::erase)
         return false;
     if (!k.check(*item.sle))
@@ -202,7 +202,7 @@ RawStateTable::succ(
     std::optional<key_type> const& last) const -> std::optional<key_type>
 {
     std::optional<key_type> next = key;
-    items_t::const_iterator iter;
+    sleAction const* found;
     // Find base successor that is
     // not also deleted in our list
     do
@@ -210,10 +210,10 @@ RawStateTable::succ(
         next = base.succ(*next, last);
         if (!next)
             break;
-        iter = items_.find(*next);
-    } while (iter != items_.end() && iter->second.action == Action::erase);
+        found = items_.find(*next);
+    } while (found && found->action == Action::erase);
     // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key); iter != items_.end(); ++iter)
+    for (auto iter = items_.upper_bound(key); iter != items_.end(); ++iter)
     {
         if (iter->second.action != Action::erase)
         {
@@ -234,20 +234,17 @@ void
 RawStateTable::erase(std::shared_ptr<SLE> const& sle)
 {
     // The base invariant is checked during apply
-    auto const result = items_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(sle->key()),
-        std::forward_as_tuple(Action::erase, sle));
+    auto const result = items_.emplace(sle->key(), Action::erase, sle);
     if (result.second)
         return;
-    auto& item = result.first->second;
+    auto& item = *result.first;
     switch (item.action)
     {
         case Action::erase:
             LogicError("RawStateTable::erase: already erased");
             break;
         case Action::insert:
-            items_.erase(result.first);
+            items_.erase(sle->key());
             break;
         case Action::replace:
             item.action = Action::erase;
@@ -259,13 +256,10 @@ RawStateTable::erase(std::shared_ptr<SLE> const& sle)
 void
 RawStateTable::insert(std::shared_ptr<SLE> const& sle)
 {
-    auto const result = items_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(sle->key()),
-        std::forward_as_tuple(Action::insert, sle));
+    auto const result = items_.emplace(sle->key(), Action::insert, sle);
     if (result.second)
         return;
-    auto& item = result.first->second;
+    auto& item = *result.first;
     switch (item.action)
     {
         case Action::erase:
@@ -284,13 +278,10 @@ RawStateTable::insert(std::shared_ptr<SLE> const& sle)
 void
 RawStateTable::replace(std::shared_ptr<SLE> const& sle)
 {
-    auto const result = items_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(sle->key()),
-        std::forward_as_tuple(Action::replace, sle));
+    auto const result = items_.emplace(sle->key(), Action::replace, sle);
     if (result.second)
         return;
-    auto& item = result.first->second;
+    auto& item = *result.first;
     switch (item.action)
     {
         case Action::erase:
@@ -306,10 +297,10 @@ RawStateTable::replace(std::shared_ptr<SLE> const& sle)
 std::shared_ptr<SLE const>
 RawStateTable::read(ReadView const& base, Keylet const& k) const
 {
-    auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    auto const found = items_.find(k.key);
+    if (!found)
         return base.read(k);
-    auto const& item = iter->second;
+    auto const& item = *found;
     if (item.action == Action::erase)
         return nullptr;
     // Convert to SLE const
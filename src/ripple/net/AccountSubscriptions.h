@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_ACCOUNTSUBSCRIPTIONS_H_INCLUDED
+#define RIPPLE_NET_ACCOUNTSUBSCRIPTIONS_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/net/InfoSub.h>
+#include <ripple/protocol/AccountID.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace ripple {
+
+/** The subscribers to the transactions that affect each account.
+
+    The index is split by account into shards with a lock each, so that
+    the subscribers to the accounts affected by different transactions can
+    be looked up in parallel, without contending with clients subscribing
+    and unsubscribing.
+*/
+class AccountSubscriptions
+{
+public:
+    void
+    insert(AccountID const& account, InfoSub::ref subscriber);
+
+    void
+    erase(AccountID const& account, std::uint64_t seq);
+
+    /** Whether no account has any subscribers. */
+    bool
+    empty() const
+    {
+        return accounts_.load(std::memory_order_relaxed) == 0;
+    }
+
+    /** Add the subscribers to an account to a set.
+
+        Subscribers that have gone away are forgotten.
+
+        @return The number of subscribers to the account.
+    */
+    std::size_t
+    collect(AccountID const& account, hash_set<InfoSub::pointer>& subscribers);
+
+private:
+    static constexpr std::size_t shardCount = 32;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        hash_map<AccountID, hash_map<std::uint64_t, InfoSub::wptr>> accounts;
+    };
+
+    Shard&
+    shard(AccountID const& account)
+    {
+        return shards_[shardIndex(account, shardCount)];
+    }
+
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::size_t> accounts_{0};
+};
+
+}  // namespace ripple
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/basics/CountedObject.h>
+#include <ripple/json/SharedJson.h>
 #include <ripple/json/json_value.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -201,6 +202,17 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message that is also being sent to other subscribers.
+
+        By default this sends the JSON value. Subscribers that send the
+        message as text override it to send the text shared by all.
+    */
+    virtual void
+    send(SharedJson const& msg, bool broadcast)
+    {
+        send(msg.json(), broadcast);
+    }
+
     std::uint64_t
     getSeq();
 
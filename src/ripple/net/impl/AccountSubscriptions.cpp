@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/net/AccountSubscriptions.h>
+
+namespace ripple {
+
+void
+AccountSubscriptions::insert(AccountID const& account, InfoSub::ref subscriber)
+{
+    auto& s = shard(account);
+    std::lock_guard lock(s.mutex);
+    auto [it, inserted] = s.accounts.try_emplace(account);
+    it->second[subscriber->getSeq()] = subscriber;
+    if (inserted)
+        ++accounts_;
+}
+
+void
+AccountSubscriptions::erase(AccountID const& account, std::uint64_t seq)
+{
+    auto& s = shard(account);
+    std::lock_guard lock(s.mutex);
+    if (auto it = s.accounts.find(account); it != s.accounts.end())
+    {
+        it->second.erase(seq);
+        if (it->second.empty())
+        {
+            s.accounts.erase(it);
+            --accounts_;
+        }
+    }
+}
+
+std::size_t
+AccountSubscriptions::collect(
+    AccountID const& account,
+    hash_set<InfoSub::pointer>& subscribers)
+{
+    auto& s = shard(account);
+    std::lock_guard lock(s.mutex);
+    auto const found = s.accounts.find(account);
+    if (found == s.accounts.end())
+        return 0;
+
+    std::size_t count = 0;
+    auto& subs = found->second;
+    for (auto it = subs.begin(); it != subs.end();)
+    {
+        if (auto p = it->second.lock())
+        {
+            subscribers.insert(std::move(p));
+            ++count;
+            ++it;
+        }
+        else
+            it = subs.erase(it);
+    }
+    return count;
+}
+
+}  // namespace ripple
@@ -120,7 +120,12 @@ public:
     virtual Status
     fetch(void const* key, std::shared_ptr<NodeObject>* pObject) = 0;
 
-    /** Fetch a batch synchronously. */
+    /** Fetch a batch synchronously.
+
+        The asynchronous read threads of a database fetch the requests they
+        collect with this, so a backend able to have many reads in flight
+        at once should issue them together here.
+    */
     virtual std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
     fetchBatch(std::vector<uint256 const*> const& hashes) = 0;
 
@@ -141,8 +141,7 @@ public:
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t ledgerSeq = 0,
-        FetchType fetchType = FetchType::synchronous,
-        bool duplicate = false);
+        FetchType fetchType = FetchType::synchronous);
 
     /** Fetch an object without waiting.
         If I/O is required to determine whether or not the object is present,
@@ -379,8 +378,31 @@ private:
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t ledgerSeq,
-        FetchReport& fetchReport,
-        bool duplicate) = 0;
+        FetchReport& fetchReport) = 0;
+
+    /** Fetch the objects of a bundle of asynchronous reads.
+
+        The default fetches them one at a time. A database whose backend
+        can read many objects at once overrides this so that the reads are
+        coalesced into a single backend call.
+
+        @param hashes The keys of the objects to retrieve.
+        @param ledgerSeq A ledger sequence served by the same database as
+                         every object in the bundle.
+        @return The objects in the same order, or nullptr for those that
+                could not be retrieved.
+    */
+    virtual std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t ledgerSeq,
+        FetchReport& fetchReport);
+
+    // Perform a bundle of asynchronous fetches and report the time it took
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t ledgerSeq);
 
     /** Visit every object in the database
         This is usually called during import.
@@ -28,6 +28,9 @@ namespace NodeStore {
 /* This class has two key-value store Backend objects for persisting SHAMap
  * records. This facilitates online deletion of data. New backends are
  * rotated in. Old ones are rotated out and deleted.
+ *
+ * Objects read from the archive backend are copied to the writable backend,
+ * so that the data still in use survives the next rotation.
  */
 
 class DatabaseRotating : public Database
@@ -47,6 +47,11 @@ struct BatchWriteReport
 
     std::chrono::milliseconds elapsed;
     int writeCount;
+
+    // Time spent encoding the batch, and waiting for the batch before
+    // it to be written, when the writes are pipelined
+    std::chrono::milliseconds encodeElapsed{0};
+    std::chrono::milliseconds queueElapsed{0};
 };
 
 /** Scheduling for asynchronous backend activity
@@ -62,7 +62,7 @@ public:
         beast::Journal journal)
         : j_(journal)
         , keyBytes_(keyBytes)
-        , batch_(*this, scheduler)
+        , batch_(*this, scheduler, keyValues)
         , burstSize_(burstSize)
         , name_(get(keyValues, "path"))
         , deletePath_(false)
@@ -82,7 +82,7 @@ public:
         beast::Journal journal)
         : j_(journal)
         , keyBytes_(keyBytes)
-        , batch_(*this, scheduler)
+        , batch_(*this, scheduler, keyValues)
         , burstSize_(burstSize)
         , name_(get(keyValues, "path"))
         , db_(context)
@@ -356,9 +356,29 @@ public:
     }
 
     void
-    writeBatch(Batch const& batch) override
+    encodeBatch(Batch const& batch, EncodedBatch& encoded) override
     {
-        storeBatch(batch);
+        nudb::detail::buffer bf;
+        for (auto const& e : batch)
+        {
+            EncodedBlob blob(e);
+            auto const result =
+                nodeobject_compress(blob.getData(), blob.getSize(), bf);
+            encoded.add(blob.getKey(), result.first, result.second);
+        }
+    }
+
+    void
+    writeBatch(EncodedBatch const& batch) override
+    {
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto const data = batch.data(i);
+            nudb::error_code ec;
+            db_.insert(batch.key(i).data(), data.data(), data.size(), ec);
+            if (ec && ec != nudb::error::key_exists)
+                Throw<nudb::system_error>(ec);
+        }
     }
 
     int
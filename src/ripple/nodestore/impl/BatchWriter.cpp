@@ -19,15 +19,57 @@
 
 #include <ripple/nodestore/impl/BatchWriter.h>
 
+#include <ripple/basics/contract.h>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
 namespace ripple {
 namespace NodeStore {
 
-BatchWriter::BatchWriter(Callback& callback, Scheduler& scheduler)
+void
+EncodedBatch::add(void const* key, void const* data, std::size_t size)
+{
+    auto const offset = data_.size();
+    data_.resize(offset + size);
+    if (size != 0)
+        std::memcpy(data_.data() + offset, data, size);
+    entries_.push_back({uint256::fromVoid(key), offset, size});
+}
+
+void
+EncodedBatch::clear()
+{
+    entries_.clear();
+    data_.clear();
+}
+
+//------------------------------------------------------------------------------
+
+BatchWriter::BatchWriter(
+    Callback& callback,
+    Scheduler& scheduler,
+    Section const& config)
     : m_callback(callback)
     , m_scheduler(scheduler)
+    , mWriteLimit(get<std::size_t>(
+          config,
+          "batch_write_limit",
+          static_cast<std::size_t>(batchWriteLimitSize)))
+    , mQueueLimit(get<std::size_t>(config, "batch_write_queue", 2))
+    , mEncodeStage(*this, &BatchWriter::encodeBatch)
+    , mWriteStage(*this, &BatchWriter::writeBatch)
     , mWriteLoad(0)
+    , mEncodePending(false)
     , mWritePending(false)
 {
+    if (mWriteLimit == 0)
+        Throw<std::runtime_error>(
+            "nodestore: batch_write_limit must be greater than 0");
+    if (mQueueLimit == 0)
+        Throw<std::runtime_error>(
+            "nodestore: batch_write_queue must be greater than 0");
+
     mWriteSet.reserve(batchWritePreallocationSize);
 }
 
@@ -43,16 +85,16 @@ BatchWriter::store(std::shared_ptr<NodeObject> const& object)
 
     // If the batch has reached its limit, we wait
     // until the batch writer is finished
-    while (mWriteSet.size() >= batchWriteLimitSize)
+    while (mWriteSet.size() >= mWriteLimit)
         mWriteCondition.wait(sl);
 
     mWriteSet.push_back(object);
 
-    if (!mWritePending)
+    if (!mEncodePending)
     {
-        mWritePending = true;
+        mEncodePending = true;
 
-        m_scheduler.scheduleTask(*this);
+        m_scheduler.scheduleTask(mEncodeStage);
     }
 }
 
@@ -65,28 +107,82 @@ BatchWriter::getWriteLoad()
 }
 
 void
-BatchWriter::performScheduledTask()
-{
-    writeBatch();
-}
-
-void
-BatchWriter::writeBatch()
+BatchWriter::encodeBatch()
 {
     for (;;)
     {
-        std::vector<std::shared_ptr<NodeObject>> set;
+        Batch set;
+        std::unique_ptr<EncodedBatch> encoded;
 
         set.reserve(batchWritePreallocationSize);
 
         {
             std::lock_guard sl(mWriteMutex);
 
+            // When the queue is full the objects stay where they are. The
+            // writer resumes encoding once it has made room.
+            if (mWriteSet.empty() || mQueue.size() >= mQueueLimit)
+            {
+                mEncodePending = false;
+                mWriteCondition.notify_all();
+                return;
+            }
+
             mWriteSet.swap(set);
             assert(mWriteSet.empty());
-            mWriteLoad = set.size();
+            mWriteLoad += static_cast<int>(set.size());
+
+            if (mSpare.empty())
+            {
+                encoded = std::make_unique<EncodedBatch>();
+            }
+            else
+            {
+                encoded = std::move(mSpare.back());
+                mSpare.pop_back();
+            }
+
+            // There is room in the batch again
+            mWriteCondition.notify_all();
+        }
+
+        auto const before = std::chrono::steady_clock::now();
+
+        m_callback.encodeBatch(set, *encoded);
+
+        auto const after = std::chrono::steady_clock::now();
 
-            if (set.empty())
+        {
+            std::lock_guard sl(mWriteMutex);
+
+            mQueue.push_back(
+                {std::move(encoded),
+                 static_cast<int>(set.size()),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     after - before),
+                 after});
+
+            if (!mWritePending)
+            {
+                mWritePending = true;
+
+                m_scheduler.scheduleTask(mWriteStage);
+            }
+        }
+    }
+}
+
+void
+BatchWriter::writeBatch()
+{
+    for (;;)
+    {
+        Encoded* encoded;
+
+        {
+            std::lock_guard sl(mWriteMutex);
+
+            if (mQueue.empty())
             {
                 mWritePending = false;
                 mWriteCondition.notify_all();
@@ -94,17 +190,47 @@ BatchWriter::writeBatch()
                 // VFALCO NOTE Fix this function to not return from the middle
                 return;
             }
+
+            // Only this stage removes batches from the queue, and adding
+            // more does not move the ones already there.
+            encoded = &mQueue.front();
         }
 
         BatchWriteReport report;
-        report.writeCount = set.size();
+        report.writeCount = encoded->writeCount;
+        report.encodeElapsed = encoded->encodeElapsed;
         auto const before = std::chrono::steady_clock::now();
+        report.queueElapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                before - encoded->queued);
 
-        m_callback.writeBatch(set);
+        m_callback.writeBatch(*encoded->batch);
 
         report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - before);
 
+        {
+            std::lock_guard sl(mWriteMutex);
+
+            mWriteLoad -= encoded->writeCount;
+
+            // Keep the storage of as many batches as can be in flight
+            if (mSpare.size() <= mQueueLimit)
+            {
+                encoded->batch->clear();
+                mSpare.push_back(std::move(encoded->batch));
+            }
+            mQueue.pop_front();
+
+            // Encoding stops while the queue is full, so pick it up again
+            if (!mEncodePending && !mWriteSet.empty())
+            {
+                mEncodePending = true;
+
+                m_scheduler.scheduleTask(mEncodeStage);
+            }
+        }
+
         m_scheduler.onBatchWrite(report);
     }
 }
@@ -114,7 +240,7 @@ BatchWriter::waitForWriting()
 {
     std::unique_lock<decltype(mWriteMutex)> sl(mWriteMutex);
 
-    while (mWritePending)
+    while (mEncodePending || mWritePending)
         mWriteCondition.wait(sl);
 }
 
@@ -20,24 +20,95 @@
 #ifndef RIPPLE_NODESTORE_BATCHWRITER_H_INCLUDED
 #define RIPPLE_NODESTORE_BATCHWRITER_H_INCLUDED
 
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/base_uint.h>
 #include <ripple/nodestore/Scheduler.h>
 #include <ripple/nodestore/Task.h>
 #include <ripple/nodestore/Types.h>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 namespace NodeStore {
 
+/** A batch of objects in the form a backend stores them.
+
+    Each entry is a key and the encoded bytes to store under it. The storage
+    is kept when the batch is cleared, so a batch that is reused does not
+    need to allocate once it has grown to the usual size.
+*/
+class EncodedBatch
+{
+public:
+    EncodedBatch() = default;
+    EncodedBatch(EncodedBatch const&) = delete;
+    EncodedBatch&
+    operator=(EncodedBatch const&) = delete;
+
+    /** Add an entry, copying the key and the data. */
+    void
+    add(void const* key, void const* data, std::size_t size);
+
+    void
+    clear();
+
+    std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    bool
+    empty() const
+    {
+        return entries_.empty();
+    }
+
+    uint256 const&
+    key(std::size_t i) const
+    {
+        return entries_[i].key;
+    }
+
+    Slice
+    data(std::size_t i) const
+    {
+        return {data_.data() + entries_[i].offset, entries_[i].size};
+    }
+
+private:
+    struct Entry
+    {
+        uint256 key;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<std::uint8_t> data_;
+};
+
 /** Batch-writing assist logic.
 
-    The batch writes are performed with a scheduled task. Use of the
-    class it not required. A backend can implement its own write batching,
-    or skip write batching if doing so yields a performance benefit.
+    The batch writes are performed with scheduled tasks, in two stages: the
+    objects stored since the last batch are encoded for the backend while
+    the batch before them is written. Encoded batches wait for the writer in
+    a bounded queue; when it is full, encoding pauses and the objects being
+    stored collect until the writer catches up.
+
+    Use of the class it not required. A backend can implement its own write
+    batching, or skip write batching if doing so yields a performance
+    benefit.
 
     @see Scheduler
 */
-class BatchWriter : private Task
+class BatchWriter
 {
 public:
     /** This callback does the actual writing. */
@@ -49,12 +120,33 @@ public:
         Callback&
         operator=(Callback const&) = delete;
 
+        /** Encode a batch the way the backend stores it.
+
+            This may run concurrently with writeBatch for an earlier batch,
+            so it must not use the database.
+        */
+        virtual void
+        encodeBatch(Batch const& batch, EncodedBatch& encoded) = 0;
+
+        /** Write a batch produced by encodeBatch. */
         virtual void
-        writeBatch(Batch const& batch) = 0;
+        writeBatch(EncodedBatch const& batch) = 0;
     };
 
-    /** Create a batch writer. */
-    BatchWriter(Callback& callback, Scheduler& scheduler);
+    /** Create a batch writer.
+
+        The back-pressure thresholds are taken from the backend's
+        configuration section:
+
+        - batch_write_limit: the number of stored objects waiting to be
+          encoded beyond which storing another object blocks.
+        - batch_write_queue: the number of encoded batches which may wait to
+          be written.
+    */
+    BatchWriter(
+        Callback& callback,
+        Scheduler& scheduler,
+        Section const& config = Section{});
 
     /** Destroy a batch writer.
 
@@ -75,8 +167,37 @@ public:
     getWriteLoad();
 
 private:
+    // Runs one of the stages as a scheduled task
+    class Stage : public Task
+    {
+    public:
+        Stage(BatchWriter& writer, void (BatchWriter::*stage)())
+            : writer_(writer), stage_(stage)
+        {
+        }
+
+        void
+        performScheduledTask() override
+        {
+            (writer_.*stage_)();
+        }
+
+    private:
+        BatchWriter& writer_;
+        void (BatchWriter::*stage_)();
+    };
+
+    // An encoded batch waiting to be written
+    struct Encoded
+    {
+        std::unique_ptr<EncodedBatch> batch;
+        int writeCount;
+        std::chrono::milliseconds encodeElapsed;
+        std::chrono::steady_clock::time_point queued;
+    };
+
     void
-    performScheduledTask() override;
+    encodeBatch();
     void
     writeBatch();
     void
@@ -88,11 +209,18 @@ private:
 
     Callback& m_callback;
     Scheduler& m_scheduler;
+    std::size_t const mWriteLimit;
+    std::size_t const mQueueLimit;
+    Stage mEncodeStage;
+    Stage mWriteStage;
     LockType mWriteMutex;
     CondvarType mWriteCondition;
     int mWriteLoad;
+    bool mEncodePending;
     bool mWritePending;
     Batch mWriteSet;
+    std::deque<Encoded> mQueue;
+    std::vector<std::unique_ptr<EncodedBatch>> mSpare;
 };
 
 }  // namespace NodeStore
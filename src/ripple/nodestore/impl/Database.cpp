@@ -24,6 +24,7 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/jss.h>
+#include <algorithm>
 #include <chrono>
 
 namespace ripple {
@@ -94,29 +95,64 @@ Database::Database(
                             read.insert(read_.extract(read_.begin()));
                     }
 
+                    // Group the reads by the database that serves them,
+                    // which is usually just one, and fetch each group with
+                    // a single call so the backend can coalesce the reads.
+                    struct Group
+                    {
+                        std::uint32_t ledgerSeq;
+                        std::vector<uint256 const*> hashes;
+                        std::vector<decltype(read)::iterator> reads;
+                    };
+                    std::vector<Group> groups;
+
                     for (auto it = read.begin(); it != read.end(); ++it)
                     {
                         assert(!it->second.empty());
 
-                        auto const& hash = it->first;
-                        auto const& data = it->second;
-                        auto const seqn = data[0].first;
+                        auto const seqn = it->second[0].first;
+                        auto group = std::find_if(
+                            groups.begin(), groups.end(), [&](auto const& g) {
+                                return g.ledgerSeq == seqn ||
+                                    isSameDB(g.ledgerSeq, seqn);
+                            });
+                        if (group == groups.end())
+                        {
+                            groups.push_back({seqn, {}, {}});
+                            group = std::prev(groups.end());
+                        }
+                        group->hashes.push_back(&it->first);
+                        group->reads.push_back(it);
+                    }
 
-                        auto obj =
-                            fetchNodeObject(hash, seqn, FetchType::async);
+                    for (auto const& group : groups)
+                    {
+                        auto const objs =
+                            fetchNodeObjects(group.hashes, group.ledgerSeq);
 
-                        // This could be further optimized: if there are
-                        // multiple requests for sequence numbers mapping to
-                        // multiple databases by sorting requests such that all
-                        // indices mapping to the same database are grouped
-                        // together and serviced by a single read.
-                        for (auto const& req : data)
+                        for (std::size_t i = 0; i < group.reads.size(); ++i)
                         {
-                            req.second(
-                                (seqn == req.first) || isSameDB(req.first, seqn)
-                                    ? obj
-                                    : fetchNodeObject(
-                                          hash, req.first, FetchType::async));
+                            auto const& hash = group.reads[i]->first;
+                            auto const& data = group.reads[i]->second;
+                            auto const seqn = group.ledgerSeq;
+
+                            // This could be further optimized: if there are
+                            // multiple requests for sequence numbers mapping
+                            // to multiple databases by sorting requests such
+                            // that all indices mapping to the same database
+                            // are grouped together and serviced by a single
+                            // read.
+                            for (auto const& req : data)
+                            {
+                                req.second(
+                                    (seqn == req.first) ||
+                                            isSameDB(req.first, seqn)
+                                        ? objs[i]
+                                        : fetchNodeObject(
+                                              hash,
+                                              req.first,
+                                              FetchType::async));
+                            }
                         }
                     }
 
@@ -252,15 +288,14 @@ std::shared_ptr<NodeObject>
 Database::fetchNodeObject(
     uint256 const& hash,
     std::uint32_t ledgerSeq,
-    FetchType fetchType,
-    bool duplicate)
+    FetchType fetchType)
 {
     FetchReport fetchReport(fetchType);
 
     using namespace std::chrono;
     auto const begin{steady_clock::now()};
 
-    auto nodeObject{fetchNodeObject(hash, ledgerSeq, fetchReport, duplicate)};
+    auto nodeObject{fetchNodeObject(hash, ledgerSeq, fetchReport)};
     auto dur = steady_clock::now() - begin;
     fetchDurationUs_ += duration_cast<microseconds>(dur).count();
     if (nodeObject)
@@ -275,6 +310,48 @@ Database::fetchNodeObject(
     return nodeObject;
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t ledgerSeq,
+    FetchReport& fetchReport)
+{
+    std::vector<std::shared_ptr<NodeObject>> nodeObjects;
+    nodeObjects.reserve(hashes.size());
+    for (auto const hash : hashes)
+        nodeObjects.push_back(fetchNodeObject(*hash, ledgerSeq, fetchReport));
+    return nodeObjects;
+}
+
+// Perform a bundle of fetches and report the time it took
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t ledgerSeq)
+{
+    FetchReport fetchReport(FetchType::async);
+
+    using namespace std::chrono;
+    auto const begin{steady_clock::now()};
+
+    auto nodeObjects{fetchNodeObjects(hashes, ledgerSeq, fetchReport)};
+    auto dur = steady_clock::now() - begin;
+    fetchDurationUs_ += duration_cast<microseconds>(dur).count();
+    for (auto const& nodeObject : nodeObjects)
+    {
+        if (nodeObject)
+        {
+            ++fetchHitCount_;
+            fetchSz_ += nodeObject->getData().size();
+        }
+    }
+    fetchTotalCount_ += hashes.size();
+
+    fetchReport.elapsed = duration_cast<milliseconds>(dur);
+    scheduler_.onFetch(fetchReport);
+    return nodeObjects;
+}
+
 bool
 Database::storeLedger(
     Ledger const& srcLedger,
@@ -21,6 +21,8 @@
 #include <ripple/nodestore/impl/DatabaseNodeImp.h>
 #include <ripple/protocol/HashPrefix.h>
 
+#include <algorithm>
+
 namespace ripple {
 namespace NodeStore {
 
@@ -74,8 +76,7 @@ std::shared_ptr<NodeObject>
 DatabaseNodeImp::fetchNodeObject(
     uint256 const& hash,
     std::uint32_t,
-    FetchReport& fetchReport,
-    bool duplicate)
+    FetchReport& fetchReport)
 {
     std::shared_ptr<NodeObject> nodeObject =
         cache_ ? cache_->fetch(hash) : nullptr;
@@ -146,24 +147,62 @@ DatabaseNodeImp::fetchNodeObject(
 std::vector<std::shared_ptr<NodeObject>>
 DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
 {
-    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
     using namespace std::chrono;
     auto const before = steady_clock::now();
+
+    std::vector<uint256 const*> keys;
+    keys.reserve(hashes.size());
+    for (auto const& hash : hashes)
+        keys.push_back(&hash);
+
+    std::uint64_t hits = 0;
+    auto results = fetchBatch(keys, hits, j_.error());
+
+    auto fetchDurationUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            steady_clock::now() - before)
+            .count();
+    updateFetchMetrics(hashes.size(), hits, fetchDurationUs);
+    return results;
+}
+
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t,
+    FetchReport& fetchReport)
+{
+    // Asynchronous reads are often for objects we don't have yet
+    std::uint64_t hits = 0;
+    auto results = fetchBatch(hashes, hits, j_.trace());
+
+    if (std::any_of(results.begin(), results.end(), [](auto const& result) {
+            return result != nullptr;
+        }))
+        fetchReport.wasFound = true;
+
+    return results;
+}
+
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseNodeImp::fetchBatch(
+    std::vector<uint256 const*> const& hashes,
+    std::uint64_t& hits,
+    beast::Journal::Stream missing)
+{
+    std::vector<std::shared_ptr<NodeObject>> results{hashes.size()};
     std::unordered_map<uint256 const*, size_t> indexMap;
     std::vector<uint256 const*> cacheMisses;
-    uint64_t hits = 0;
-    uint64_t fetches = 0;
     for (size_t i = 0; i < hashes.size(); ++i)
     {
-        auto const& hash = hashes[i];
+        auto const& hash = *hashes[i];
         // See if the object already exists in the cache
         auto nObj = cache_ ? cache_->fetch(hash) : nullptr;
-        ++fetches;
         if (!nObj)
         {
             // Try the database
-            indexMap[&hash] = i;
-            cacheMisses.push_back(&hash);
+            indexMap[hashes[i]] = i;
+            cacheMisses.push_back(hashes[i]);
         }
         else
         {
@@ -176,13 +215,27 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
     JLOG(j_.debug()) << "fetchBatch - cache hits = "
                      << (hashes.size() - cacheMisses.size())
                      << " - cache misses = " << cacheMisses.size();
-    auto dbResults = backend_->fetchBatch(cacheMisses).first;
+
+    if (cacheMisses.empty())
+        return results;
+
+    std::vector<std::shared_ptr<NodeObject>> dbResults;
+    try
+    {
+        dbResults = backend_->fetchBatch(cacheMisses).first;
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "fetchBatch - Exception fetching from backend: "
+                         << e.what();
+        Rethrow();
+    }
 
     for (size_t i = 0; i < dbResults.size(); ++i)
     {
         auto nObj = std::move(dbResults[i]);
         size_t index = indexMap[cacheMisses[i]];
-        auto const& hash = hashes[index];
+        auto const& hash = *hashes[index];
 
         if (nObj)
         {
@@ -192,7 +245,7 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
         }
         else
         {
-            JLOG(j_.error())
+            JLOG(missing)
                 << "fetchBatch - "
                 << "record not found in db or cache. hash = " << strHex(hash);
             if (cache_)
@@ -206,11 +259,6 @@ DatabaseNodeImp::fetchBatch(std::vector<uint256> const& hashes)
         results[index] = std::move(nObj);
     }
 
-    auto fetchDurationUs =
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            steady_clock::now() - before)
-            .count();
-    updateFetchMetrics(fetches, hits, fetchDurationUs);
     return results;
 }
 
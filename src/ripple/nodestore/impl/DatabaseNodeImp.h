@@ -148,8 +148,22 @@ private:
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t,
-        FetchReport& fetchReport,
-        bool duplicate) override;
+        FetchReport& fetchReport) override;
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t,
+        FetchReport& fetchReport) override;
+
+    // Fetch objects from the cache, and those not cached from the backend
+    // with a single call. Counts the cache hits and logs objects not found
+    // to the given stream.
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(
+        std::vector<uint256 const*> const& hashes,
+        std::uint64_t& hits,
+        beast::Journal::Stream missing);
 
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
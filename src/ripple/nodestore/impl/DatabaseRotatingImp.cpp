@@ -21,9 +21,38 @@
 #include <ripple/nodestore/impl/DatabaseRotatingImp.h>
 #include <ripple/protocol/HashPrefix.h>
 
+#include <algorithm>
+
 namespace ripple {
 namespace NodeStore {
 
+DatabaseRotatingImp::Pinned::Pinned(DatabaseRotatingImp const& db)
+{
+    for (;;)
+    {
+        slot_ = db.current_.load();
+        ++slot_->readers;
+
+        // A rotation may have retired the slot before it was pinned
+        if (db.current_.load() == slot_)
+            return;
+        release();
+    }
+}
+
+DatabaseRotatingImp::Pinned::~Pinned()
+{
+    release();
+}
+
+void
+DatabaseRotatingImp::Pinned::release()
+{
+    // The last reader of a retired slot wakes the rotation waiting on it
+    if (--slot_->readers == 0)
+        slot_->readers.notify_all();
+}
+
 DatabaseRotatingImp::DatabaseRotatingImp(
     Scheduler& scheduler,
     int readThreads,
@@ -32,13 +61,14 @@ DatabaseRotatingImp::DatabaseRotatingImp(
     Section const& config,
     beast::Journal j)
     : DatabaseRotating(scheduler, readThreads, config, j)
-    , writableBackend_(std::move(writableBackend))
-    , archiveBackend_(std::move(archiveBackend))
+    , current_(&slots_[0])
 {
-    if (writableBackend_)
-        fdRequired_ += writableBackend_->fdRequired();
-    if (archiveBackend_)
-        fdRequired_ += archiveBackend_->fdRequired();
+    if (writableBackend)
+        fdRequired_ += writableBackend->fdRequired();
+    if (archiveBackend)
+        fdRequired_ += archiveBackend->fdRequired();
+    slots_[0].writable = std::move(writableBackend);
+    slots_[0].archive = std::move(archiveBackend);
 }
 
 void
@@ -48,53 +78,55 @@ DatabaseRotatingImp::rotateWithLock(
 {
     std::lock_guard lock(mutex_);
 
-    auto newBackend = f(writableBackend_->getName());
-    archiveBackend_->setDeletePath();
-    archiveBackend_ = std::move(writableBackend_);
-    writableBackend_ = std::move(newBackend);
+    Slot* const retired = current_.load();
+    Slot* const next = (retired == &slots_[0]) ? &slots_[1] : &slots_[0];
+
+    // The next slot was emptied by the previous rotation. Anyone pinning it
+    // now finds that it isn't current and leaves it alone.
+    next->writable = f(retired->writable->getName());
+    next->archive = retired->writable;
+    current_.store(next);
+
+    // Wait for the fetches and stores that started before the rotation
+    for (int readers; (readers = retired->readers.load()) != 0;)
+        retired->readers.wait(readers);
+
+    retired->archive->setDeletePath();
+    retired->archive.reset();
+    retired->writable.reset();
 }
 
 std::string
 DatabaseRotatingImp::getName() const
 {
-    std::lock_guard lock(mutex_);
-    return writableBackend_->getName();
+    return Pinned(*this)->writable->getName();
 }
 
 std::int32_t
 DatabaseRotatingImp::getWriteLoad() const
 {
-    std::lock_guard lock(mutex_);
-    return writableBackend_->getWriteLoad();
+    return Pinned(*this)->writable->getWriteLoad();
 }
 
 void
 DatabaseRotatingImp::importDatabase(Database& source)
 {
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
-
+    // Don't hold up a rotation for the whole import
+    auto const backend = Pinned(*this)->writable;
     importInternal(*backend, source);
 }
 
 bool
 DatabaseRotatingImp::storeLedger(std::shared_ptr<Ledger const> const& srcLedger)
 {
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
-
+    auto const backend = Pinned(*this)->writable;
     return Database::storeLedger(*srcLedger, backend);
 }
 
 void
 DatabaseRotatingImp::sync()
 {
-    std::lock_guard lock(mutex_);
-    writableBackend_->sync();
+    Pinned(*this)->writable->sync();
 }
 
 void
@@ -105,13 +137,7 @@ DatabaseRotatingImp::store(
     std::uint32_t)
 {
     auto nObj = NodeObject::createObject(type, std::move(data), hash);
-
-    auto const backend = [&] {
-        std::lock_guard lock(mutex_);
-        return writableBackend_;
-    }();
-
-    backend->store(nObj);
+    Pinned(*this)->writable->store(nObj);
     storeStats(1, nObj->getData().size());
 }
 
@@ -125,8 +151,7 @@ std::shared_ptr<NodeObject>
 DatabaseRotatingImp::fetchNodeObject(
     uint256 const& hash,
     std::uint32_t,
-    FetchReport& fetchReport,
-    bool duplicate)
+    FetchReport& fetchReport)
 {
     auto fetch = [&](std::shared_ptr<Backend> const& backend) {
         Status status;
@@ -157,47 +182,108 @@ DatabaseRotatingImp::fetchNodeObject(
         return nodeObject;
     };
 
-    // See if the node object exists in the cache
     std::shared_ptr<NodeObject> nodeObject;
+    bool archived = false;
+    {
+        Pinned const backends(*this);
 
-    auto [writable, archive] = [&] {
-        std::lock_guard lock(mutex_);
-        return std::make_pair(writableBackend_, archiveBackend_);
-    }();
+        // Try to fetch from the writable backend
+        nodeObject = fetch(backends->writable);
+        if (!nodeObject)
+        {
+            // Otherwise try to fetch from the archive backend
+            nodeObject = fetch(backends->archive);
+            archived = nodeObject != nullptr;
+        }
+    }
+
+    // Objects found in the archive backend are moved to the writable backend
+    // as they are read, so that a rotation finds most of the state it has to
+    // keep already copied. The slot is pinned again in case a rotation
+    // started since.
+    if (archived)
+        Pinned(*this)->writable->store(nodeObject);
+
+    if (nodeObject)
+        fetchReport.wasFound = true;
+
+    return nodeObject;
+}
 
-    // Try to fetch from the writable backend
-    nodeObject = fetch(writable);
-    if (!nodeObject)
+std::vector<std::shared_ptr<NodeObject>>
+DatabaseRotatingImp::fetchNodeObjects(
+    std::vector<uint256 const*> const& hashes,
+    std::uint32_t,
+    FetchReport& fetchReport)
+{
+    auto fetch = [&](std::shared_ptr<Backend> const& backend,
+                     std::vector<uint256 const*> const& keys) {
+        try
+        {
+            return backend->fetchBatch(keys).first;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.fatal()) << "Exception, " << e.what();
+            Rethrow();
+        }
+    };
+
+    std::vector<std::shared_ptr<NodeObject>> nodeObjects;
+    std::vector<std::size_t> index;
     {
+        Pinned const backends(*this);
+
+        // Try to fetch from the writable backend
+        nodeObjects = fetch(backends->writable, hashes);
+
         // Otherwise try to fetch from the archive backend
-        nodeObject = fetch(archive);
-        if (nodeObject)
+        std::vector<uint256 const*> missing;
+        for (std::size_t i = 0; i < nodeObjects.size(); ++i)
         {
+            if (!nodeObjects[i])
             {
-                // Refresh the writable backend pointer
-                std::lock_guard lock(mutex_);
-                writable = writableBackend_;
+                missing.push_back(hashes[i]);
+                index.push_back(i);
             }
+        }
 
-            // Update writable backend with data from the archive backend
-            if (duplicate)
-                writable->store(nodeObject);
+        if (!missing.empty())
+        {
+            auto archived = fetch(backends->archive, missing);
+            for (std::size_t i = 0; i < archived.size(); ++i)
+                nodeObjects[index[i]] = std::move(archived[i]);
         }
     }
 
-    if (nodeObject)
+    // Move what was found in the archive backend, as above
+    if (!index.empty())
+    {
+        Batch batch;
+        for (auto const i : index)
+        {
+            if (nodeObjects[i])
+                batch.push_back(nodeObjects[i]);
+        }
+        if (!batch.empty())
+            Pinned(*this)->writable->storeBatch(batch);
+    }
+
+    if (std::any_of(nodeObjects.begin(), nodeObjects.end(), [](auto const& o) {
+            return o != nullptr;
+        }))
         fetchReport.wasFound = true;
 
-    return nodeObject;
+    return nodeObjects;
 }
 
 void
 DatabaseRotatingImp::for_each(
     std::function<void(std::shared_ptr<NodeObject>)> f)
 {
-    auto [writable, archive] = [&] {
-        std::lock_guard lock(mutex_);
-        return std::make_pair(writableBackend_, archiveBackend_);
+    auto const [writable, archive] = [&] {
+        Pinned const backends(*this);
+        return std::make_pair(backends->writable, backends->archive);
     }();
 
     // Iterate the writable backend
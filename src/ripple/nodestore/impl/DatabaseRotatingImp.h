@@ -22,6 +22,10 @@
 
 #include <ripple/nodestore/DatabaseRotating.h>
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 namespace ripple {
 namespace NodeStore {
 
@@ -80,16 +84,58 @@ public:
     sweep() override;
 
 private:
-    std::shared_ptr<Backend> writableBackend_;
-    std::shared_ptr<Backend> archiveBackend_;
-    mutable std::mutex mutex_;
+    // The writable and archive backends, which a rotation replaces
+    // together. Readers pin the slot that is current instead of taking a
+    // lock, and a rotation waits for the readers of the slot it retires
+    // before releasing the backends in it.
+    struct Slot
+    {
+        std::shared_ptr<Backend> writable;
+        std::shared_ptr<Backend> archive;
+        std::atomic<int> readers{0};
+    };
+
+    class Pinned
+    {
+    public:
+        explicit Pinned(DatabaseRotatingImp const& db);
+
+        ~Pinned();
+
+        Pinned(Pinned const&) = delete;
+        Pinned&
+        operator=(Pinned const&) = delete;
+
+        Slot const*
+        operator->() const
+        {
+            return slot_;
+        }
+
+    private:
+        void
+        release();
+
+        Slot* slot_;
+    };
+
+    mutable std::array<Slot, 2> slots_;
+    std::atomic<Slot*> current_;
+
+    // Serializes rotations
+    std::mutex mutex_;
 
     std::shared_ptr<NodeObject>
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t,
-        FetchReport& fetchReport,
-        bool duplicate) override;
+        FetchReport& fetchReport) override;
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchNodeObjects(
+        std::vector<uint256 const*> const& hashes,
+        std::uint32_t,
+        FetchReport& fetchReport) override;
 
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override;
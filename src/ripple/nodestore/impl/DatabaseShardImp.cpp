@@ -1383,8 +1383,7 @@ std::shared_ptr<NodeObject>
 DatabaseShardImp::fetchNodeObject(
     uint256 const& hash,
     std::uint32_t ledgerSeq,
-    FetchReport& fetchReport,
-    bool duplicate)
+    FetchReport& fetchReport)
 {
     auto const shardIndex{seqToShardIndex(ledgerSeq)};
     std::shared_ptr<Shard> shard;
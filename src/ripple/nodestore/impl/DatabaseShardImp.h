@@ -303,8 +303,7 @@ private:
     fetchNodeObject(
         uint256 const& hash,
         std::uint32_t ledgerSeq,
-        FetchReport& fetchReport,
-        bool duplicate) override;
+        FetchReport& fetchReport) override;
 
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
@@ -1125,14 +1125,45 @@ Shard::verifyLedger(
     if (ledger->info().accountHash.isZero())
         return fail("Invalid ledger account hash");
 
+    // Node objects are fetched as the maps are walked, but their payloads
+    // are checked against their hashes a batch at a time so that they can
+    // be hashed together. They are stored in the deterministic shard in
+    // the order they were visited.
+    static constexpr std::size_t batchSize{64};
+    std::vector<std::shared_ptr<NodeObject>> batch;
+    batch.reserve(batchSize);
+
     bool error{false};
-    auto visit = [this, &error, &dShard](SHAMapTreeNode const& node) {
+    auto flush = [this, &error, &dShard, &batch]() {
+        if (!verifyPayloads(batch))
+            error = true;
+        else
+        {
+            for (auto const& nodeObject : batch)
+            {
+                if (!dShard->store(nodeObject))
+                {
+                    error = true;
+                    break;
+                }
+            }
+        }
+        batch.clear();
+        return !error;
+    };
+    auto visit = [this, &error, &batch, &flush](SHAMapTreeNode const& node) {
         if (stop_)
             return false;
 
-        auto nodeObject{verifyFetch(node.getHash().as_uint256())};
-        if (!nodeObject || !dShard->store(nodeObject))
+        auto nodeObject{verifyFetch(node.getHash().as_uint256(), false)};
+        if (!nodeObject)
             error = true;
+        else
+        {
+            batch.push_back(std::move(nodeObject));
+            if (batch.size() >= batchSize)
+                flush();
+        }
 
         return !error;
     };
@@ -1149,6 +1180,8 @@ Shard::verifyLedger(
                 ledger->stateMap().visitDifferences(&next->stateMap(), visit);
             else
                 ledger->stateMap().visitNodes(visit);
+            if (!error && !stop_)
+                flush();
         }
         catch (std::exception const& e)
         {
@@ -1172,6 +1205,8 @@ Shard::verifyLedger(
         try
         {
             ledger->txMap().visitNodes(visit);
+            if (!error && !stop_)
+                flush();
         }
         catch (std::exception const& e)
         {
@@ -1190,7 +1225,7 @@ Shard::verifyLedger(
 }
 
 std::shared_ptr<NodeObject>
-Shard::verifyFetch(uint256 const& hash) const
+Shard::verifyFetch(uint256 const& hash, bool checkPayload) const
 {
     std::shared_ptr<NodeObject> nodeObject;
     auto fail =
@@ -1208,8 +1243,9 @@ Shard::verifyFetch(uint256 const& hash) const
         {
             case ok:
                 // Verify that the hash of node object matches the payload
-                if (nodeObject->getHash() !=
-                    sha512Half(makeSlice(nodeObject->getData())))
+                if (checkPayload &&
+                    nodeObject->getHash() !=
+                        sha512Half(makeSlice(nodeObject->getData())))
                     return fail("Node object hash does not match payload");
                 return nodeObject;
             case notFound:
@@ -1228,6 +1264,32 @@ Shard::verifyFetch(uint256 const& hash) const
     }
 }
 
+bool
+Shard::verifyPayloads(
+    std::vector<std::shared_ptr<NodeObject>> const& nodeObjects) const
+{
+    std::vector<Slice> payloads;
+    payloads.reserve(nodeObjects.size());
+    for (auto const& nodeObject : nodeObjects)
+        payloads.push_back(makeSlice(nodeObject->getData()));
+
+    auto const hashes{sha512HalfBatch(payloads)};
+
+    bool result{true};
+    for (std::size_t i = 0; i < nodeObjects.size(); ++i)
+    {
+        if (nodeObjects[i]->getHash() != hashes[i])
+        {
+            JLOG(j_.error()) << "shard " << index_
+                             << ". Node object hash does not match payload"
+                             << ". Node object hash "
+                             << to_string(nodeObjects[i]->getHash());
+            result = false;
+        }
+    }
+    return result;
+}
+
 Shard::Count
 Shard::makeBackendCount()
 {
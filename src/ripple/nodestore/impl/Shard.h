@@ -389,8 +389,15 @@ private:
         std::shared_ptr<DeterministicShard> const& dShard) const;
 
     // Fetches from backend and log errors based on status codes
+    // The payload is checked against the hash unless checkPayload is false
     [[nodiscard]] std::shared_ptr<NodeObject>
-    verifyFetch(uint256 const& hash) const;
+    verifyFetch(uint256 const& hash, bool checkPayload = true) const;
+
+    // Checks the payloads of fetched node objects against their hashes,
+    // hashing them together in batches, and logs any that do not match
+    [[nodiscard]] bool
+    verifyPayloads(
+        std::vector<std::shared_ptr<NodeObject>> const& nodeObjects) const;
 
     // Open databases if they are closed
     [[nodiscard]] Shard::Count
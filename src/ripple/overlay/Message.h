@@ -28,6 +28,7 @@
 #include <boost/asio/buffers_iterator.hpp>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
 #include <memory>
@@ -56,6 +57,13 @@ class Message : public std::enable_shared_from_this<Message>
     using Algorithm = compression::Algorithm;
 
 public:
+    /** The buffers allocated for a message */
+    struct Allocations
+    {
+        bool serialized = false;
+        bool compressed = false;
+    };
+
     /** Constructor
      * @param message Protocol message to serialize
      * @param type Protocol message type
@@ -108,12 +116,22 @@ public:
     int
     getType() const;
 
+    /** Retrieve the buffers allocated for this message since the last call.
+     * A message is serialized once and shared by every peer it is sent to,
+     * so this lets its allocations be accounted for once rather than once
+     * per peer.
+     */
+    Allocations
+    takeAllocations();
+
 private:
     std::vector<uint8_t> buffer_;
     std::vector<uint8_t> bufferCompressed_;
     std::size_t category_;
     std::once_flag once_flag_;
     std::optional<PublicKey> validatorKey_;
+    std::atomic<bool> serializedUnaccounted_{true};
+    std::atomic<bool> compressedUnaccounted_{false};
 
     /** Set the payload header
      * @param in Pointer to the payload
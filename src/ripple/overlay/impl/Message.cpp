@@ -109,6 +109,8 @@ Message::compress()
 
     if (compressible)
     {
+        compressedUnaccounted_ = true;
+
         auto payload = static_cast<void const*>(buffer_.data() + headerBytes);
 
         auto compressedSize = ripple::compression::compress(
@@ -228,4 +230,13 @@ Message::getType() const
     return type;
 }
 
+Message::Allocations
+Message::takeAllocations()
+{
+    Allocations result;
+    result.serialized = serializedUnaccounted_.exchange(false);
+    result.compressed = compressedUnaccounted_.exchange(false);
+    return result;
+}
+
 }  // namespace ripple
@@ -561,6 +561,15 @@ OverlayImpl::stop()
 void
 OverlayImpl::onWrite(beast::PropertyStream::Map& stream)
 {
+    {
+        auto const& send = m_traffic.getSendStats();
+        beast::PropertyStream::Map item("send", stream);
+        item["messages_serialized"] = std::to_string(send.serialized.load());
+        item["messages_compressed"] = std::to_string(send.compressed.load());
+        item["messages_queued"] = std::to_string(send.queued.load());
+        item["socket_writes"] = std::to_string(send.writes.load());
+    }
+
     beast::PropertyStream::Set set("traffic", stream);
     auto const stats = m_traffic.getCounts();
     for (auto const& i : stats)
@@ -676,6 +685,18 @@ OverlayImpl::reportTraffic(
     m_traffic.addCount(cat, isInbound, number);
 }
 
+void
+OverlayImpl::reportQueued(Message::Allocations const& allocations)
+{
+    m_traffic.addQueued(allocations.serialized, allocations.compressed);
+}
+
+void
+OverlayImpl::reportWrite()
+{
+    m_traffic.addWrite();
+}
+
 Json::Value
 OverlayImpl::crawlShards(bool includePublicKey, std::uint32_t relays)
 {
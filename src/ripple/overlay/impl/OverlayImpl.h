@@ -350,6 +350,12 @@ public:
     void
     reportTraffic(TrafficCount::category cat, bool isInbound, int bytes);
 
+    void
+    reportQueued(Message::Allocations const& allocations);
+
+    void
+    reportWrite();
+
     void
     incJqTransOverflow() override
     {
@@ -597,12 +603,23 @@ private:
             std::vector<TrafficGauges>&& trafficGauges_)
             : peerDisconnects(
                   collector->make_gauge("Overlay", "Peer_Disconnects"))
+            , messagesSerialized(
+                  collector->make_gauge("Overlay", "Messages_Serialized"))
+            , messagesCompressed(
+                  collector->make_gauge("Overlay", "Messages_Compressed"))
+            , messagesQueued(
+                  collector->make_gauge("Overlay", "Messages_Queued"))
+            , socketWrites(collector->make_gauge("Overlay", "Socket_Writes"))
             , trafficGauges(std::move(trafficGauges_))
             , hook(collector->make_hook(handler))
         {
         }
 
         beast::insight::Gauge peerDisconnects;
+        beast::insight::Gauge messagesSerialized;
+        beast::insight::Gauge messagesCompressed;
+        beast::insight::Gauge messagesQueued;
+        beast::insight::Gauge socketWrites;
         std::vector<TrafficGauges> trafficGauges;
         beast::insight::Hook hook;
     };
@@ -615,6 +632,7 @@ private:
     collect_metrics()
     {
         auto counts = m_traffic.getCounts();
+        auto const& send = m_traffic.getSendStats();
         std::lock_guard lock(m_statsMutex);
         assert(counts.size() == m_stats.trafficGauges.size());
 
@@ -626,6 +644,10 @@ private:
             m_stats.trafficGauges[i].messagesOut = counts[i].messagesOut;
         }
         m_stats.peerDisconnects = getPeerDisconnect();
+        m_stats.messagesSerialized = send.serialized;
+        m_stats.messagesCompressed = send.compressed;
+        m_stats.messagesQueued = send.queued;
+        m_stats.socketWrites = send.writes;
     }
 };
 
@@ -41,10 +41,12 @@
 #include <ripple/overlay/impl/Tuning.h>
 #include <ripple/overlay/predicates.h>
 #include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/STObjectView.h>
 #include <ripple/protocol/digest.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/beast/core/ostream.hpp>
+#include <boost/beast/core/span.hpp>
 
 #include <algorithm>
 #include <chrono>
@@ -283,6 +285,7 @@ PeerImp::send(std::shared_ptr<Message> const& m)
         safe_cast<TrafficCount::category>(m->getCategory()),
         false,
         static_cast<int>(m->getBuffer(compressionEnabled_).size()));
+    overlay_.reportQueued(m->takeAllocations());
 
     auto sendq_size = send_queue_.size();
 
@@ -301,22 +304,12 @@ PeerImp::send(std::shared_ptr<Message> const& m)
              << " sendq: " << sendq_size;
     }
 
-    send_queue_.push(m);
+    send_queue_.push_back(m);
 
     if (sendq_size != 0)
         return;
 
-    boost::asio::async_write(
-        stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
-        bind_executor(
-            strand_,
-            std::bind(
-                &PeerImp::onWriteMessage,
-                shared_from_this(),
-                std::placeholders::_1,
-                std::placeholders::_2)));
+    writeQueued();
 }
 
 void
@@ -643,13 +636,10 @@ PeerImp::fail(protocol::TMCloseReason reason)
                               << " failed: " << closeReasonToString(reason);
     }
 
-    // erase all outstanding messages except for the one
-    // currently being executed
-    if (send_queue_.size() > 1)
-    {
-        decltype(send_queue_) q({send_queue_.front()});
-        send_queue_.swap(q);
-    }
+    // erase all outstanding messages except for the ones
+    // currently being written
+    if (send_queue_.size() > sending_)
+        send_queue_.erase(send_queue_.begin() + sending_, send_queue_.end());
 
     closeOnWriteComplete_ = true;
     protocol::TMGracefulClose tmGC;
@@ -932,6 +922,48 @@ PeerImp::onReadMessage(error_code ec, std::size_t bytes_transferred)
                 std::placeholders::_2)));
 }
 
+void
+PeerImp::writeQueued()
+{
+    assert(sending_ == 0 && !send_queue_.empty());
+
+    // Gather the messages at the front of the queue into one write. The
+    // buffers are those of the messages themselves, which are shared with
+    // every other peer they are sent to, and the messages stay queued until
+    // the write completes.
+    sendBuffers_.clear();
+    std::size_t bytes = 0;
+    for (auto const& m : send_queue_)
+    {
+        auto const& buffer = m->getBuffer(compressionEnabled_);
+        if (sending_ != 0 &&
+            (sending_ == Tuning::sendGatherMessages ||
+             bytes + buffer.size() > Tuning::sendGatherBytes))
+            break;
+
+        sendBuffers_.emplace_back(buffer.data(), buffer.size());
+        bytes += buffer.size();
+        ++sending_;
+
+        // Nothing is sent after a graceful close
+        if (m->getType() == protocol::mtGRACEFUL_CLOSE)
+            break;
+    }
+
+    overlay_.reportWrite();
+    boost::asio::async_write(
+        stream_,
+        boost::beast::span<boost::asio::const_buffer const>(
+            sendBuffers_.data(), sendBuffers_.size()),
+        bind_executor(
+            strand_,
+            std::bind(
+                &PeerImp::onWriteMessage,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+}
+
 void
 PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 {
@@ -955,27 +987,18 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 
     metrics_.sent.add_message(bytes_transferred);
 
-    assert(!send_queue_.empty());
-    if (send_queue_.front()->getType() == protocol::mtGRACEFUL_CLOSE)
+    assert(sending_ != 0 && send_queue_.size() >= sending_);
+    if (send_queue_[sending_ - 1]->getType() == protocol::mtGRACEFUL_CLOSE)
     {
         close();
         return;
     }
-    send_queue_.pop();
+    send_queue_.erase(send_queue_.begin(), send_queue_.begin() + sending_);
+    sending_ = 0;
     if (!send_queue_.empty())
     {
         // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
+        return writeQueued();
     }
 
     if (gracefulClose_)
@@ -2529,24 +2552,22 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
     {
         auto const closeTime = app_.timeKeeper().closeTime();
 
-        std::shared_ptr<STValidation> val;
-        {
-            SerialIter sit(makeSlice(m->validation()));
-            val = std::make_shared<STValidation>(
-                std::ref(sit),
-                [this](PublicKey const& pk) {
-                    return calcNodeID(
-                        app_.validatorManifests().getMasterKey(pk));
-                },
-                false);
-            val->setSeen(closeTime);
-        }
+        // Most validations are stale, untrusted or duplicates, so read
+        // only what is needed to discard them before building the full
+        // validation, which is left for those that will be checked.
+        STObjectView const view(makeSlice(m->validation()));
+        NetClock::time_point const signTime{
+            NetClock::duration{view.getFieldU32(sfSigningTime)}};
+        auto const signingKey = view.getFieldVL(sfSigningPubKey);
+        if (publicKeyType(signingKey) != KeyType::secp256k1)
+            Throw<std::runtime_error>("Invalid public key in validation");
+        PublicKey const signer(signingKey);
 
         if (!isCurrent(
                 app_.getValidations().parms(),
                 app_.timeKeeper().closeTime(),
-                val->getSignTime(),
-                val->getSeenTime()))
+                signTime,
+                closeTime))
         {
             JLOG(p_journal_.trace()) << "Validation: Not current";
             fee_ = Resource::feeUnwantedData;
@@ -2556,8 +2577,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         // RH TODO: when isTrusted = false we should probably also cache a key
         // suppression for 30 seconds to avoid doing a relatively expensive
         // lookup every time a spam packet is received
-        auto const isTrusted =
-            app_.validators().trusted(val->getSignerPublic());
+        auto const isTrusted = app_.validators().trusted(signer);
 
         // If the operator has specified that untrusted validations be dropped
         // then this happens here I.e. before further wasting CPU verifying the
@@ -2578,7 +2598,7 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
             if (reduceRelayReady() && relayed &&
                 (stopwatch().now() - *relayed) < reduce_relay::IDLED)
                 overlay_.updateSlotAndSquelch(
-                    key, val->getSignerPublic(), id_, protocol::mtVALIDATION);
+                    key, signer, id_, protocol::mtVALIDATION);
             JLOG(p_journal_.trace()) << "Validation: duplicate";
             return;
         }
@@ -2590,6 +2610,16 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
         }
         else if (isTrusted || !app_.getFeeTrack().isLoadedLocal())
         {
+            SerialIter sit(makeSlice(m->validation()));
+            auto val = std::make_shared<STValidation>(
+                std::ref(sit),
+                [this](PublicKey const& pk) {
+                    return calcNodeID(
+                        app_.validatorManifests().getMasterKey(pk));
+                },
+                false);
+            val->setSeen(closeTime);
+
             std::string const name = [isTrusted, val]() {
                 std::string ret =
                     isTrusted ? "Trusted validation" : "Untrusted validation";
@@ -41,8 +41,8 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <cstdint>
+#include <deque>
 #include <optional>
-#include <queue>
 
 namespace ripple {
 
@@ -155,7 +155,11 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    std::deque<std::shared_ptr<Message>> send_queue_;
+    // The number of messages at the front of send_queue_ being written, and
+    // the buffers they are written from
+    std::size_t sending_ = 0;
+    std::vector<boost::asio::const_buffer> sendBuffers_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
@@ -478,6 +482,10 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Writes as many queued messages as Tuning allows in one operation
+    void
+    writeQueued();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
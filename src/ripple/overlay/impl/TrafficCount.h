@@ -61,6 +61,28 @@ public:
         }
     };
 
+    /** Counters for the outbound path, across all categories.
+
+        Dividing the allocations by the messages serialized gives the
+        allocations per broadcast, and the messages queued by the writes
+        gives how many messages each write gathers.
+    */
+    class SendStats
+    {
+    public:
+        // Messages serialized, each into one buffer shared by every peer
+        std::atomic<std::uint64_t> serialized{0};
+
+        // Compressed copies of messages made, at most one per message
+        std::atomic<std::uint64_t> compressed{0};
+
+        // Messages queued to peers
+        std::atomic<std::uint64_t> queued{0};
+
+        // Writes to peer sockets
+        std::atomic<std::uint64_t> writes{0};
+    };
+
     // If you add entries to this enum, you need to update the initialization
     // of the arrays at the bottom of this file which map array numbers to
     // human-readable, monitoring-tool friendly names.
@@ -186,6 +208,30 @@ public:
         }
     }
 
+    /** Account for a message queued to be sent to a peer
+
+        @param serialized Whether the buffer the message was serialized into
+                          is not yet accounted for
+        @param compressed Whether its compressed copy is not yet accounted
+                          for
+     */
+    void
+    addQueued(bool serialized, bool compressed)
+    {
+        if (serialized)
+            ++send_.serialized;
+        if (compressed)
+            ++send_.compressed;
+        ++send_.queued;
+    }
+
+    /** Account for a write of one or more queued messages to a peer */
+    void
+    addWrite()
+    {
+        ++send_.writes;
+    }
+
     TrafficCount() = default;
 
     /** An up-to-date copy of all the counters
@@ -198,7 +244,16 @@ public:
         return counts_;
     }
 
+    /** The counters for the outbound path */
+    SendStats const&
+    getSendStats() const
+    {
+        return send_;
+    }
+
 protected:
+    SendStats send_;
+
     std::array<TrafficStats, category::unknown + 1> counts_{{
         {"overhead"},           // category::base
         {"overhead_cluster"},   // category::cluster
@@ -54,6 +54,9 @@ enum {
     /** How often to log send queue size */
     sendQueueLogFreq = 64,
 
+    /** The most queued messages gathered into a single write */
+    sendGatherMessages = 32,
+
     /** How often we check for idle peers (seconds) */
     checkIdlePeers = 4,
 
@@ -64,6 +67,10 @@ enum {
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
+/** How many bytes of queued messages to gather into a single write. A larger
+    message is still written, on its own. */
+std::size_t constexpr sendGatherBytes = 65536;
+
 }  // namespace Tuning
 
 }  // namespace ripple
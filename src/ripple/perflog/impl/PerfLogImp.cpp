@@ -26,6 +26,7 @@
 #include <ripple/json/json_writer.h>
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
@@ -161,11 +162,39 @@ PerfLogImp::Counters::countersJson() const
         jqobj[jss::total] = totalJqJson;
     }
 
+    Json::Value phaseobj(Json::objectValue);
+    {
+        std::lock_guard lock(phasesMutex_);
+        for (auto const& [name, value] : phases_)
+        {
+            Json::Value p(Json::objectValue);
+            p[jss::finished] = std::to_string(value.finished);
+            p[jss::duration_us] = std::to_string(value.duration.count());
+            p[jss::max_duration_us] =
+                std::to_string(value.maxDuration.count());
+            if (!value.recent.empty())
+            {
+                auto recent = value.recent;
+                // The nearest-rank percentile
+                auto const percentile = [&recent](std::size_t pct) {
+                    auto const nth = recent.begin() +
+                        (recent.size() * pct + 99) / 100 - 1;
+                    std::nth_element(recent.begin(), nth, recent.end());
+                    return std::to_string(nth->count());
+                };
+                p[jss::p50_duration_us] = percentile(50);
+                p[jss::p99_duration_us] = percentile(99);
+            }
+            phaseobj[name] = p;
+        }
+    }
+
     Json::Value counters(Json::objectValue);
-    // Be kind to reporting tools and let them expect rpc and jq objects
-    // even if empty.
+    // Be kind to reporting tools and let them expect rpc, jq and phase
+    // objects even if empty.
     counters[jss::rpc] = rpcobj;
     counters[jss::job_queue] = jqobj;
+    counters[jss::phases] = phaseobj;
     return counters;
 }
 
@@ -433,6 +462,20 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         counters_.jobs_[instance] = {jtINVALID, steady_time_point()};
 }
 
+void
+PerfLogImp::phaseFinish(char const* phase, microseconds dur)
+{
+    std::lock_guard lock(counters_.phasesMutex_);
+    auto& counter = counters_.phases_[phase];
+    ++counter.finished;
+    counter.duration += dur;
+    counter.maxDuration = std::max(counter.maxDuration, dur);
+    if (counter.recent.size() < Counters::Phase::recentSize)
+        counter.recent.push_back(dur);
+    else
+        counter.recent[(counter.finished - 1) % counter.recent.size()] = dur;
+}
+
 void
 PerfLogImp::resizeJobs(int const resize)
 {
@@ -104,6 +104,23 @@ class PerfLogImp : public PerfLog
             microseconds runningDuration{0};
         };
 
+        /**
+         * Timed phase performance counters.
+         */
+        struct Phase
+        {
+            // How many recent durations are kept for percentiles.
+            static constexpr std::size_t recentSize = 1024;
+
+            std::uint64_t finished{0};
+            // Cumulative and longest duration of the finished phases.
+            microseconds duration{0};
+            microseconds maxDuration{0};
+            // The durations of the most recently finished phases, as a
+            // ring buffer.
+            std::vector<microseconds> recent;
+        };
+
         // rpc_ and jq_ do not need mutex protection because all
         // keys and values are created before more threads are started.
         std::unordered_map<std::string, Locked<Rpc>> rpc_;
@@ -112,6 +129,9 @@ class PerfLogImp : public PerfLog
         mutable std::mutex jobsMutex_;
         std::unordered_map<std::uint64_t, MethodStart> methods_;
         mutable std::mutex methodsMutex_;
+        // Phases are added as they are first reported.
+        std::unordered_map<std::string, Phase> phases_;
+        mutable std::mutex phasesMutex_;
 
         Counters(std::set<char const*> const& labels, JobTypes const& jobTypes);
         Json::Value
@@ -180,6 +200,8 @@ public:
         int instance) override;
     void
     jobFinish(JobType const type, microseconds dur, int instance) override;
+    void
+    phaseFinish(char const* phase, microseconds dur) override;
 
     Json::Value
     countersJson() const override
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_STOBJECTVIEW_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/SField.h>
+
+#include <boost/container/small_vector.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace ripple {
+
+/** A read-only view of a serialized STObject.
+
+    The view finds where each top-level field of the object lies in the
+    buffer, without copying it or constructing any of the fields, so that
+    a few fields can be read from a message before deciding whether it is
+    worth deserializing in full. The buffer must outlive the view.
+
+    Only as much of each field is checked as is needed to find where it
+    ends. Nothing is checked against a template, and if a field appears
+    more than once the first is used. Malformed input throws.
+*/
+class STObjectView
+{
+public:
+    explicit STObjectView(Slice data);
+
+    /** The number of top-level fields in the object. */
+    std::size_t
+    getCount() const
+    {
+        return fields_.size();
+    }
+
+    bool
+    isFieldPresent(SField const& field) const;
+
+    /** The serialized contents of a field, if it is present.
+
+        The contents do not include the field ID or, for variable length
+        fields, the length prefix.
+    */
+    std::optional<Slice>
+    peekFieldData(SField const& field) const;
+
+    // These throw if the field is missing or has the wrong type.
+
+    std::uint8_t
+    getFieldU8(SField const& field) const;
+
+    std::uint16_t
+    getFieldU16(SField const& field) const;
+
+    std::uint32_t
+    getFieldU32(SField const& field) const;
+
+    std::uint64_t
+    getFieldU64(SField const& field) const;
+
+    uint256
+    getFieldH256(SField const& field) const;
+
+    Slice
+    getFieldVL(SField const& field) const;
+
+private:
+    struct Field
+    {
+        int code;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    Slice
+    getField(SField const& field, SerializedTypeID type) const;
+
+    Slice data_;
+    boost::container::small_vector<Field, 24> fields_;
+};
+
+}  // namespace ripple
+
+#endif
@@ -20,11 +20,13 @@
 #ifndef RIPPLE_PROTOCOL_DIGEST_H_INCLUDED
 #define RIPPLE_PROTOCOL_DIGEST_H_INCLUDED
 
+#include <ripple/basics/Slice.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/crypto/secure_erase.h>
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
 #include <array>
+#include <vector>
 
 namespace ripple {
 
@@ -237,6 +239,50 @@ sha512Half_s(Args const&... args)
     return static_cast<typename sha512_half_hasher_s::result_type>(h);
 }
 
+//------------------------------------------------------------------------------
+
+/** Computes the SHA512-Half of each of a number of messages.
+
+    Each digest is the same as sha512Half of the corresponding message.
+    When the CPU supports AVX2 or AVX-512, messages that pad to the same
+    number of SHA-512 blocks are hashed several at a time, one per SIMD
+    lane. Otherwise each message is hashed on its own.
+
+    @param messages The messages to hash.
+    @param digests Receives the digest of each message, in the same order.
+    @param count The number of messages.
+*/
+void
+sha512HalfBatch(Slice const* messages, uint256* digests, std::size_t count);
+
+/** Returns the SHA512-Half of each of a number of messages. */
+inline std::vector<uint256>
+sha512HalfBatch(std::vector<Slice> const& messages)
+{
+    std::vector<uint256> digests(messages.size());
+    sha512HalfBatch(messages.data(), digests.data(), messages.size());
+    return digests;
+}
+
+namespace detail {
+
+/** The implementations sha512HalfBatch can choose from. */
+enum class sha512_engine { openssl, avx2, avx512 };
+
+/** Returns the engines this CPU supports, with the one used last. */
+std::vector<sha512_engine> const&
+sha512Engines();
+
+/** Computes the digests with a specific engine, which must be supported. */
+void
+sha512HalfBatch(
+    sha512_engine engine,
+    Slice const* messages,
+    uint256* digests,
+    std::size_t count);
+
+}  // namespace detail
+
 }  // namespace ripple
 
 #endif
@@ -24,6 +24,8 @@
 #include <ripple/protocol/STBlob.h>
 #include <ripple/protocol/STObject.h>
 
+#include <boost/container/small_vector.hpp>
+
 namespace ripple {
 
 STObject::STObject(STObject&& other)
@@ -124,24 +126,36 @@ STObject::applyTemplate(const SOTemplate& type)
     };
 
     mType = &type;
+
+    // Look up where each field goes in the template once, rather than
+    // searching the fields for every element of the template. If a field
+    // appears more than once, the first is used and the rest are leftovers.
+    boost::container::small_vector<detail::STVar*, 64> slots(
+        type.size(), nullptr);
+    SField const* disallowed = nullptr;
+    for (auto& e : v_)
+    {
+        auto const index = type.getIndex(e->getFName());
+        if (index != -1 && !slots[index])
+            slots[index] = &e;
+        else if (!disallowed && !e->getFName().isDiscardable())
+            disallowed = &e->getFName();
+    }
+
     decltype(v_) v;
     v.reserve(type.size());
+    auto slot = slots.cbegin();
     for (auto const& e : type)
     {
-        auto const iter =
-            std::find_if(v_.begin(), v_.end(), [&](detail::STVar const& b) {
-                return b.get().getFName() == e.sField();
-            });
-        if (iter != v_.end())
+        if (auto const field = *slot++)
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            if ((e.style() == soeDEFAULT) && field->get().isDefault())
             {
                 throwFieldErr(
                     e.sField().fieldName,
                     "may not be explicitly set to default.");
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            v.emplace_back(std::move(*field));
         }
         else
         {
@@ -152,15 +166,11 @@ STObject::applyTemplate(const SOTemplate& type)
             v.emplace_back(detail::nonPresentObject, e.sField());
         }
     }
-    for (auto const& e : v_)
-    {
-        // Anything left over in the object must be discardable
-        if (!e->getFName().isDiscardable())
-        {
-            throwFieldErr(
-                e->getFName().getName(), "found in disallowed location.");
-        }
-    }
+
+    // Anything left over in the object must be discardable
+    if (disallowed)
+        throwFieldErr(disallowed->getName(), "found in disallowed location.");
+
     // Swap the template matching data in for the old data,
     // freeing any leftover junk
     v_.swap(v);
@@ -180,6 +190,8 @@ bool
 STObject::set(SerialIter& sit, int depth)
 {
     bool reachedEndOfObject = false;
+    bool sorted = true;
+    int lastFieldCode = 0;
 
     v_.clear();
 
@@ -216,25 +228,35 @@ STObject::set(SerialIter& sit, int depth)
             Throw<std::runtime_error>("Unknown field");
         }
 
+        // Fields in canonical order cannot repeat, so only an object that
+        // arrives out of order needs the full duplicate check below.
+        if (fn.fieldCode <= lastFieldCode)
+            sorted = false;
+        lastFieldCode = fn.fieldCode;
+
         // Unflatten the field
         v_.emplace_back(sit, fn, depth + 1);
 
         // If the object type has a known SOTemplate then set it.
-        if (auto const obj = dynamic_cast<STObject*>(&(v_.back().get())))
-            obj->applyTemplateFromSField(fn);  // May throw
+        if (fn.fieldType == STI_OBJECT)
+            static_cast<STObject&>(v_.back().get())
+                .applyTemplateFromSField(fn);  // May throw
     }
 
     // We want to ensure that the deserialized object does not contain any
     // duplicate fields. This is a key invariant:
-    auto const sf = getSortedFields(*this, withAllFields);
+    if (!sorted)
+    {
+        auto const sf = getSortedFields(*this, withAllFields);
 
-    auto const dup = std::adjacent_find(
-        sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
-            return lhs->getFName() == rhs->getFName();
-        });
+        auto const dup = std::adjacent_find(
+            sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
+                return lhs->getFName() == rhs->getFName();
+            });
 
-    if (dup != sf.cend())
-        Throw<std::runtime_error>("Duplicate field detected");
+        if (dup != sf.cend())
+            Throw<std::runtime_error>("Duplicate field detected");
+    }
 
     return reachedEndOfObject;
 }
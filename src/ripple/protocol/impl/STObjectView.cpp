@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STObjectView.h>
+#include <ripple/protocol/STPathSet.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+bool
+isVariableLength(int type)
+{
+    return type == STI_VL || type == STI_ACCOUNT || type == STI_VECTOR256;
+}
+
+void
+skipObject(SerialIter& sit, int depth);
+
+void
+skipIssue(SerialIter& sit)
+{
+    // The issuer is only present for currencies other than XRP
+    if (sit.get160().isNonZero())
+        sit.skip(20);
+}
+
+void
+skipPathSet(SerialIter& sit)
+{
+    for (;;)
+    {
+        auto const type = sit.get8();
+
+        if (type == STPathElement::typeNone)
+            return;
+
+        if (type == STPathElement::typeBoundary)
+            continue;
+
+        if (type & ~STPathElement::typeAll)
+            Throw<std::runtime_error>("bad path element");
+
+        if (type & STPathElement::typeAccount)
+            sit.skip(20);
+        if (type & STPathElement::typeCurrency)
+            sit.skip(20);
+        if (type & STPathElement::typeIssuer)
+            sit.skip(20);
+    }
+}
+
+void
+skipArray(SerialIter& sit, int depth)
+{
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_ARRAY && field == 1)
+            return;
+
+        if (type != STI_OBJECT || field == 1 ||
+            SField::getField(type, field).isInvalid())
+            Throw<std::runtime_error>("Illegal field in array");
+
+        skipObject(sit, depth + 1);
+    }
+}
+
+// Moves past the contents of a field, which follow its field ID
+void
+skipField(SerialIter& sit, int type, int depth)
+{
+    switch (type)
+    {
+        case STI_UINT8:
+            sit.skip(1);
+            return;
+        case STI_UINT16:
+            sit.skip(2);
+            return;
+        case STI_UINT32:
+            sit.skip(4);
+            return;
+        case STI_UINT64:
+            sit.skip(8);
+            return;
+        case STI_UINT128:
+            sit.skip(16);
+            return;
+        case STI_UINT160:
+            sit.skip(20);
+            return;
+        case STI_UINT256:
+            sit.skip(32);
+            return;
+        case STI_AMOUNT:
+            // Issued amounts are followed by a currency and an issuer
+            if (sit.get64() & STAmount::cNotNative)
+                sit.skip(40);
+            return;
+        case STI_VL:
+        case STI_ACCOUNT:
+        case STI_VECTOR256:
+            sit.skip(sit.getVLDataLength());
+            return;
+        case STI_PATHSET:
+            skipPathSet(sit);
+            return;
+        case STI_OBJECT:
+            skipObject(sit, depth + 1);
+            return;
+        case STI_ARRAY:
+            skipArray(sit, depth + 1);
+            return;
+        case STI_ISSUE:
+            skipIssue(sit);
+            return;
+        case STI_XCHAIN_BRIDGE:
+            // Two pairs of door account and issue
+            sit.skip(sit.getVLDataLength());
+            skipIssue(sit);
+            sit.skip(sit.getVLDataLength());
+            skipIssue(sit);
+            return;
+        default:
+            Throw<std::runtime_error>("Unknown object type");
+    }
+}
+
+void
+skipObject(SerialIter& sit, int depth)
+{
+    if (depth > 10)
+        Throw<std::runtime_error>("Maximum nesting depth of STObject exceeded");
+
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_OBJECT && field == 1)
+            return;
+
+        if ((type == STI_ARRAY && field == 1) ||
+            SField::getField(type, field).isInvalid())
+            Throw<std::runtime_error>("Illegal field in object");
+
+        skipField(sit, type, depth);
+    }
+}
+
+}  // namespace
+
+STObjectView::STObjectView(Slice data) : data_(data)
+{
+    SerialIter sit(data);
+    auto const offset = [&]() {
+        return static_cast<std::uint32_t>(data.size() - sit.getBytesLeft());
+    };
+
+    while (!sit.empty())
+    {
+        int type;
+        int field;
+        sit.getFieldID(type, field);
+
+        if (type == STI_OBJECT && field == 1)
+            break;
+
+        if (type == STI_ARRAY && field == 1)
+            Throw<std::runtime_error>("Illegal end-of-array marker in object");
+
+        auto const& fn = SField::getField(type, field);
+        if (fn.isInvalid())
+            Throw<std::runtime_error>("Unknown field");
+
+        if (isVariableLength(type))
+        {
+            auto const size = sit.getVLDataLength();
+            auto const start = offset();
+            sit.skip(size);
+            fields_.push_back({fn.fieldCode, start, offset() - start});
+        }
+        else
+        {
+            auto const start = offset();
+            skipField(sit, type, 0);
+            fields_.push_back({fn.fieldCode, start, offset() - start});
+        }
+    }
+}
+
+bool
+STObjectView::isFieldPresent(SField const& field) const
+{
+    return peekFieldData(field).has_value();
+}
+
+std::optional<Slice>
+STObjectView::peekFieldData(SField const& field) const
+{
+    auto const iter =
+        std::find_if(fields_.begin(), fields_.end(), [&](Field const& f) {
+            return f.code == field.fieldCode;
+        });
+    if (iter == fields_.end())
+        return std::nullopt;
+    return Slice(data_.data() + iter->offset, iter->size);
+}
+
+Slice
+STObjectView::getField(SField const& field, SerializedTypeID type) const
+{
+    if (field.fieldType != type)
+        Throw<std::runtime_error>("Wrong field type");
+
+    auto const data = peekFieldData(field);
+    if (!data)
+        Throw<std::runtime_error>("Field not found: " + field.getName());
+    return *data;
+}
+
+std::uint8_t
+STObjectView::getFieldU8(SField const& field) const
+{
+    return SerialIter(getField(field, STI_UINT8)).get8();
+}
+
+std::uint16_t
+STObjectView::getFieldU16(SField const& field) const
+{
+    return SerialIter(getField(field, STI_UINT16)).get16();
+}
+
+std::uint32_t
+STObjectView::getFieldU32(SField const& field) const
+{
+    return SerialIter(getField(field, STI_UINT32)).get32();
+}
+
+std::uint64_t
+STObjectView::getFieldU64(SField const& field) const
+{
+    return SerialIter(getField(field, STI_UINT64)).get64();
+}
+
+uint256
+STObjectView::getFieldH256(SField const& field) const
+{
+    return uint256::fromVoid(getField(field, STI_UINT256).data());
+}
+
+Slice
+STObjectView::getFieldVL(SField const& field) const
+{
+    return getField(field, STI_VL);
+}
+
+}  // namespace ripple
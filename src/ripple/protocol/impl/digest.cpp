@@ -18,10 +18,19 @@
 //==============================================================================
 
 #include <ripple/protocol/digest.h>
+#include <ripple/protocol/impl/sha512_multibuffer.h>
 #include <openssl/ripemd.h>
 #include <openssl/sha.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
 #include <type_traits>
 
+#if RIPPLE_SHA512_MULTIBUFFER && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace ripple {
 
 openssl_ripemd160_hasher::openssl_ripemd160_hasher()
@@ -103,4 +112,252 @@ openssl_sha256_hasher::operator result_type() noexcept
     return digest;
 }
 
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+namespace {
+
+#if RIPPLE_SHA512_MULTIBUFFER
+
+// A message followed by its SHA-512 padding: a one bit, zeros and the
+// length of the message in bits as a 128-bit number, filling out the last
+// block. Whole blocks are read from the message itself and only the one or
+// two blocks holding the padding are copied.
+class PaddedMessage
+{
+private:
+    std::uint8_t const* data_ = nullptr;
+    std::size_t fullBlocks_ = 0;
+    std::array<std::uint8_t, 2 * sha512BlockSize> tail_;
+
+public:
+    static std::size_t
+    blocks(std::size_t size)
+    {
+        return (size + 17 + sha512BlockSize - 1) / sha512BlockSize;
+    }
+
+    void
+    reset(Slice message)
+    {
+        data_ = message.data();
+        fullBlocks_ = message.size() / sha512BlockSize;
+
+        auto const rest = message.size() % sha512BlockSize;
+        auto const tailSize =
+            (blocks(message.size()) - fullBlocks_) * sha512BlockSize;
+
+        if (rest != 0)
+            std::memcpy(
+                tail_.data(), data_ + fullBlocks_ * sha512BlockSize, rest);
+        tail_[rest] = 0x80;
+        std::fill(tail_.begin() + rest + 1, tail_.begin() + tailSize, 0);
+
+        std::uint64_t const bits[2] = {
+            std::uint64_t(message.size()) >> 61,
+            std::uint64_t(message.size()) << 3};
+        for (int i = 0; i < 16; ++i)
+            tail_[tailSize - 16 + i] = static_cast<std::uint8_t>(
+                bits[i / 8] >> (56 - 8 * (i % 8)));
+    }
+
+    std::uint8_t const*
+    block(std::size_t i) const
+    {
+        if (i < fullBlocks_)
+            return data_ + i * sha512BlockSize;
+        return tail_.data() + (i - fullBlocks_) * sha512BlockSize;
+    }
+};
+
+constexpr std::uint64_t sha512InitialState[8] = {
+    0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL,
+    0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL};
+
+void
+hashInLanes(
+    std::size_t lanes,
+    void (*compress)(std::uint64_t*, std::uint8_t const* const*),
+    Slice const* messages,
+    uint256* digests,
+    std::size_t count)
+{
+    assert(lanes <= sha512Avx512Lanes);
+
+    // Lanes advance in lockstep, so hash together messages that pad to
+    // the same number of blocks.
+    auto const blocks = [messages](std::size_t i) {
+        return PaddedMessage::blocks(messages[i].size());
+    };
+    auto const shorter = [&blocks](std::size_t a, std::size_t b) {
+        return blocks(a) < blocks(b);
+    };
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(order.begin(), order.end(), shorter))
+        std::stable_sort(order.begin(), order.end(), shorter);
+
+    std::array<PaddedMessage, sha512Avx512Lanes> padded;
+    std::array<std::uint8_t const*, sha512Avx512Lanes> blockPointers;
+    std::array<std::uint64_t, 8 * sha512Avx512Lanes> state;
+
+    for (std::size_t first = 0; first < count;)
+    {
+        auto const n = blocks(order[first]);
+        auto last = first + 1;
+        while (last < count && last - first < lanes &&
+               blocks(order[last]) == n)
+            ++last;
+        auto const used = last - first;
+
+        // With less than half of the lanes in use, hashing the messages
+        // one at a time is at least as fast.
+        if (2 * used < lanes)
+        {
+            for (; first != last; ++first)
+                digests[order[first]] = sha512Half(messages[order[first]]);
+            continue;
+        }
+
+        // Unused lanes hash the last message again and are ignored.
+        for (std::size_t l = 0; l < lanes; ++l)
+            padded[l].reset(messages[order[first + std::min(l, used - 1)]]);
+
+        for (std::size_t w = 0; w < 8; ++w)
+            std::fill_n(state.data() + w * lanes, lanes, sha512InitialState[w]);
+
+        for (std::size_t b = 0; b < n; ++b)
+        {
+            for (std::size_t l = 0; l < lanes; ++l)
+                blockPointers[l] = padded[l].block(b);
+            compress(state.data(), blockPointers.data());
+        }
+
+        // SHA512-Half is the first four words of the state, big-endian.
+        for (std::size_t l = 0; l < used; ++l)
+        {
+            auto const out = digests[order[first + l]].data();
+            for (std::size_t w = 0; w < 4; ++w)
+            {
+                auto const word = state[w * lanes + l];
+                for (std::size_t i = 0; i < 8; ++i)
+                    out[8 * w + i] =
+                        static_cast<std::uint8_t>(word >> (56 - 8 * i));
+            }
+        }
+
+        first = last;
+    }
+}
+
+// Both checks include whether the operating system saves the wider
+// registers on a context switch.
+bool
+cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool const osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    bool const avx2 = (info[1] & (1 << 5)) != 0;
+    return osxsave && avx2 && (_xgetbv(0) & 0x06) == 0x06;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool
+cpuHasAvx512()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool const osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    bool const avx512f = (info[1] & (1 << 16)) != 0;
+    return osxsave && avx512f && (_xgetbv(0) & 0xe6) == 0xe6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+#endif
+
+}  // namespace
+
+std::vector<sha512_engine> const&
+sha512Engines()
+{
+    static std::vector<sha512_engine> const engines = [] {
+        std::vector<sha512_engine> v{sha512_engine::openssl};
+#if RIPPLE_SHA512_MULTIBUFFER
+        if (cpuHasAvx2())
+            v.push_back(sha512_engine::avx2);
+        if (cpuHasAvx512())
+            v.push_back(sha512_engine::avx512);
+#endif
+        return v;
+    }();
+    return engines;
+}
+
+void
+sha512HalfBatch(
+    sha512_engine engine,
+    Slice const* messages,
+    uint256* digests,
+    std::size_t count)
+{
+    switch (engine)
+    {
+#if RIPPLE_SHA512_MULTIBUFFER
+        case sha512_engine::avx2:
+            hashInLanes(
+                sha512Avx2Lanes,
+                &sha512CompressAvx2,
+                messages,
+                digests,
+                count);
+            return;
+        case sha512_engine::avx512:
+            hashInLanes(
+                sha512Avx512Lanes,
+                &sha512CompressAvx512,
+                messages,
+                digests,
+                count);
+            return;
+#endif
+        default:
+            for (std::size_t i = 0; i < count; ++i)
+                digests[i] = sha512Half(messages[i]);
+            return;
+    }
+}
+
+}  // namespace detail
+
+void
+sha512HalfBatch(Slice const* messages, uint256* digests, std::size_t count)
+{
+    detail::sha512HalfBatch(
+        detail::sha512Engines().back(), messages, digests, count);
+}
+
 }  // namespace ripple
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// This file is compiled with AVX2 code generation enabled. Nothing in it
+// may run before the CPU has been checked for AVX2 support.
+
+#include <ripple/protocol/impl/sha512_multibuffer.h>
+
+#if RIPPLE_SHA512_MULTIBUFFER
+
+#include <immintrin.h>
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+struct Avx2Ops
+{
+    using vector = __m256i;
+    static constexpr std::size_t lanes = sha512Avx2Lanes;
+
+    static vector
+    load(std::uint64_t const* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    }
+
+    static void
+    store(std::uint64_t* p, vector v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static vector
+    set1(std::uint64_t x)
+    {
+        return _mm256_set1_epi64x(static_cast<long long>(x));
+    }
+
+    static vector
+    add(vector a, vector b)
+    {
+        return _mm256_add_epi64(a, b);
+    }
+
+    static vector
+    xor3(vector a, vector b, vector c)
+    {
+        return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+    }
+
+    template <int N>
+    static vector
+    shr(vector x)
+    {
+        return _mm256_srli_epi64(x, N);
+    }
+
+    template <int N>
+    static vector
+    rotr(vector x)
+    {
+        return _mm256_or_si256(
+            _mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N));
+    }
+
+    // (e & f) ^ (~e & g)
+    static vector
+    ch(vector e, vector f, vector g)
+    {
+        return _mm256_xor_si256(
+            _mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    }
+
+    // (a & b) | (c & (a | b))
+    static vector
+    maj(vector a, vector b, vector c)
+    {
+        return _mm256_or_si256(
+            _mm256_and_si256(a, b),
+            _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    }
+};
+
+}  // namespace
+
+void
+sha512CompressAvx2(std::uint64_t* state, std::uint8_t const* const* blocks)
+{
+    sha512Compress<Avx2Ops>(state, blocks);
+}
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+// This file is compiled with AVX-512 code generation enabled. Nothing in it
+// may run before the CPU has been checked for AVX-512F support.
+
+#include <ripple/protocol/impl/sha512_multibuffer.h>
+
+#if RIPPLE_SHA512_MULTIBUFFER
+
+#include <immintrin.h>
+
+namespace ripple {
+namespace detail {
+
+namespace {
+
+struct Avx512Ops
+{
+    using vector = __m512i;
+    static constexpr std::size_t lanes = sha512Avx512Lanes;
+
+    static vector
+    load(std::uint64_t const* p)
+    {
+        return _mm512_loadu_si512(p);
+    }
+
+    static void
+    store(std::uint64_t* p, vector v)
+    {
+        _mm512_storeu_si512(p, v);
+    }
+
+    static vector
+    set1(std::uint64_t x)
+    {
+        return _mm512_set1_epi64(static_cast<long long>(x));
+    }
+
+    static vector
+    add(vector a, vector b)
+    {
+        return _mm512_add_epi64(a, b);
+    }
+
+    static vector
+    xor3(vector a, vector b, vector c)
+    {
+        return _mm512_ternarylogic_epi64(a, b, c, 0x96);
+    }
+
+    template <int N>
+    static vector
+    shr(vector x)
+    {
+        return _mm512_srli_epi64(x, N);
+    }
+
+    template <int N>
+    static vector
+    rotr(vector x)
+    {
+        return _mm512_ror_epi64(x, N);
+    }
+
+    // (e & f) ^ (~e & g)
+    static vector
+    ch(vector e, vector f, vector g)
+    {
+        return _mm512_ternarylogic_epi64(e, f, g, 0xca);
+    }
+
+    // (a & b) | (a & c) | (b & c)
+    static vector
+    maj(vector a, vector b, vector c)
+    {
+        return _mm512_ternarylogic_epi64(a, b, c, 0xe8);
+    }
+};
+
+}  // namespace
+
+void
+sha512CompressAvx512(std::uint64_t* state, std::uint8_t const* const* blocks)
+{
+    sha512Compress<Avx512Ops>(state, blocks);
+}
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
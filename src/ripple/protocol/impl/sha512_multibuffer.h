@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_SHA512_MULTIBUFFER_H_INCLUDED
+#define RIPPLE_PROTOCOL_SHA512_MULTIBUFFER_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ripple {
+namespace detail {
+
+/*  Multi-buffer SHA-512 compression.
+
+    Each kernel runs the SHA-512 compression function over one 128-byte
+    block for each of several independent messages, one message per SIMD
+    lane. The state of lane `l` is held word-major, so word `w` of it is
+    `state[w * lanes + l]`.
+
+    The kernels live in their own translation units, which are compiled
+    with the instruction set they need. They must only be called after
+    checking at runtime that the CPU supports it.
+*/
+
+constexpr std::size_t sha512BlockSize = 128;
+
+#if RIPPLE_SHA512_MULTIBUFFER
+
+constexpr std::size_t sha512Avx2Lanes = 4;
+constexpr std::size_t sha512Avx512Lanes = 8;
+
+void
+sha512CompressAvx2(std::uint64_t* state, std::uint8_t const* const* blocks);
+
+void
+sha512CompressAvx512(std::uint64_t* state, std::uint8_t const* const* blocks);
+
+// The compression function, written once for any lane width. Ops supplies
+// the vector type and the operations on it.
+//
+// This is in an unnamed namespace because each kernel's translation unit
+// is compiled with different code generation options, so no instantiation
+// may be shared between them by the linker.
+namespace {
+
+constexpr std::uint64_t sha512RoundConstants[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+inline std::uint64_t
+loadBigEndian64(std::uint8_t const* p)
+{
+    return (std::uint64_t(p[0]) << 56) | (std::uint64_t(p[1]) << 48) |
+        (std::uint64_t(p[2]) << 40) | (std::uint64_t(p[3]) << 32) |
+        (std::uint64_t(p[4]) << 24) | (std::uint64_t(p[5]) << 16) |
+        (std::uint64_t(p[6]) << 8) | std::uint64_t(p[7]);
+}
+
+template <class Ops>
+inline void
+sha512Compress(std::uint64_t* state, std::uint8_t const* const* blocks)
+{
+    using V = typename Ops::vector;
+    constexpr std::size_t lanes = Ops::lanes;
+
+    auto const bigSigma0 = [](V x) {
+        return Ops::xor3(
+            Ops::template rotr<28>(x),
+            Ops::template rotr<34>(x),
+            Ops::template rotr<39>(x));
+    };
+    auto const bigSigma1 = [](V x) {
+        return Ops::xor3(
+            Ops::template rotr<14>(x),
+            Ops::template rotr<18>(x),
+            Ops::template rotr<41>(x));
+    };
+    auto const smallSigma0 = [](V x) {
+        return Ops::xor3(
+            Ops::template rotr<1>(x),
+            Ops::template rotr<8>(x),
+            Ops::template shr<7>(x));
+    };
+    auto const smallSigma1 = [](V x) {
+        return Ops::xor3(
+            Ops::template rotr<19>(x),
+            Ops::template rotr<61>(x),
+            Ops::template shr<6>(x));
+    };
+
+    // The message schedule, kept as a ring of the last 16 words
+    V w[16];
+    for (std::size_t t = 0; t < 16; ++t)
+    {
+        alignas(64) std::uint64_t words[lanes];
+        for (std::size_t l = 0; l < lanes; ++l)
+            words[l] = loadBigEndian64(blocks[l] + 8 * t);
+        w[t] = Ops::load(words);
+    }
+
+    V a = Ops::load(state + 0 * lanes);
+    V b = Ops::load(state + 1 * lanes);
+    V c = Ops::load(state + 2 * lanes);
+    V d = Ops::load(state + 3 * lanes);
+    V e = Ops::load(state + 4 * lanes);
+    V f = Ops::load(state + 5 * lanes);
+    V g = Ops::load(state + 6 * lanes);
+    V h = Ops::load(state + 7 * lanes);
+
+    for (std::size_t t = 0; t < 80; ++t)
+    {
+        if (t >= 16)
+        {
+            w[t & 15] = Ops::add(
+                Ops::add(smallSigma1(w[(t - 2) & 15]), w[(t - 7) & 15]),
+                Ops::add(smallSigma0(w[(t - 15) & 15]), w[t & 15]));
+        }
+
+        V const t1 = Ops::add(
+            Ops::add(h, bigSigma1(e)),
+            Ops::add(
+                Ops::ch(e, f, g),
+                Ops::add(Ops::set1(sha512RoundConstants[t]), w[t & 15])));
+        V const t2 = Ops::add(bigSigma0(a), Ops::maj(a, b, c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = Ops::add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = Ops::add(t1, t2);
+    }
+
+    Ops::store(state + 0 * lanes, Ops::add(Ops::load(state + 0 * lanes), a));
+    Ops::store(state + 1 * lanes, Ops::add(Ops::load(state + 1 * lanes), b));
+    Ops::store(state + 2 * lanes, Ops::add(Ops::load(state + 2 * lanes), c));
+    Ops::store(state + 3 * lanes, Ops::add(Ops::load(state + 3 * lanes), d));
+    Ops::store(state + 4 * lanes, Ops::add(Ops::load(state + 4 * lanes), e));
+    Ops::store(state + 5 * lanes, Ops::add(Ops::load(state + 5 * lanes), f));
+    Ops::store(state + 6 * lanes, Ops::add(Ops::load(state + 6 * lanes), g));
+    Ops::store(state + 7 * lanes, Ops::add(Ops::load(state + 7 * lanes), h));
+}
+
+}  // namespace
+
+#endif
+
+}  // namespace detail
+}  // namespace ripple
+
+#endif
@@ -387,6 +387,7 @@ JSS(jq_trans_overflow);           // JobQueue transaction limit overflow.
 JSS(kept);                        // out: SubmitTransaction
 JSS(key);                         // out
 JSS(key_type);                    // in/out: WalletPropose, TransactionSign
+JSS(lag_s);                       // out: NetworkOPs
 JSS(latency);                     // out: PeerImp
 JSS(last);                        // out: RPCVersion
 JSS(lastSequence);                // out: NodeToShardStatus
@@ -414,6 +415,7 @@ JSS(ledger_index_max);            // in, out: AccountTx*
 JSS(ledger_index_min);            // in, out: AccountTx*
 JSS(ledger_max);                  // in, out: AccountTx*
 JSS(ledger_min);                  // in, out: AccountTx*
+JSS(ledger_publish);              // out: NetworkOPs
 JSS(ledger_time);                 // out: NetworkOPs
 JSS(LEDGER_ENTRY_TYPES);          // out: RPC server_definitions
                                   // matches definitions.json format
@@ -454,6 +456,7 @@ JSS(master_key);                  // out: WalletPropose, NetworkOPs,
 JSS(master_seed);                 // out: WalletPropose
 JSS(master_seed_hex);             // out: WalletPropose
 JSS(master_signature);            // out: pubManifest
+JSS(max_duration_us);             // out: PerfLog, NetworkOPs
 JSS(max_ledger);                  // in/out: LedgerCleaner
 JSS(max_queue_size);              // out: TxQ
 JSS(max_spend_drops);             // out: AccountInfo
@@ -517,6 +520,8 @@ JSS(open_ledger_fee);            // out: TxQ
 JSS(open_ledger_level);          // out: TxQ
 JSS(owner);                      // in: LedgerEntry, out: NetworkOPs
 JSS(owner_funds);                // in/out: Ledger, NetworkOPs, AcceptedLedgerTx
+JSS(p50_duration_us);             // out: PerfLog
+JSS(p99_duration_us);             // out: PerfLog
 JSS(page_index);
 JSS(params);                      // RPC
 JSS(parent_close_time);           // out: LedgerToJson
@@ -535,6 +540,7 @@ JSS(peers);                       // out: InboundLedger, handlers/Peers, Overlay
 JSS(peer_disconnects);            // Severed peer connection counter.
 JSS(peer_disconnects_resources);  // Severed peer connections because of
                                   // excess resource consumption.
+JSS(phases);                      // out: PerfLog
 JSS(port);                        // in: Connect, out: NetworkOPs
 JSS(ports);                       // out: NetworkOPs
 JSS(previous);                    // out: Reservations
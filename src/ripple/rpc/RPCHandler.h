@@ -25,6 +25,12 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
 
+#include <functional>
+
+namespace Json {
+class Object;
+}
+
 namespace ripple {
 namespace RPC {
 
@@ -34,6 +40,19 @@ struct JsonContext;
 Status
 doCommand(RPC::JsonContext&, Json::Value&);
 
+/** Writes the result of a request that has passed its checks. */
+using ResultWriter = std::function<void(Json::Object&)>;
+
+/** Check an RPC command whose result can be written out as it is produced.
+
+    If the request passes its checks, the writer is set and must be called
+    once to write the result. Otherwise the writer is left empty and, if the
+    request failed, the error is stored in the Json::Value as by doCommand.
+    Commands that can't be streamed must be executed by doCommand instead.
+*/
+Status
+prepareCommand(RPC::JsonContext&, Json::Value&, ResultWriter&);
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method);
 
@@ -34,6 +34,7 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace ripple {
@@ -190,7 +191,8 @@ public:
     onStopped(Server&);
 
 private:
-    Json::Value
+    // Returns the response, or nothing if it was streamed to the session.
+    std::optional<Json::Value>
     processSession(
         std::shared_ptr<WSSession> const& session,
         std::shared_ptr<JobQueue::Coro> const& coro,
@@ -201,7 +203,9 @@ private:
         std::shared_ptr<Session> const&,
         std::shared_ptr<JobQueue::Coro> coro);
 
-    void
+    // Returns whether the response is being streamed to the session, which
+    // then completes or closes the session itself.
+    bool
     processRequest(
         Port const& port,
         std::string const& request,
@@ -209,7 +213,29 @@ private:
         Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
         boost::string_view forwardedFor,
-        boost::string_view user);
+        boost::string_view user,
+        std::shared_ptr<Session> const& session = {});
+
+    // Sends the result of a request as a chunked HTTP response, writing it
+    // out as it is produced. Returns the size of the response.
+    std::size_t
+    streamResponse(
+        std::shared_ptr<Session> const& session,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        RPC::ResultWriter const& writer,
+        Json::Value const& params,
+        Resource::Consumer& usage,
+        Resource::Charge const& loadType);
+
+    // Sends the result of a request as a WebSocket message, writing it out
+    // as it is produced.
+    void
+    streamResponse(
+        std::shared_ptr<WSSession> const& session,
+        std::shared_ptr<JobQueue::Coro> const& coro,
+        RPC::ResultWriter const& writer,
+        Json::Value const& jv,
+        Resource::Charge const& loadType);
 
     Handoff
     statusResponse(http_request_type const& request) const;
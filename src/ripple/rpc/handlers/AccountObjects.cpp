@@ -19,6 +19,7 @@
 
 #include <ripple/app/main/Application.h>
 #include <ripple/app/tx/impl/details/NFTokenUtils.h>
+#include <ripple/json/Object.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
@@ -28,6 +29,7 @@
 #include <ripple/protocol/nftPageMask.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/handlers/AccountObjectsHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 
@@ -160,30 +162,32 @@ doAccountNFTs(RPC::JsonContext& context)
     return result;
 }
 
-Json::Value
-doAccountObjects(RPC::JsonContext& context)
+namespace RPC {
+
+AccountObjectsHandler::AccountObjectsHandler(JsonContext& context)
+    : context_(context)
 {
-    auto const& params = context.params;
+}
+
+Status
+AccountObjectsHandler::check()
+{
+    auto const& params = context_.params;
     if (!params.isMember(jss::account))
-        return RPC::missing_field_error(jss::account);
+        return {
+            rpcINVALID_PARAMS,
+            missing_field_message(std::string(jss::account))};
 
-    std::shared_ptr<ReadView const> ledger;
-    auto result = RPC::lookupLedger(ledger, context);
-    if (ledger == nullptr)
-        return result;
+    if (auto status = lookupLedger(ledger_, context_, result_))
+        return status;
 
     auto const id = parseBase58<AccountID>(params[jss::account].asString());
     if (!id)
-    {
-        RPC::inject_error(rpcACT_MALFORMED, result);
-        return result;
-    }
-    auto const accountID{id.value()};
+        return rpcACT_MALFORMED;
+    accountID_ = id.value();
 
-    if (!ledger->exists(keylet::account(accountID)))
-        return rpcError(rpcACT_NOT_FOUND);
-
-    std::optional<std::vector<LedgerEntryType>> typeFilter;
+    if (!ledger_->exists(keylet::account(accountID_)))
+        return rpcACT_NOT_FOUND;
 
     if (params.isMember(jss::deletion_blockers_only) &&
         params[jss::deletion_blockers_only].asBool())
@@ -203,8 +207,8 @@ doAccountObjects(RPC::JsonContext& context)
              ltXCHAIN_OWNED_CREATE_ACCOUNT_CLAIM_ID},
             {jss::bridge, ltBRIDGE}};
 
-        typeFilter.emplace();
-        typeFilter->reserve(std::size(deletionBlockers));
+        typeFilter_.emplace();
+        typeFilter_->reserve(std::size(deletionBlockers));
 
         for (auto [name, type] : deletionBlockers)
         {
@@ -213,67 +217,79 @@ doAccountObjects(RPC::JsonContext& context)
                 continue;
             }
 
-            typeFilter->push_back(type);
+            typeFilter_->push_back(type);
         }
     }
     else
     {
-        auto [rpcStatus, type] = RPC::chooseLedgerEntryType(params);
+        auto [rpcStatus, type] = chooseLedgerEntryType(params);
 
         if (rpcStatus)
-        {
-            result.clear();
-            rpcStatus.inject(result);
-            return result;
-        }
+            return rpcStatus;
         else if (type != ltANY)
-        {
-            typeFilter = std::vector<LedgerEntryType>({type});
-        }
+            typeFilter_ = std::vector<LedgerEntryType>({type});
     }
 
-    unsigned int limit;
-    if (auto err = readLimitField(limit, RPC::Tuning::accountObjects, context))
-        return *err;
+    if (auto err = readLimitField(limit_, Tuning::accountObjects, context_))
+        return {rpcINVALID_PARAMS, (*err)[jss::error_message].asString()};
 
-    uint256 dirIndex;
-    uint256 entryIndex;
     if (params.isMember(jss::marker))
     {
         auto const& marker = params[jss::marker];
         if (!marker.isString())
-            return RPC::expected_field_error(jss::marker, "string");
+            return {
+                rpcINVALID_PARAMS,
+                expected_field_message(jss::marker, "string")};
 
         std::stringstream ss(marker.asString());
         std::string s;
         if (!std::getline(ss, s, ','))
-            return RPC::invalid_field_error(jss::marker);
+            return {rpcINVALID_PARAMS, invalid_field_message(jss::marker)};
 
-        if (!dirIndex.parseHex(s))
-            return RPC::invalid_field_error(jss::marker);
+        if (!dirIndex_.parseHex(s))
+            return {rpcINVALID_PARAMS, invalid_field_message(jss::marker)};
 
         if (!std::getline(ss, s, ','))
-            return RPC::invalid_field_error(jss::marker);
+            return {rpcINVALID_PARAMS, invalid_field_message(jss::marker)};
 
-        if (!entryIndex.parseHex(s))
-            return RPC::invalid_field_error(jss::marker);
+        if (!entryIndex_.parseHex(s))
+            return {rpcINVALID_PARAMS, invalid_field_message(jss::marker)};
     }
 
-    if (!RPC::getAccountObjects(
-            *ledger,
-            accountID,
-            typeFilter,
-            dirIndex,
-            entryIndex,
-            limit,
-            result))
-    {
-        result[jss::account_objects] = Json::arrayValue;
-    }
+    context_.loadType = Resource::feeMediumBurdenRPC;
+    return Status::OK;
+}
 
-    result[jss::account] = toBase58(accountID);
-    context.loadType = Resource::feeMediumBurdenRPC;
-    return result;
+void
+AccountObjectsHandler::writeResult(Json::Value& value)
+{
+    write(value);
+}
+
+void
+AccountObjectsHandler::writeResult(Json::Object& object)
+{
+    write(object);
+}
+
+template <class Object>
+void
+AccountObjectsHandler::write(Object& result)
+{
+    Json::copyFrom(result, result_);
+
+    // If the marker does not lead anywhere, the objects are left empty.
+    getAccountObjects(
+        *ledger_,
+        accountID_,
+        typeFilter_,
+        dirIndex_,
+        entryIndex_,
+        limit_,
+        result);
+
+    result[jss::account] = toBase58(accountID_);
 }
 
+}  // namespace RPC
 }  // namespace ripple
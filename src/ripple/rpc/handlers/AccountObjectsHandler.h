@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#ifndef RIPPLE_RPC_HANDLERS_ACCOUNTOBJECTSHANDLER_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_ACCOUNTOBJECTSHANDLER_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/rpc/Role.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+
+#include <optional>
+#include <vector>
+
+namespace Json {
+class Object;
+}
+
+namespace ripple {
+namespace RPC {
+
+struct JsonContext;
+
+// {
+//   account: <account>
+//   ledger_hash: <string> // optional
+//   ledger_index: <string | unsigned integer> // optional
+//   type: <string> // optional, defaults to all account objects types
+//   deletion_blockers_only: <bool> // optional
+//   limit: <integer> // optional
+//   marker: <opaque> // optional, resume previous query
+// }
+
+class AccountObjectsHandler
+{
+public:
+    explicit AccountObjectsHandler(JsonContext&);
+
+    Status
+    check();
+
+    void
+    writeResult(Json::Value&);
+
+    void
+    writeResult(Json::Object&);
+
+    static constexpr char name[] = "account_objects";
+
+    static constexpr unsigned minApiVer = RPC::apiMinimumSupportedVersion;
+
+    static constexpr unsigned maxApiVer = RPC::apiMaximumValidVersion;
+
+    static constexpr Role role = Role::USER;
+
+    static constexpr Condition condition = NO_CONDITION;
+
+private:
+    template <class Object>
+    void
+    write(Object&);
+
+    JsonContext& context_;
+    std::shared_ptr<ReadView const> ledger_;
+    Json::Value result_;
+    AccountID accountID_;
+    std::optional<std::vector<LedgerEntryType>> typeFilter_;
+    unsigned int limit_ = 0;
+    uint256 dirIndex_;
+    uint256 entryIndex_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -25,6 +25,7 @@
 #include <ripple/app/rdb/backend/PostgresDatabase.h>
 #include <ripple/app/rdb/backend/SQLiteDatabase.h>
 #include <ripple/core/Pg.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/json_value.h>
 #include <ripple/ledger/ReadView.h>
@@ -37,6 +38,7 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/DeliveredAmount.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/handlers/AccountTxHandler.h>
 
 #include <grpcpp/grpcpp.h>
 
@@ -51,11 +53,10 @@ using AccountTxResult = RelationalDatabase::AccountTxResult;
 using LedgerShortcut = RelationalDatabase::LedgerShortcut;
 using LedgerSpecifier = RelationalDatabase::LedgerSpecifier;
 
-// parses args into a ledger specifier, or returns a Json object on error
-std::variant<std::optional<LedgerSpecifier>, Json::Value>
+// parses args into a ledger specifier, or returns the error
+std::variant<std::optional<LedgerSpecifier>, RPC::Status>
 parseLedgerArgs(RPC::Context& context, Json::Value const& params)
 {
-    Json::Value response;
     // if ledger_index_min or max is specified, then ledger_hash or ledger_index
     // should not be specified. Error out if it is
     if (context.apiVersion > 1u)
@@ -65,9 +66,7 @@ parseLedgerArgs(RPC::Context& context, Json::Value const& params)
             (params.isMember(jss::ledger_hash) ||
              params.isMember(jss::ledger_index)))
         {
-            RPC::Status status{rpcINVALID_PARAMS, "invalidParams"};
-            status.inject(response);
-            return response;
+            return RPC::Status{rpcINVALID_PARAMS, "invalidParams"};
         }
     }
     if (params.isMember(jss::ledger_index_min) ||
@@ -89,17 +88,13 @@ parseLedgerArgs(RPC::Context& context, Json::Value const& params)
         auto& hashValue = params[jss::ledger_hash];
         if (!hashValue.isString())
         {
-            RPC::Status status{rpcINVALID_PARAMS, "ledgerHashNotString"};
-            status.inject(response);
-            return response;
+            return RPC::Status{rpcINVALID_PARAMS, "ledgerHashNotString"};
         }
 
         LedgerHash hash;
         if (!hash.parseHex(hashValue.asString()))
         {
-            RPC::Status status{rpcINVALID_PARAMS, "ledgerHashMalformed"};
-            status.inject(response);
-            return response;
+            return RPC::Status{rpcINVALID_PARAMS, "ledgerHashMalformed"};
         }
         return hash;
     }
@@ -120,10 +115,8 @@ parseLedgerArgs(RPC::Context& context, Json::Value const& params)
                 ledger = LedgerShortcut::VALIDATED;
             else
             {
-                RPC::Status status{
+                return RPC::Status{
                     rpcINVALID_PARAMS, "ledger_index string malformed"};
-                status.inject(response);
-                return response;
             }
         }
         return ledger;
@@ -293,43 +286,124 @@ doAccountTxHelp(RPC::Context& context, AccountTxArgs const& args)
     return {result, rpcSUCCESS};
 }
 
-Json::Value
-populateJsonResponse(
-    std::pair<AccountTxResult, RPC::Status> const& res,
-    AccountTxArgs const& args,
-    RPC::JsonContext const& context)
+namespace RPC {
+
+AccountTxHandler::AccountTxHandler(JsonContext& context) : context_(context)
+{
+}
+
+Status
+AccountTxHandler::check()
 {
-    Json::Value response;
-    RPC::Status const& error = res.second;
-    if (error.toErrorCode() != rpcSUCCESS)
+    if (!context_.app.config().useTxTables())
+        return rpcNOT_ENABLED;
+
+    auto& params = context_.params;
+
+    // The document[https://xrpl.org/account_tx.html#account_tx] states that
+    // binary and forward params are both boolean values, however, assigning any
+    // string value works. Do not allow this. This check is for api Version 2
+    // onwards only
+    if (context_.apiVersion > 1u && params.isMember(jss::binary) &&
+        !params[jss::binary].isBool())
+    {
+        return rpcINVALID_PARAMS;
+    }
+    if (context_.apiVersion > 1u && params.isMember(jss::forward) &&
+        !params[jss::forward].isBool())
+    {
+        return rpcINVALID_PARAMS;
+    }
+
+    args_.limit = params.isMember(jss::limit) ? params[jss::limit].asUInt() : 0;
+    args_.binary = params.isMember(jss::binary) && params[jss::binary].asBool();
+    args_.forward =
+        params.isMember(jss::forward) && params[jss::forward].asBool();
+
+    if (!params.isMember(jss::account))
+        return rpcINVALID_PARAMS;
+
+    auto const account =
+        parseBase58<AccountID>(params[jss::account].asString());
+    if (!account)
+        return rpcACT_MALFORMED;
+
+    args_.account = *account;
+
+    auto parseRes = parseLedgerArgs(context_, params);
+    if (auto status = std::get_if<Status>(&parseRes))
     {
-        error.inject(response);
+        return *status;
     }
     else
     {
-        AccountTxResult const& result = res.first;
-        response[jss::validated] = true;
-        response[jss::limit] = result.limit;
-        response[jss::account] = context.params[jss::account].asString();
-        response[jss::ledger_index_min] = result.ledgerRange.min;
-        response[jss::ledger_index_max] = result.ledgerRange.max;
+        args_.ledger = std::get<std::optional<LedgerSpecifier>>(parseRes);
+    }
 
-        Json::Value& jvTxns = (response[jss::transactions] = Json::arrayValue);
+    if (params.isMember(jss::marker))
+    {
+        auto& token = params[jss::marker];
+        if (!token.isMember(jss::ledger) || !token.isMember(jss::seq) ||
+            !token[jss::ledger].isConvertibleTo(Json::ValueType::uintValue) ||
+            !token[jss::seq].isConvertibleTo(Json::ValueType::uintValue))
+        {
+            return {
+                rpcINVALID_PARAMS,
+                "invalid marker. Provide ledger index via ledger field, and "
+                "transaction sequence number via seq field"};
+        }
+        args_.marker = {token[jss::ledger].asUInt(), token[jss::seq].asUInt()};
+    }
+
+    auto res = doAccountTxHelp(context_, args_);
+    if (res.second.toErrorCode() != rpcSUCCESS)
+        return res.second;
+
+    result_ = std::move(res.first);
+    return Status::OK;
+}
+
+void
+AccountTxHandler::writeResult(Json::Value& value)
+{
+    write(value);
+}
+
+void
+AccountTxHandler::writeResult(Json::Object& object)
+{
+    write(object);
+}
+
+template <class Object>
+void
+AccountTxHandler::write(Object& response)
+{
+    JLOG(context_.j.debug()) << __func__ << " populating response";
 
-        if (auto txnsData = std::get_if<TxnsData>(&result.transactions))
+    response[jss::validated] = true;
+    response[jss::limit] = result_.limit;
+    response[jss::account] = context_.params[jss::account].asString();
+    response[jss::ledger_index_min] = result_.ledgerRange.min;
+    response[jss::ledger_index_max] = result_.ledgerRange.max;
+
+    {
+        auto&& jvTxns = Json::setArray(response, jss::transactions);
+
+        if (auto txnsData = std::get_if<TxnsData>(&result_.transactions))
         {
-            assert(!args.binary);
+            assert(!args_.binary);
 
             for (auto const& [txn, txnMeta] : *txnsData)
             {
                 if (txn)
                 {
-                    Json::Value& jvObj = jvTxns.append(Json::objectValue);
+                    Json::Value jvObj(Json::objectValue);
                     jvObj[jss::validated] = true;
 
                     auto const json_tx =
-                        (context.apiVersion > 1 ? jss::tx_json : jss::tx);
-                    if (context.apiVersion > 1)
+                        (context_.apiVersion > 1 ? jss::tx_json : jss::tx);
+                    if (context_.apiVersion > 1)
                     {
                         jvObj[json_tx] = txn->getJson(
                             JsonOptions::include_date |
@@ -338,11 +412,11 @@ populateJsonResponse(
                         jvObj[jss::hash] = to_string(txn->getID());
                         jvObj[jss::ledger_index] = txn->getLedger();
                         jvObj[jss::ledger_hash] =
-                            to_string(context.ledgerMaster.getHashBySeq(
+                            to_string(context_.ledgerMaster.getHashBySeq(
                                 txn->getLedger()));
 
                         if (auto closeTime =
-                                context.ledgerMaster.getCloseTimeBySeq(
+                                context_.ledgerMaster.getCloseTimeBySeq(
                                     txn->getLedger()))
                             jvObj[jss::close_time_iso] =
                                 to_string_iso(*closeTime);
@@ -352,133 +426,55 @@ populateJsonResponse(
                             txn->getJson(JsonOptions::include_date);
 
                     auto const& sttx = txn->getSTransaction();
-                    RPC::insertDeliverMax(
-                        jvObj[json_tx], sttx->getTxnType(), context.apiVersion);
+                    insertDeliverMax(
+                        jvObj[json_tx],
+                        sttx->getTxnType(),
+                        context_.apiVersion);
                     if (txnMeta)
                     {
                         jvObj[jss::meta] =
                             txnMeta->getJson(JsonOptions::include_date);
                         insertDeliveredAmount(
-                            jvObj[jss::meta], context, txn, *txnMeta);
+                            jvObj[jss::meta], context_, txn, *txnMeta);
                         insertNFTSyntheticInJson(jvObj, sttx, *txnMeta);
                     }
                     else
                         assert(false && "Missing transaction medatata");
+
+                    jvTxns.append(std::move(jvObj));
                 }
             }
         }
         else
         {
-            assert(args.binary);
+            assert(args_.binary);
 
             for (auto const& binaryData :
-                 std::get<TxnsDataBinary>(result.transactions))
+                 std::get<TxnsDataBinary>(result_.transactions))
             {
-                Json::Value& jvObj = jvTxns.append(Json::objectValue);
+                auto&& jvObj = Json::appendObject(jvTxns);
 
                 jvObj[jss::tx_blob] = strHex(std::get<0>(binaryData));
                 auto const json_meta =
-                    (context.apiVersion > 1 ? jss::meta_blob : jss::meta);
+                    (context_.apiVersion > 1 ? jss::meta_blob : jss::meta);
                 jvObj[json_meta] = strHex(std::get<1>(binaryData));
                 jvObj[jss::ledger_index] = std::get<2>(binaryData);
                 jvObj[jss::validated] = true;
             }
         }
-
-        if (result.marker)
-        {
-            response[jss::marker] = Json::objectValue;
-            response[jss::marker][jss::ledger] = result.marker->ledgerSeq;
-            response[jss::marker][jss::seq] = result.marker->txnSeq;
-        }
-        if (context.app.config().reporting())
-            response["used_postgres"] = true;
     }
 
-    JLOG(context.j.debug()) << __func__ << " : finished";
-    return response;
-}
-
-// {
-//   account: account,
-//   ledger_index_min: ledger_index  // optional, defaults to earliest
-//   ledger_index_max: ledger_index, // optional, defaults to latest
-//   binary: boolean,                // optional, defaults to false
-//   forward: boolean,               // optional, defaults to false
-//   limit: integer,                 // optional
-//   marker: object {ledger: ledger_index, seq: txn_sequence} // optional,
-//   resume previous query
-// }
-Json::Value
-doAccountTxJson(RPC::JsonContext& context)
-{
-    if (!context.app.config().useTxTables())
-        return rpcError(rpcNOT_ENABLED);
-
-    auto& params = context.params;
-    AccountTxArgs args;
-    Json::Value response;
-
-    // The document[https://xrpl.org/account_tx.html#account_tx] states that
-    // binary and forward params are both boolean values, however, assigning any
-    // string value works. Do not allow this. This check is for api Version 2
-    // onwards only
-    if (context.apiVersion > 1u && params.isMember(jss::binary) &&
-        !params[jss::binary].isBool())
-    {
-        return rpcError(rpcINVALID_PARAMS);
-    }
-    if (context.apiVersion > 1u && params.isMember(jss::forward) &&
-        !params[jss::forward].isBool())
+    if (result_.marker)
     {
-        return rpcError(rpcINVALID_PARAMS);
-    }
-
-    args.limit = params.isMember(jss::limit) ? params[jss::limit].asUInt() : 0;
-    args.binary = params.isMember(jss::binary) && params[jss::binary].asBool();
-    args.forward =
-        params.isMember(jss::forward) && params[jss::forward].asBool();
-
-    if (!params.isMember(jss::account))
-        return rpcError(rpcINVALID_PARAMS);
-
-    auto const account =
-        parseBase58<AccountID>(params[jss::account].asString());
-    if (!account)
-        return rpcError(rpcACT_MALFORMED);
-
-    args.account = *account;
-
-    auto parseRes = parseLedgerArgs(context, params);
-    if (auto jv = std::get_if<Json::Value>(&parseRes))
-    {
-        return *jv;
-    }
-    else
-    {
-        args.ledger = std::get<std::optional<LedgerSpecifier>>(parseRes);
-    }
-
-    if (params.isMember(jss::marker))
-    {
-        auto& token = params[jss::marker];
-        if (!token.isMember(jss::ledger) || !token.isMember(jss::seq) ||
-            !token[jss::ledger].isConvertibleTo(Json::ValueType::uintValue) ||
-            !token[jss::seq].isConvertibleTo(Json::ValueType::uintValue))
-        {
-            RPC::Status status{
-                rpcINVALID_PARAMS,
-                "invalid marker. Provide ledger index via ledger field, and "
-                "transaction sequence number via seq field"};
-            status.inject(response);
-            return response;
-        }
-        args.marker = {token[jss::ledger].asUInt(), token[jss::seq].asUInt()};
+        auto&& marker = Json::addObject(response, jss::marker);
+        marker[jss::ledger] = result_.marker->ledgerSeq;
+        marker[jss::seq] = result_.marker->txnSeq;
     }
+    if (context_.app.config().reporting())
+        response["used_postgres"] = true;
 
-    auto res = doAccountTxHelp(context, args);
-    JLOG(context.j.debug()) << __func__ << " populating response";
-    return populateJsonResponse(res, args, context);
+    JLOG(context_.j.debug()) << __func__ << " : finished";
 }
 
+}  // namespace RPC
 }  // namespace ripple
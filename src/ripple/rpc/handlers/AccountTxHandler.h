@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#ifndef RIPPLE_RPC_HANDLERS_ACCOUNTTXHANDLER_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_ACCOUNTTXHANDLER_H_INCLUDED
+
+#include <ripple/app/rdb/RelationalDatabase.h>
+#include <ripple/rpc/Role.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+
+namespace Json {
+class Object;
+}
+
+namespace ripple {
+namespace RPC {
+
+struct JsonContext;
+
+// {
+//   account: account,
+//   ledger_index_min: ledger_index  // optional, defaults to earliest
+//   ledger_index_max: ledger_index, // optional, defaults to latest
+//   binary: boolean,                // optional, defaults to false
+//   forward: boolean,               // optional, defaults to false
+//   limit: integer,                 // optional
+//   marker: object {ledger: ledger_index, seq: txn_sequence} // optional,
+//   resume previous query
+// }
+
+class AccountTxHandler
+{
+public:
+    explicit AccountTxHandler(JsonContext&);
+
+    Status
+    check();
+
+    void
+    writeResult(Json::Value&);
+
+    void
+    writeResult(Json::Object&);
+
+    static constexpr char name[] = "account_tx";
+
+    static constexpr unsigned minApiVer = RPC::apiMinimumSupportedVersion;
+
+    static constexpr unsigned maxApiVer = RPC::apiMaximumValidVersion;
+
+    static constexpr Role role = Role::USER;
+
+    static constexpr Condition condition = NO_CONDITION;
+
+private:
+    template <class Object>
+    void
+    write(Object&);
+
+    JsonContext& context_;
+    RelationalDatabase::AccountTxArgs args_;
+    RelationalDatabase::AccountTxResult result_;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
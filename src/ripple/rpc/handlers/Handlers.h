@@ -35,12 +35,8 @@ doAccountChannels(RPC::JsonContext&);
 Json::Value
 doAccountNFTs(RPC::JsonContext&);
 Json::Value
-doAccountObjects(RPC::JsonContext&);
-Json::Value
 doAccountOffers(RPC::JsonContext&);
 Json::Value
-doAccountTxJson(RPC::JsonContext&);
-Json::Value
 doAMMInfo(RPC::JsonContext&);
 Json::Value
 doBookOffers(RPC::JsonContext&);
@@ -81,8 +77,6 @@ doLedgerClosed(RPC::JsonContext&);
 Json::Value
 doLedgerCurrent(RPC::JsonContext&);
 Json::Value
-doLedgerData(RPC::JsonContext&);
-Json::Value
 doLedgerEntry(RPC::JsonContext&);
 Json::Value
 doLedgerHeader(RPC::JsonContext&);
@@ -25,112 +25,135 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/GRPCHandlers.h>
 #include <ripple/rpc/Role.h>
+#include <ripple/rpc/handlers/LedgerDataHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/impl/Tuning.h>
 
 namespace ripple {
 
-// Get state nodes from a ledger
-//   Inputs:
-//     limit:        integer, maximum number of entries
-//     marker:       opaque, resume point
-//     binary:       boolean, format
-//     type:         string // optional, defaults to all ledger node types
-//   Outputs:
-//     ledger_hash:  chosen ledger's hash
-//     ledger_index: chosen ledger's index
-//     state:        array of state nodes
-//     marker:       resume point, if any
-Json::Value
-doLedgerData(RPC::JsonContext& context)
+namespace RPC {
+
+LedgerDataHandler::LedgerDataHandler(JsonContext& context) : context_(context)
+{
+}
+
+Status
+LedgerDataHandler::check()
 {
-    std::shared_ptr<ReadView const> lpLedger;
-    auto const& params = context.params;
+    auto const& params = context_.params;
 
-    auto jvResult = RPC::lookupLedger(lpLedger, context);
-    if (!lpLedger)
-        return jvResult;
+    if (auto status = lookupLedger(ledger_, context_, result_))
+        return status;
 
-    bool const isMarker = params.isMember(jss::marker);
-    ReadView::key_type key = ReadView::key_type();
-    if (isMarker)
+    if (params.isMember(jss::marker))
     {
         Json::Value const& jMarker = params[jss::marker];
+        ReadView::key_type key;
         if (!(jMarker.isString() && key.parseHex(jMarker.asString())))
-            return RPC::expected_field_error(jss::marker, "valid");
+            return {
+                rpcINVALID_PARAMS,
+                expected_field_message(jss::marker, "valid")};
+        marker_ = key;
     }
 
-    bool const isBinary = params[jss::binary].asBool();
+    binary_ = params[jss::binary].asBool();
 
-    int limit = -1;
     if (params.isMember(jss::limit))
     {
         Json::Value const& jLimit = params[jss::limit];
         if (!jLimit.isIntegral())
-            return RPC::expected_field_error(jss::limit, "integer");
+            return {
+                rpcINVALID_PARAMS,
+                expected_field_message(jss::limit, "integer")};
 
-        limit = jLimit.asInt();
+        limit_ = jLimit.asInt();
     }
 
-    auto maxLimit = RPC::Tuning::pageLength(isBinary);
-    if ((limit < 0) || ((limit > maxLimit) && (!isUnlimited(context.role))))
-        limit = maxLimit;
+    auto maxLimit = Tuning::pageLength(binary_);
+    if ((limit_ < 0) || ((limit_ > maxLimit) && (!isUnlimited(context_.role))))
+        limit_ = maxLimit;
 
-    jvResult[jss::ledger_hash] = to_string(lpLedger->info().hash);
-    jvResult[jss::ledger_index] = lpLedger->info().seq;
-
-    if (!isMarker)
-    {
-        // Return base ledger data on first query
-        jvResult[jss::ledger] = getJson(LedgerFill(
-            *lpLedger, &context, isBinary ? LedgerFill::Options::binary : 0));
-    }
+    result_[jss::ledger_hash] = to_string(ledger_->info().hash);
+    result_[jss::ledger_index] = ledger_->info().seq;
 
-    auto [rpcStatus, type] = RPC::chooseLedgerEntryType(params);
+    auto [rpcStatus, type] = chooseLedgerEntryType(params);
     if (rpcStatus)
+        return rpcStatus;
+    type_ = type;
+
+    return Status::OK;
+}
+
+void
+LedgerDataHandler::writeResult(Json::Value& value)
+{
+    write(value);
+}
+
+void
+LedgerDataHandler::writeResult(Json::Object& object)
+{
+    write(object);
+}
+
+template <class Object>
+void
+LedgerDataHandler::write(Object& result)
+{
+    Json::copyFrom(result, result_);
+
+    if (!marker_)
     {
-        jvResult.clear();
-        rpcStatus.inject(jvResult);
-        return jvResult;
-    }
-    Json::Value& nodes = jvResult[jss::state];
-    if (nodes.type() == Json::nullValue)
-    {
-        nodes = Json::Value(Json::arrayValue);
+        // Return base ledger data on first query
+        result[jss::ledger] = getJson(LedgerFill(
+            *ledger_, &context_, binary_ ? LedgerFill::Options::binary : 0));
     }
 
-    auto e = lpLedger->sles.end();
-    for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
+    // The state nodes are written out one at a time, and the marker can only
+    // follow once they all have been.
+    std::optional<ReadView::key_type> marker;
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
-        if (limit-- <= 0)
-        {
-            // Stop processing before the current key.
-            auto k = sle->key();
-            jvResult[jss::marker] = to_string(--k);
-            break;
-        }
+        auto&& nodes = Json::setArray(result, jss::state);
 
-        if (type == ltANY || sle->getType() == type)
+        auto limit = limit_;
+        auto e = ledger_->sles.end();
+        for (auto i = ledger_->sles.upper_bound(marker_.value_or(beast::zero));
+             i != e;
+             ++i)
         {
-            if (isBinary)
+            auto sle = ledger_->read(keylet::unchecked((*i)->key()));
+            if (limit-- <= 0)
             {
-                Json::Value& entry = nodes.append(Json::objectValue);
-                entry[jss::data] = serializeHex(*sle);
-                entry[jss::index] = to_string(sle->key());
+                // Stop processing before the current key.
+                auto k = sle->key();
+                marker = --k;
+                break;
             }
-            else
+
+            if (type_ == ltANY || sle->getType() == type_)
             {
-                Json::Value& entry =
-                    nodes.append(sle->getJson(JsonOptions::none));
-                entry[jss::index] = to_string(sle->key());
+                if (binary_)
+                {
+                    auto&& entry = Json::appendObject(nodes);
+                    entry[jss::data] = serializeHex(*sle);
+                    entry[jss::index] = to_string(sle->key());
+                }
+                else
+                {
+                    auto entry = sle->getJson(JsonOptions::none);
+                    entry[jss::index] = to_string(sle->key());
+                    nodes.append(std::move(entry));
+                }
             }
         }
     }
 
-    return jvResult;
+    if (marker)
+        result[jss::marker] = to_string(*marker);
 }
 
+}  // namespace RPC
+
 std::pair<org::xrpl::rpc::v1::GetLedgerDataResponse, grpc::Status>
 doLedgerDataGrpc(
     RPC::GRPCContext<org::xrpl::rpc::v1::GetLedgerDataRequest>& context)
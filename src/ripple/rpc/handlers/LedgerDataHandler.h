@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#ifndef RIPPLE_RPC_HANDLERS_LEDGERDATAHANDLER_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_LEDGERDATAHANDLER_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/rpc/Role.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+
+namespace Json {
+class Object;
+}
+
+namespace ripple {
+namespace RPC {
+
+struct JsonContext;
+
+// Get state nodes from a ledger
+//   Inputs:
+//     limit:        integer, maximum number of entries
+//     marker:       opaque, resume point
+//     binary:       boolean, format
+//     type:         string // optional, defaults to all ledger node types
+//   Outputs:
+//     ledger_hash:  chosen ledger's hash
+//     ledger_index: chosen ledger's index
+//     state:        array of state nodes
+//     marker:       resume point, if any
+
+class LedgerDataHandler
+{
+public:
+    explicit LedgerDataHandler(JsonContext&);
+
+    Status
+    check();
+
+    void
+    writeResult(Json::Value&);
+
+    void
+    writeResult(Json::Object&);
+
+    static constexpr char name[] = "ledger_data";
+
+    static constexpr unsigned minApiVer = RPC::apiMinimumSupportedVersion;
+
+    static constexpr unsigned maxApiVer = RPC::apiMaximumValidVersion;
+
+    static constexpr Role role = Role::USER;
+
+    static constexpr Condition condition = NO_CONDITION;
+
+private:
+    template <class Object>
+    void
+    write(Object&);
+
+    JsonContext& context_;
+    std::shared_ptr<ReadView const> ledger_;
+    Json::Value result_;
+    std::optional<ReadView::key_type> marker_;
+    bool binary_ = false;
+    int limit_ = -1;
+    LedgerEntryType type_ = ltANY;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
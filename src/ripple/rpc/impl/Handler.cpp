@@ -18,7 +18,10 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/rpc/handlers/AccountObjectsHandler.h>
+#include <ripple/rpc/handlers/AccountTxHandler.h>
 #include <ripple/rpc/handlers/Handlers.h>
+#include <ripple/rpc/handlers/LedgerDataHandler.h>
 #include <ripple/rpc/handlers/Version.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
@@ -63,6 +66,25 @@ handle(JsonContext& context, Object& object)
     return status;
 }
 
+template <class HandlerImpl>
+Status
+prepare(JsonContext& context, ResultWriter& writer)
+{
+    assert(
+        context.apiVersion >= HandlerImpl::minApiVer &&
+        context.apiVersion <= HandlerImpl::maxApiVer);
+    auto handler = std::make_shared<HandlerImpl>(context);
+
+    auto status = handler->check();
+    if (!status)
+    {
+        writer = [handler](Json::Object& object) {
+            handler->writeResult(object);
+        };
+    }
+    return status;
+}
+
 template <typename HandlerImpl>
 Handler
 handlerFrom()
@@ -73,7 +95,8 @@ handlerFrom()
         HandlerImpl::role,
         HandlerImpl::condition,
         HandlerImpl::minApiVer,
-        HandlerImpl::maxApiVer};
+        HandlerImpl::maxApiVer,
+        &prepare<HandlerImpl>};
 }
 
 Handler const handlerArray[]{
@@ -87,9 +110,7 @@ Handler const handlerArray[]{
     {"account_lines", byRef(&doAccountLines), Role::USER, NO_CONDITION},
     {"account_channels", byRef(&doAccountChannels), Role::USER, NO_CONDITION},
     {"account_nfts", byRef(&doAccountNFTs), Role::USER, NO_CONDITION},
-    {"account_objects", byRef(&doAccountObjects), Role::USER, NO_CONDITION},
     {"account_offers", byRef(&doAccountOffers), Role::USER, NO_CONDITION},
-    {"account_tx", byRef(&doAccountTxJson), Role::USER, NO_CONDITION},
     {"amm_info", byRef(&doAMMInfo), Role::USER, NO_CONDITION},
     {"blacklist", byRef(&doBlackList), Role::ADMIN, NO_CONDITION},
     {"book_changes", byRef(&doBookChanges), Role::USER, NO_CONDITION},
@@ -127,7 +148,6 @@ Handler const handlerArray[]{
      byRef(&doLedgerCurrent),
      Role::USER,
      NEEDS_CURRENT_LEDGER},
-    {"ledger_data", byRef(&doLedgerData), Role::USER, NO_CONDITION},
     {"ledger_entry", byRef(&doLedgerEntry), Role::USER, NO_CONDITION},
     {"ledger_header", byRef(&doLedgerHeader), Role::USER, NO_CONDITION, 1, 1},
     {"ledger_request", byRef(&doLedgerRequest), Role::ADMIN, NO_CONDITION},
@@ -236,6 +256,9 @@ private:
         }
 
         // This is where the new-style handlers are added.
+        addHandler<AccountObjectsHandler>();
+        addHandler<AccountTxHandler>();
+        addHandler<LedgerDataHandler>();
         addHandler<LedgerHandler>();
         addHandler<VersionHandler>();
     }
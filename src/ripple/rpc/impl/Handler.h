@@ -49,6 +49,11 @@ struct Handler
     template <class JsonValue>
     using Method = std::function<Status(JsonContext&, JsonValue&)>;
 
+    /** Checks a request and, if it can be served, sets a writer that
+        streams its result instead of building a Json::Value.
+    */
+    using StreamMethod = std::function<Status(JsonContext&, ResultWriter&)>;
+
     const char* name_;
     Method<Json::Value> valueMethod_;
     Role role_;
@@ -56,6 +61,9 @@ struct Handler
 
     unsigned minApiVer_ = apiMinimumSupportedVersion;
     unsigned maxApiVer_ = apiMaximumValidVersion;
+
+    // Empty for handlers that can only build a Json::Value.
+    StreamMethod streamMethod_ = {};
 };
 
 Handler const*
@@ -129,6 +129,9 @@ namespace {
 
  */
 
+// Identifies each request to the PerfLog.
+std::atomic<std::uint64_t> requestId{0};
+
 error_code_i
 fillHandler(JsonContext& context, Handler const*& result)
 {
@@ -187,7 +190,6 @@ callMethod(
     std::string const& name,
     Object& result)
 {
-    static std::atomic<std::uint64_t> requestId{0};
     auto& perfLog = context.app.getPerfLog();
     std::uint64_t const curId = ++requestId;
     try
@@ -293,6 +295,88 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
     return rpcUNKNOWN_COMMAND;
 }
 
+Status
+prepareCommand(
+    RPC::JsonContext& context,
+    Json::Value& result,
+    ResultWriter& writer)
+{
+    // Reporting servers may forward a request, or warn about what they
+    // return, so they always build the result.
+    if (context.app.config().reporting())
+        return rpcSUCCESS;
+
+    Handler const* handler = nullptr;
+    if (auto error = fillHandler(context, handler))
+    {
+        inject_error(error, result);
+        return error;
+    }
+
+    auto method = handler->streamMethod_;
+    if (!method)
+        return rpcSUCCESS;
+
+    std::string const name = handler->name_;
+    auto& perfLog = context.app.getPerfLog();
+    std::uint64_t const curId = ++requestId;
+
+    auto const onError = [&context, &perfLog, name, curId](
+                             std::exception const& e) {
+        perfLog.rpcError(name, curId);
+        JLOG(context.j.info()) << "Caught throw: " << e.what();
+
+        if (context.loadType == Resource::feeReferenceRPC)
+            context.loadType = Resource::feeExceptionRPC;
+    };
+
+    perfLog.rpcStart(name, curId);
+    auto const start = std::chrono::system_clock::now();
+
+    ResultWriter write;
+    try
+    {
+        // Writing the result waits on the client whenever it falls behind,
+        // so only the checks count towards the server's load.
+        auto v =
+            context.app.getJobQueue().makeLoadEvent(jtGENERIC, "cmd:" + name);
+
+        if (auto status = method(context, write))
+        {
+            perfLog.rpcFinish(name, curId);
+            status.inject(result);
+            return status;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        onError(e);
+        inject_error(rpcINTERNAL, result);
+        return rpcINTERNAL;
+    }
+
+    // The request can only fail from here on after some of the result has
+    // been written, so the caller has to give up on the response.
+    writer = [=, &context](Json::Object& object) {
+        try
+        {
+            write(object);
+        }
+        catch (std::exception const& e)
+        {
+            onError(e);
+            throw;
+        }
+
+        auto end = std::chrono::system_clock::now();
+        JLOG(context.j.debug())
+            << "RPC call " << name << " completed in "
+            << ((end - start).count() / 1000000000.0) << "seconds";
+        context.app.getPerfLog().rpcFinish(name, curId);
+    };
+    return rpcSUCCESS;
+}
+
 Role
 roleRequired(unsigned int version, bool betaEnabled, std::string const& method)
 {
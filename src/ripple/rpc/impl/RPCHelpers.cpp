@@ -148,15 +148,21 @@ isRelatedToAccount(
     return false;
 }
 
+namespace {
+
+// Appends the objects to an array, which must be closed before the marker
+// to resume from, if any, can be added to the result.
+template <class Array>
 bool
-getAccountObjects(
+appendAccountObjects(
     ReadView const& ledger,
     AccountID const& account,
     std::optional<std::vector<LedgerEntryType>> const& typeFilter,
     uint256 dirIndex,
     uint256 entryIndex,
     std::uint32_t const limit,
-    Json::Value& jvResult)
+    Array& jvObjects,
+    std::optional<std::string>& marker)
 {
     auto typeMatchesFilter = [](std::vector<LedgerEntryType> const& typeFilter,
                                 LedgerEntryType ledgerType) {
@@ -183,8 +189,6 @@ getAccountObjects(
             iterateNFTPages = false;
     }
 
-    auto& jvObjects = (jvResult[jss::account_objects] = Json::arrayValue);
-
     // this is a mutable version of limit, used to seemlessly switch
     // to iterating directory entries when nftokenpages are exhausted
     uint32_t mlimit = limit;
@@ -217,8 +221,7 @@ getAccountObjects(
             {
                 if (cp)
                 {
-                    jvResult[jss::limit] = limit;
-                    jvResult[jss::marker] = std::string("0,") + to_string(ck);
+                    marker = std::string("0,") + to_string(ck);
                     return true;
                 }
             }
@@ -272,9 +275,7 @@ getAccountObjects(
         // response.  Check for that condition.
         if (i == mlimit && mlimit < limit)
         {
-            jvResult[jss::limit] = limit;
-            jvResult[jss::marker] =
-                to_string(dirIndex) + ',' + to_string(*iter);
+            marker = to_string(dirIndex) + ',' + to_string(*iter);
             return true;
         }
 
@@ -292,9 +293,7 @@ getAccountObjects(
             {
                 if (++iter != entries.end())
                 {
-                    jvResult[jss::limit] = limit;
-                    jvResult[jss::marker] =
-                        to_string(dirIndex) + ',' + to_string(*iter);
+                    marker = to_string(dirIndex) + ',' + to_string(*iter);
                     return true;
                 }
 
@@ -316,9 +315,7 @@ getAccountObjects(
             auto const& e = dir->getFieldV256(sfIndexes);
             if (!e.empty())
             {
-                jvResult[jss::limit] = limit;
-                jvResult[jss::marker] =
-                    to_string(dirIndex) + ',' + to_string(*e.begin());
+                marker = to_string(dirIndex) + ',' + to_string(*e.begin());
             }
 
             return true;
@@ -326,6 +323,70 @@ getAccountObjects(
     }
 }
 
+template <class Object>
+bool
+getAccountObjectsImpl(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    Object& jvResult)
+{
+    std::optional<std::string> marker;
+    bool result;
+    {
+        auto&& jvObjects = Json::setArray(jvResult, jss::account_objects);
+        result = appendAccountObjects(
+            ledger,
+            account,
+            typeFilter,
+            dirIndex,
+            entryIndex,
+            limit,
+            jvObjects,
+            marker);
+    }
+
+    if (marker)
+    {
+        jvResult[jss::limit] = limit;
+        jvResult[jss::marker] = *marker;
+    }
+    return result;
+}
+
+}  // namespace
+
+bool
+getAccountObjects(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    Json::Value& jvResult)
+{
+    return getAccountObjectsImpl(
+        ledger, account, typeFilter, dirIndex, entryIndex, limit, jvResult);
+}
+
+bool
+getAccountObjects(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    Json::Object& jvResult)
+{
+    return getAccountObjectsImpl(
+        ledger, account, typeFilter, dirIndex, entryIndex, limit, jvResult);
+}
+
 namespace {
 
 bool
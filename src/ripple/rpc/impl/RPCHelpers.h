@@ -36,6 +36,7 @@
 #include <variant>
 
 namespace Json {
+class Object;
 class Value;
 }
 
@@ -112,6 +113,16 @@ getAccountObjects(
     std::uint32_t const limit,
     Json::Value& jvResult);
 
+bool
+getAccountObjects(
+    ReadView const& ledger,
+    AccountID const& account,
+    std::optional<std::vector<LedgerEntryType>> const& typeFilter,
+    uint256 dirIndex,
+    uint256 entryIndex,
+    std::uint32_t const limit,
+    Json::Object& jvResult);
+
 /** Get ledger by hash
     If there is no error in the return value, the ledger pointer will have
     been filled
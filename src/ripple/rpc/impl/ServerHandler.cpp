@@ -28,6 +28,7 @@
 #include <ripple/beast/net/IPAddressConversion.h>
 #include <ripple/beast/rfc2616.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCErr.h>
@@ -38,6 +39,7 @@
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/impl/StreamedResponse.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <ripple/rpc/json_body.h>
 #include <ripple/server/Server.h>
@@ -346,7 +348,9 @@ ServerHandler::onWSMessage(
         [this, session, jv = std::move(jv)](
             std::shared_ptr<JobQueue::Coro> const& coro) {
             auto const jr = this->processSession(session, coro, jv);
-            auto const s = to_string(jr);
+            if (!jr)
+                return;
+            auto const s = to_string(*jr);
             auto const n = s.length();
             boost::beast::multi_buffer sb(n);
             sb.commit(boost::asio::buffer_copy(
@@ -398,7 +402,7 @@ logDuration(
                 << " microseconds. request = " << request;
 }
 
-Json::Value
+std::optional<Json::Value>
 ServerHandler::processSession(
     std::shared_ptr<WSSession> const& session,
     std::shared_ptr<JobQueue::Coro> const& coro,
@@ -480,9 +484,18 @@ ServerHandler::processSession(
                 {is->user(), is->forwarded_for()}};
 
             auto start = std::chrono::system_clock::now();
-            RPC::doCommand(context, jr[jss::result]);
+            RPC::ResultWriter writer;
+            if (!RPC::prepareCommand(context, jr[jss::result], writer) &&
+                !writer)
+                RPC::doCommand(context, jr[jss::result]);
             auto end = std::chrono::system_clock::now();
             logDuration(jv, end - start, m_journal);
+
+            if (writer)
+            {
+                streamResponse(session, coro, writer, jv, loadType);
+                return std::nullopt;
+            }
         }
     }
     catch (std::exception const& ex)
@@ -550,7 +563,7 @@ ServerHandler::processSession(
     std::shared_ptr<Session> const& session,
     std::shared_ptr<JobQueue::Coro> coro)
 {
-    processRequest(
+    auto const streamed = processRequest(
         session->port(),
         buffers_to_string(session->request().body().data()),
         session->remoteAddress().at_port(0),
@@ -562,7 +575,11 @@ ServerHandler::processSession(
             if (iter != session->request().end())
                 return iter->value();
             return boost::beast::string_view{};
-        }());
+        }(),
+        session);
+
+    if (streamed)
+        return;
 
     if (beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
@@ -586,7 +603,7 @@ Json::Int constexpr server_overloaded = -32604;
 Json::Int constexpr forbidden = -32605;
 Json::Int constexpr wrong_version = -32606;
 
-void
+bool
 ServerHandler::processRequest(
     Port const& port,
     std::string const& request,
@@ -594,7 +611,8 @@ ServerHandler::processRequest(
     Output&& output,
     std::shared_ptr<JobQueue::Coro> coro,
     boost::string_view forwardedFor,
-    boost::string_view user)
+    boost::string_view user,
+    std::shared_ptr<Session> const& session)
 {
     auto rpcJ = app_.journal("RPC");
 
@@ -610,7 +628,7 @@ ServerHandler::processRequest(
                 "Unable to parse request: " + reader.getFormatedErrorMessages(),
                 output,
                 rpcJ);
-            return;
+            return false;
         }
     }
 
@@ -622,11 +640,16 @@ ServerHandler::processRequest(
         if (!jsonOrig.isMember(jss::params) || !jsonOrig[jss::params].isArray())
         {
             HTTPReply(400, "Malformed batch request", output, rpcJ);
-            return;
+            return false;
         }
         size = jsonOrig[jss::params].size();
     }
 
+    // Results that are written out as they are produced are only streamed
+    // to HTTP/1.1 clients, which accept chunked responses.
+    bool const streamable =
+        !batch && session && session->request().version() >= 11;
+
     Json::Value reply(batch ? Json::arrayValue : Json::objectValue);
     auto const start(std::chrono::high_resolution_clock::now());
     for (unsigned i = 0; i < size; ++i)
@@ -666,7 +689,7 @@ ServerHandler::processRequest(
             if (!batch)
             {
                 HTTPReply(400, jss::invalid_API_version.c_str(), output, rpcJ);
-                return;
+                return false;
             }
             Json::Value r(Json::objectValue);
             r[jss::request] = jsonRPC;
@@ -716,7 +739,7 @@ ServerHandler::processRequest(
                 if (!batch)
                 {
                     HTTPReply(503, "Server is overloaded", output, rpcJ);
-                    return;
+                    return false;
                 }
                 Json::Value r = jsonRPC;
                 r[jss::error] =
@@ -732,7 +755,7 @@ ServerHandler::processRequest(
             if (!batch)
             {
                 HTTPReply(403, "Forbidden", output, rpcJ);
-                return;
+                return false;
             }
             Json::Value r = jsonRPC;
             r[jss::error] = make_json_error(forbidden, "Forbidden");
@@ -746,7 +769,7 @@ ServerHandler::processRequest(
             if (!batch)
             {
                 HTTPReply(400, "Null method", output, rpcJ);
-                return;
+                return false;
             }
             Json::Value r = jsonRPC;
             r[jss::error] = make_json_error(method_not_found, "Null method");
@@ -761,7 +784,7 @@ ServerHandler::processRequest(
             if (!batch)
             {
                 HTTPReply(400, "method is not string", output, rpcJ);
-                return;
+                return false;
             }
             Json::Value r = jsonRPC;
             r[jss::error] =
@@ -777,7 +800,7 @@ ServerHandler::processRequest(
             if (!batch)
             {
                 HTTPReply(400, "method is empty", output, rpcJ);
-                return;
+                return false;
             }
             Json::Value r = jsonRPC;
             r[jss::error] =
@@ -803,7 +826,7 @@ ServerHandler::processRequest(
             {
                 usage.charge(Resource::feeInvalidRPC);
                 HTTPReply(400, "params unparseable", output, rpcJ);
-                return;
+                return false;
             }
             else
             {
@@ -812,7 +835,7 @@ ServerHandler::processRequest(
                 {
                     usage.charge(Resource::feeInvalidRPC);
                     HTTPReply(400, "params unparseable", output, rpcJ);
-                    return;
+                    return false;
                 }
             }
         }
@@ -830,7 +853,7 @@ ServerHandler::processRequest(
                 if (!batch)
                 {
                     HTTPReply(400, "ripplerpc is not a string", output, rpcJ);
-                    return;
+                    return false;
                 }
 
                 Json::Value r = jsonRPC;
@@ -875,12 +898,15 @@ ServerHandler::processRequest(
             params,
             {user, forwardedFor}};
         Json::Value result;
+        RPC::ResultWriter writer;
 
         auto start = std::chrono::system_clock::now();
 
         try
         {
-            RPC::doCommand(context, result);
+            if (!streamable ||
+                (!RPC::prepareCommand(context, result, writer) && !writer))
+                RPC::doCommand(context, result);
         }
         catch (std::exception const& ex)
         {
@@ -894,6 +920,18 @@ ServerHandler::processRequest(
 
         logDuration(params, end - start, m_journal);
 
+        if (writer)
+        {
+            auto const size = streamResponse(
+                session, coro, writer, params, usage, loadType);
+            rpc_time_.notify(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start));
+            ++rpc_requests_;
+            rpc_size_.notify(beast::insight::Event::value_type{size});
+            return true;
+        }
+
         usage.charge(loadType);
         if (usage.warn())
             result[jss::warning] = jss::load;
@@ -1014,6 +1052,116 @@ ServerHandler::processRequest(
     }
 
     HTTPReply(httpStatus, response, output, rpcJ);
+    return false;
+}
+
+std::size_t
+ServerHandler::streamResponse(
+    std::shared_ptr<Session> const& session,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    RPC::ResultWriter const& writer,
+    Json::Value const& params,
+    Resource::Consumer& usage,
+    Resource::Charge const& loadType)
+{
+    std::string head;
+    HTTPChunkedReply(Json::stringOutput(head));
+    auto const stream =
+        std::make_shared<RPC::StreamedResponse>(coro, true, std::move(head));
+    session->write(
+        stream->makeHTTPWriter(),
+        beast::rfc2616::is_keep_alive(session->request()));
+
+    try
+    {
+        {
+            Json::Writer w(stream->output());
+            Json::Object::Root reply(w);
+            {
+                auto result = Json::addObject(reply, jss::result);
+                writer(result);
+
+                usage.charge(loadType);
+                if (usage.warn())
+                    result[jss::warning] = jss::load;
+                result[jss::status] = jss::success;
+            }
+            if (params.isMember(jss::jsonrpc))
+                reply[jss::jsonrpc] = params[jss::jsonrpc];
+            if (params.isMember(jss::ripplerpc))
+                reply[jss::ripplerpc] = params[jss::ripplerpc];
+            if (params.isMember(jss::id))
+                reply[jss::id] = params[jss::id];
+        }
+        stream->write("\n");
+        stream->finish();
+    }
+    catch (std::exception const& ex)
+    {
+        // Part of the response may have been sent already, so the only way
+        // left to tell the client is to cut it short.
+        JLOG(m_journal.error())
+            << "Internal error : " << ex.what()
+            << " when streaming response to: "
+            << Json::Compact{Json::Value{params}};
+        stream->abort();
+        session->close(false);
+    }
+
+    JLOG(m_journal.debug()) << "Streamed reply of " << stream->size()
+                            << " bytes";
+    return stream->size();
+}
+
+void
+ServerHandler::streamResponse(
+    std::shared_ptr<WSSession> const& session,
+    std::shared_ptr<JobQueue::Coro> const& coro,
+    RPC::ResultWriter const& writer,
+    Json::Value const& jv,
+    Resource::Charge const& loadType)
+{
+    auto is = std::static_pointer_cast<WSInfoSub>(session->appDefined);
+    auto const stream = std::make_shared<RPC::StreamedResponse>(coro, false);
+    session->send(stream->makeWSMsg());
+
+    try
+    {
+        {
+            Json::Writer w(stream->output());
+            Json::Object::Root jr(w);
+            {
+                auto result = Json::addObject(jr, jss::result);
+                writer(result);
+            }
+
+            is->getConsumer().charge(loadType);
+            if (is->getConsumer().warn())
+                jr[jss::warning] = jss::load;
+            jr[jss::status] = jss::success;
+
+            if (jv.isMember(jss::id))
+                jr[jss::id] = jv[jss::id];
+            if (jv.isMember(jss::jsonrpc))
+                jr[jss::jsonrpc] = jv[jss::jsonrpc];
+            if (jv.isMember(jss::ripplerpc))
+                jr[jss::ripplerpc] = jv[jss::ripplerpc];
+            if (jv.isMember(jss::api_version))
+                jr[jss::api_version] = jv[jss::api_version];
+            jr[jss::type] = jss::response;
+        }
+        stream->finish();
+        session->complete();
+    }
+    catch (std::exception const& ex)
+    {
+        JLOG(m_journal.error())
+            << "Exception while streaming WS response: " << ex.what() << "\n"
+            << "Input JSON: " << Json::Compact{Json::Value{jv}};
+        stream->abort();
+        session->close(
+            {boost::beast::websocket::internal_error, "Internal error"});
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/contract.h>
+#include <ripple/rpc/impl/StreamedResponse.h>
+#include <ripple/rpc/impl/Tuning.h>
+
+#include <exception>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace ripple {
+namespace RPC {
+
+class StreamedResponse::HTTPWriter : public Writer
+{
+    std::shared_ptr<StreamedResponse> const stream_;
+
+public:
+    explicit HTTPWriter(std::shared_ptr<StreamedResponse> stream)
+        : stream_(std::move(stream))
+    {
+    }
+
+    ~HTTPWriter() override
+    {
+        stream_->detach();
+    }
+
+    bool
+    complete() override
+    {
+        return stream_->done();
+    }
+
+    void
+    consume(std::size_t bytes) override
+    {
+        stream_->consume(bytes);
+    }
+
+    bool
+    prepare(std::size_t, std::function<void(void)> resume) override
+    {
+        return stream_->ready(std::move(resume));
+    }
+
+    std::vector<boost::asio::const_buffer>
+    data() override
+    {
+        return stream_->buffers(std::numeric_limits<std::size_t>::max());
+    }
+};
+
+class StreamedResponse::Message : public WSMsg
+{
+    std::shared_ptr<StreamedResponse> const stream_;
+    std::size_t n_ = 0;
+
+public:
+    explicit Message(std::shared_ptr<StreamedResponse> stream)
+        : stream_(std::move(stream))
+    {
+    }
+
+    ~Message() override
+    {
+        stream_->detach();
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)> resume) override
+    {
+        // What was returned by the last call has been sent by now.
+        stream_->consume(n_);
+        n_ = 0;
+        if (!stream_->ready(std::move(resume)))
+            return {boost::indeterminate, {}};
+        auto buffers = stream_->buffers(bytes);
+        n_ = boost::asio::buffer_size(buffers);
+        return {stream_->done(n_), std::move(buffers)};
+    }
+};
+
+//------------------------------------------------------------------------------
+
+StreamedResponse::StreamedResponse(
+    std::shared_ptr<JobQueue::Coro> coro,
+    bool chunked,
+    std::string head)
+    : coro_(std::move(coro))
+    , chunked_(chunked)
+    , uncaught_(std::uncaught_exceptions())
+{
+    if (!head.empty())
+    {
+        queued_ = head.size();
+        blocks_.push_back(std::move(head));
+    }
+}
+
+void
+StreamedResponse::write(boost::beast::string_view data)
+{
+    if (abandoned_)
+    {
+        // Writes made while unwinding, such as by the destructors of
+        // Json::Object, must not throw again.
+        if (std::uncaught_exceptions() > uncaught_)
+            return;
+        Throw<std::runtime_error>("The client is no longer connected");
+    }
+
+    size_ += data.size();
+    pending_.append(data.data(), data.size());
+    if (pending_.size() >= Tuning::streamBlockSize)
+        flush();
+}
+
+Json::Output
+StreamedResponse::output()
+{
+    return [this](boost::beast::string_view const& data) { write(data); };
+}
+
+void
+StreamedResponse::finish()
+{
+    flush();
+    push(chunked_ ? "0\r\n\r\n" : "", true);
+}
+
+void
+StreamedResponse::abort()
+{
+    push({}, true);
+}
+
+std::shared_ptr<Writer>
+StreamedResponse::makeHTTPWriter()
+{
+    return std::make_shared<HTTPWriter>(shared_from_this());
+}
+
+std::shared_ptr<WSMsg>
+StreamedResponse::makeWSMsg()
+{
+    return std::make_shared<Message>(shared_from_this());
+}
+
+void
+StreamedResponse::flush()
+{
+    if (pending_.empty())
+        return;
+
+    std::string block;
+    if (chunked_)
+    {
+        std::ostringstream ss;
+        ss << std::hex << pending_.size() << "\r\n";
+        block = ss.str();
+        block.reserve(block.size() + pending_.size() + 2);
+        block += pending_;
+        block += "\r\n";
+        pending_.clear();
+    }
+    else
+    {
+        block.swap(pending_);
+    }
+    pending_.reserve(Tuning::streamBlockSize);
+    push(std::move(block));
+}
+
+void
+StreamedResponse::push(std::string block, bool last)
+{
+    std::function<void(void)> resume;
+    bool suspend = false;
+    {
+        std::lock_guard lock(mutex_);
+        if (abandoned_)
+            return;
+        if (!block.empty())
+        {
+            queued_ += block.size();
+            blocks_.push_back(std::move(block));
+        }
+        if (last)
+            finished_ = true;
+        resume.swap(resume_);
+        if (!last && coro_ && queued_ > Tuning::maxStreamBuffer)
+            suspend = suspended_ = true;
+    }
+
+    if (resume)
+        resume();
+
+    // The session only resumes the coroutine once it has yielded, so it
+    // doesn't matter if the session catches up before then.
+    if (suspend)
+        coro_->yield();
+}
+
+void
+StreamedResponse::resumeProducer()
+{
+    if (!coro_->post())
+        coro_->resume();
+}
+
+bool
+StreamedResponse::ready(std::function<void(void)> resume)
+{
+    std::lock_guard lock(mutex_);
+    if (!blocks_.empty() || finished_)
+        return true;
+    resume_ = std::move(resume);
+    return false;
+}
+
+std::vector<boost::asio::const_buffer>
+StreamedResponse::buffers(std::size_t limit)
+{
+    // Pushing more blocks onto the deque leaves the ones already in it
+    // where they are, so the buffers stay valid until they are consumed.
+    std::vector<boost::asio::const_buffer> result;
+    std::lock_guard lock(mutex_);
+    auto offset = offset_;
+    for (auto const& block : blocks_)
+    {
+        if (limit == 0)
+            break;
+        auto const n = std::min(block.size() - offset, limit);
+        result.emplace_back(block.data() + offset, n);
+        limit -= n;
+        offset = 0;
+    }
+    return result;
+}
+
+void
+StreamedResponse::consume(std::size_t bytes)
+{
+    bool resume = false;
+    {
+        std::lock_guard lock(mutex_);
+        if (bytes > queued_)
+            return;
+        queued_ -= bytes;
+        offset_ += bytes;
+        while (!blocks_.empty() && offset_ >= blocks_.front().size())
+        {
+            offset_ -= blocks_.front().size();
+            blocks_.pop_front();
+        }
+        if (suspended_ && queued_ <= Tuning::maxStreamBuffer / 2)
+        {
+            suspended_ = false;
+            resume = true;
+        }
+    }
+
+    if (resume)
+        resumeProducer();
+}
+
+bool
+StreamedResponse::done(std::size_t left)
+{
+    std::lock_guard lock(mutex_);
+    return finished_ && queued_ <= left;
+}
+
+void
+StreamedResponse::detach()
+{
+    bool resume = false;
+    {
+        std::lock_guard lock(mutex_);
+        abandoned_ = true;
+        blocks_.clear();
+        queued_ = 0;
+        offset_ = 0;
+        resume_ = nullptr;
+        resume = suspended_;
+        suspended_ = false;
+    }
+
+    // The coroutine finds out that the client is gone when it writes next.
+    if (resume)
+        resumeProducer();
+}
+
+}  // namespace RPC
+}  // namespace ripple
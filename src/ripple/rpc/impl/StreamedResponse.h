@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_STREAMEDRESPONSE_H_INCLUDED
+#define RIPPLE_RPC_STREAMEDRESPONSE_H_INCLUDED
+
+#include <ripple/core/JobQueue.h>
+#include <ripple/json/Output.h>
+#include <ripple/server/WSSession.h>
+#include <ripple/server/Writer.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+namespace RPC {
+
+/** A response that is sent to the client while it is being produced.
+
+    The response is produced by a coroutine, and taken by the client's
+    session through a Writer or a WSMsg. Data the session hasn't sent yet
+    is kept in blocks, and the coroutine is suspended whenever too much of
+    it is waiting, so a response takes about the same memory however large
+    it is.
+*/
+class StreamedResponse : public std::enable_shared_from_this<StreamedResponse>
+{
+public:
+    /** Create a response.
+
+        @param coro The coroutine producing the response. Without one,
+                    the response is kept whole until it is sent.
+        @param chunked Whether the data is framed with HTTP chunked
+                       transfer encoding.
+        @param head Sent ahead of the data, without any framing.
+    */
+    StreamedResponse(
+        std::shared_ptr<JobQueue::Coro> coro,
+        bool chunked,
+        std::string head = {});
+
+    StreamedResponse(StreamedResponse const&) = delete;
+    StreamedResponse&
+    operator=(StreamedResponse const&) = delete;
+
+    /** Append data to the response.
+
+        If the client has gone away this throws, unless an exception is
+        already being thrown, in which case the data is discarded.
+    */
+    void
+    write(boost::beast::string_view data);
+
+    /** Returns an Output that appends to the response. */
+    Json::Output
+    output();
+
+    /** Send whatever is left of the response, and end it. */
+    void
+    finish();
+
+    /** End the response after a failure.
+
+        What was already written is still sent, but the response is left
+        unterminated, so the session must be closed.
+    */
+    void
+    abort();
+
+    /** The number of bytes of data written, without any framing. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** Returns a Writer that sends the response through an HTTP session. */
+    std::shared_ptr<Writer>
+    makeHTTPWriter();
+
+    /** Returns a WebSocket message that sends the response. */
+    std::shared_ptr<WSMsg>
+    makeWSMsg();
+
+private:
+    class HTTPWriter;
+    class Message;
+
+    // Turns the pending data into a block, framed if needed.
+    void
+    flush();
+
+    // Queues a block, waking the session, and suspends the coroutine if
+    // the session has fallen too far behind.
+    void
+    push(std::string block, bool last = false);
+
+    void
+    resumeProducer();
+
+    // These are called by the session taking the response.
+
+    // Whether there is data to send, or the response has ended.
+    // Otherwise, resume is called once there is.
+    bool
+    ready(std::function<void(void)> resume);
+
+    std::vector<boost::asio::const_buffer>
+    buffers(std::size_t limit);
+
+    void
+    consume(std::size_t bytes);
+
+    // Whether the response has ended, and no more than the given number of
+    // bytes are left to send.
+    bool
+    done(std::size_t left = 0);
+
+    void
+    detach();
+
+    std::shared_ptr<JobQueue::Coro> const coro_;
+    bool const chunked_;
+    int const uncaught_;
+
+    // Only used by the coroutine.
+    std::string pending_;
+    std::size_t size_ = 0;
+
+    std::atomic<bool> abandoned_{false};
+
+    std::mutex mutex_;
+    std::deque<std::string> blocks_;
+    std::size_t queued_ = 0;
+    std::size_t offset_ = 0;
+    std::function<void(void)> resume_;
+    bool finished_ = false;
+    bool suspended_ = false;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
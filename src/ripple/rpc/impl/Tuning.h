@@ -77,6 +77,13 @@ inline int constexpr pageLength(bool isBinary)
     return isBinary ? binaryPageLength : jsonPageLength;
 }
 
+/** Size of the blocks a streamed response is sent in. */
+static std::size_t constexpr streamBlockSize = 64 * 1024;
+
+/** Most of a streamed response held in memory before its producer waits
+    for the client to catch up. */
+static std::size_t constexpr maxStreamBuffer = 16 * streamBlockSize;
+
 /** Maximum number of source currencies allowed in a path find request. */
 static int constexpr max_src_cur = 18;
 
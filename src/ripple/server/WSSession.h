@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,33 @@ public:
     }
 };
 
+/** A message whose data is shared, unchanged, with other messages. */
+class SharedWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> data_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit SharedWSMsg(std::shared_ptr<std::string const> data)
+        : data_(std::move(data))
+    {
+    }
+
+    std::pair<boost::tribool, std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes, std::function<void(void)>) override
+    {
+        pos_ += n_;
+        auto const remaining = data_->size() - pos_;
+        if (remaining == 0)
+            return {true, {}};
+        n_ = std::min(bytes, remaining);
+        return {
+            n_ == remaining,
+            {boost::asio::const_buffer(data_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -223,7 +223,7 @@ BaseWSPeer<Handler, Impl>::send(std::shared_ptr<WSMsg> w)
             strand_,
             std::bind(
                 &BaseWSPeer::send, impl().shared_from_this(), std::move(w)));
-    if (do_close_)
+    if (do_close_ || ec_)
         return;
     if (wq_.size() > port().ws_queue_limit)
     {
@@ -312,6 +312,9 @@ BaseWSPeer<Handler, Impl>::on_write(error_code const& ec)
 {
     if (ec)
         return fail(ec, "write");
+    // A message that is waiting for its data may resume after a failure.
+    if (wq_.empty())
+        return;
     auto& w = *wq_.front();
     auto const result = w.prepare(
         65536, std::bind(&BaseWSPeer::do_write, impl().shared_from_this()));
@@ -346,6 +349,8 @@ BaseWSPeer<Handler, Impl>::on_write_fin(error_code const& ec)
 {
     if (ec)
         return fail(ec, "write_fin");
+    if (wq_.empty())
+        return;
     wq_.pop_front();
     if (do_close_)
         impl().ws_.async_close(
@@ -508,6 +513,8 @@ BaseWSPeer<Handler, Impl>::fail(error_code ec, String const& what)
         ec_ = ec;
         JLOG(this->j_.trace()) << what << ": " << ec.message();
         ripple::get_lowest_layer(impl().ws_).socket().close(ec);
+        // Release the messages, so that any still being produced stop.
+        wq_.clear();
     }
 }
 
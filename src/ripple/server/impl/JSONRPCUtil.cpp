@@ -156,4 +156,20 @@ HTTPReply(
     output("\r\n");
 }
 
+void
+HTTPChunkedReply(Json::Output const& output)
+{
+    output("HTTP/1.1 200 OK\r\n");
+    output(getHTTPHeaderTimestamp());
+    output(
+        "Connection: Keep-Alive\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Content-Type: application/json; charset=UTF-8\r\n");
+    output("Server: " + systemName() + "-json-rpc/");
+    output(BuildInfo::getFullVersionString());
+    output(
+        "\r\n"
+        "\r\n");
+}
+
 }  // namespace ripple
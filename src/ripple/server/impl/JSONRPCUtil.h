@@ -32,6 +32,12 @@ HTTPReply(
     Json::Output const&,
     beast::Journal j);
 
+/** Write the header of a successful reply whose body is sent in chunks,
+    as it is produced.
+*/
+void
+HTTPChunkedReply(Json::Output const&);
+
 }  // namespace ripple
 
 #endif
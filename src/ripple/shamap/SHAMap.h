@@ -39,6 +39,7 @@
 
 namespace ripple {
 
+class JobQueue;
 class SHAMapNodeID;
 class SHAMapSyncFilter;
 
@@ -348,6 +349,16 @@ public:
     int
     flushDirty(NodeObjectType t);
 
+    /** Flush modified nodes to the nodestore and convert them to shared,
+        hashing and writing the subtrees below the root in parallel.
+
+        The calling thread takes part in the work and the rest is spread
+        over jobs on the given queue. The resulting map is identical to
+        the one produced by flushDirty(t).
+    */
+    int
+    flushDirty(NodeObjectType t, JobQueue& jobQueue);
+
     void
     walkMap(std::vector<SHAMapMissingNode>& missingNodes, int maxMissing) const;
     bool
@@ -504,6 +515,11 @@ private:
         int& maxCount) const;
     int
     walkSubTree(bool doWrite, NodeObjectType t);
+    int
+    walkSubTree(
+        bool doWrite,
+        NodeObjectType t,
+        std::shared_ptr<SHAMapTreeNode>& node);
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -176,6 +177,15 @@ public:
     void
     updateHashDeep();
 
+    /** Recalculate the hash of each of a number of nodes from the hashes of
+        their children, hashing the nodes together in batches.
+
+        The result is the same as calling updateHashDeep on each node. No
+        node may be a child of another in the same call.
+    */
+    static void
+    updateHashesDeep(std::vector<SHAMapInnerNode*> const& nodes);
+
     void
     serializeForWire(Serializer&) const override;
 
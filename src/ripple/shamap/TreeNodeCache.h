@@ -24,7 +24,16 @@
 
 namespace ripple {
 
-using TreeNodeCache = TaggedCache<uint256, SHAMapTreeNode>;
+// Hit by every SHAMap traversal that goes to the node store, so each
+// partition gets its own lock.
+using TreeNodeCache = TaggedCache<
+    uint256,
+    SHAMapTreeNode,
+    /*IsKeyCache*/ false,
+    hardened_hash<>,
+    std::equal_to<uint256>,
+    std::recursive_mutex,
+    /*PartitionLocks*/ true>;
 
 }  // namespace ripple
 
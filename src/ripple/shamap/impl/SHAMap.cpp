@@ -18,12 +18,18 @@
 //==============================================================================
 
 #include <ripple/basics/contract.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapAccountStateLeafNode.h>
 #include <ripple/shamap/SHAMapNodeID.h>
 #include <ripple/shamap/SHAMapSyncFilter.h>
 #include <ripple/shamap/SHAMapTxLeafNode.h>
 #include <ripple/shamap/SHAMapTxPlusMetaLeafNode.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 
 namespace ripple {
 
@@ -996,127 +1002,258 @@ SHAMap::flushDirty(NodeObjectType t)
 }
 
 int
-SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+SHAMap::flushDirty(NodeObjectType t, JobQueue& jobQueue)
 {
-    assert(!doWrite || backed_);
+    if (!root_ || (root_->cowid() == 0) || !root_->isInner())
+        return flushDirty(t);
 
-    int flushed = 0;
+    auto root = std::static_pointer_cast<SHAMapInnerNode>(root_);
 
-    if (!root_ || (root_->cowid() == 0))
-        return flushed;
+    if (root->isEmpty())
+        return flushDirty(t);
 
-    if (root_->isLeaf())
-    {  // special case -- root_ is leaf
-        root_ = preFlushNode(std::move(root_));
-        root_->updateHash();
-        root_->unshare();
+    bool const doWrite = backed_;
+    root = preFlushNode(std::move(root));
 
-        if (doWrite)
-            root_ = writeNode(t, std::move(root_));
+    // Distinct branches of the root share no modified nodes, so each
+    // subtree can be flushed on its own. Workers claim subtrees until none
+    // are left. The calling thread is one of them, so the flush completes
+    // even if none of the jobs get to run.
+    struct Work
+    {
+        std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> children;
+        std::array<int, branchFactor> flushed{};
+        std::vector<int> branches;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t remaining = 0;
+        std::exception_ptr error;
+    };
+    auto work = std::make_shared<Work>();
+
+    for (int branch = 0; branch < branchFactor; ++branch)
+    {
+        if (root->isEmptyBranch(branch))
+            continue;
 
-        return 1;
+        // No need to do I/O. If the node isn't linked,
+        // it can't need to be flushed
+        auto child = root->getChild(branch);
+        if (child && (child->cowid() != 0))
+        {
+            work->children[branch] = std::move(child);
+            work->branches.push_back(branch);
+        }
+    }
+    work->remaining = work->branches.size();
+
+    // Jobs that start after every subtree has been claimed return without
+    // touching this map, so they may safely outlive this call.
+    auto flushSubTrees = [this, doWrite, t](Work& w) {
+        for (auto i = w.next++; i < w.branches.size(); i = w.next++)
+        {
+            auto const branch = w.branches[i];
+            try
+            {
+                w.flushed[branch] =
+                    walkSubTree(doWrite, t, w.children[branch]);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(w.mutex);
+                if (!w.error)
+                    w.error = std::current_exception();
+            }
+
+            std::lock_guard lock(w.mutex);
+            if (--w.remaining == 0)
+                w.cv.notify_all();
+        }
+    };
+
+    for (std::size_t i = 1; i < work->branches.size(); ++i)
+    {
+        if (!jobQueue.addJob(
+                jtACCEPT, "SHAMap::flushDirty", [work, flushSubTrees]() {
+                    flushSubTrees(*work);
+                }))
+            break;
+    }
+    flushSubTrees(*work);
+
+    {
+        std::unique_lock lock(work->mutex);
+        work->cv.wait(lock, [&work] { return work->remaining == 0; });
+        if (work->error)
+            std::rethrow_exception(work->error);
     }
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    // Hook the flushed subtrees to the root in branch order, exactly as
+    // the serial walk would.
+    int flushed = 0;
+    for (auto const branch : work->branches)
+    {
+        assert(root->cowid() == cowid_);
+        root->shareChild(branch, work->children[branch]);
+        flushed += work->flushed[branch];
+    }
+
+    root->updateHashDeep();
+    root->unshare();
+
+    if (doWrite)
+        root_ = writeNode(t, std::move(root));
+    else
+        root_ = std::move(root);
+
+    return flushed + 1;
+}
+
+int
+SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
+{
+    assert(!doWrite || backed_);
+
+    if (!root_ || (root_->cowid() == 0))
+        return 0;
 
-    if (node->isEmpty())
+    if (root_->isInner() &&
+        std::static_pointer_cast<SHAMapInnerNode>(root_)->isEmpty())
     {  // replace empty root with a new empty root
         root_ = std::make_shared<SHAMapInnerNode>(0);
         return 1;
     }
 
-    // Stack of {parent,index,child} pointers representing
-    // inner nodes we are in the process of flushing
-    using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
-    std::stack<StackEntry, std::vector<StackEntry>> stack;
+    return walkSubTree(doWrite, t, root_);
+}
+
+int
+SHAMap::walkSubTree(
+    bool doWrite,
+    NodeObjectType t,
+    std::shared_ptr<SHAMapTreeNode>& subTree)
+{
+    assert(!doWrite || backed_);
+    assert(subTree->cowid() != 0);
 
-    node = preFlushNode(std::move(node));
+    if (subTree->isLeaf())
+    {  // special case -- subtree is a single leaf
+        subTree = preFlushNode(std::move(subTree));
+        subTree->updateHash();
+        subTree->unshare();
+
+        if (doWrite)
+            subTree = writeNode(t, std::move(subTree));
+
+        return 1;
+    }
 
-    int pos = 0;
+    int flushed = 0;
 
-    // We can't flush an inner node until we flush its children
-    while (1)
+    // Inner nodes that need to be flushed, grouped by their depth below the
+    // root of the subtree. We can't flush an inner node until we flush its
+    // children, so the levels are flushed deepest first; all the nodes of a
+    // level are hashed together in batches.
+    struct Pending
+    {
+        std::shared_ptr<SHAMapInnerNode> node;
+        SHAMapInnerNode* parent;
+        int branch;
+    };
+    std::vector<std::vector<Pending>> levels;
+
+    levels.emplace_back();
+    levels.back().push_back(
+        {preFlushNode(std::static_pointer_cast<SHAMapInnerNode>(
+             std::move(subTree))),
+         nullptr,
+         0});
+
+    for (std::size_t depth = 0; !levels[depth].empty(); ++depth)
     {
-        while (pos < branchFactor)
+        levels.emplace_back();
+
+        for (auto const& pending : levels[depth])
         {
-            if (node->isEmptyBranch(pos))
-            {
-                ++pos;
-            }
-            else
+            auto const& node = pending.node;
+
+            for (int branch = 0; branch < branchFactor; ++branch)
             {
+                if (node->isEmptyBranch(branch))
+                    continue;
+
                 // No need to do I/O. If the node isn't linked,
                 // it can't need to be flushed
-                int branch = pos;
-                auto child = node->getChild(pos++);
+                auto child = node->getChild(branch);
 
-                if (child && (child->cowid() != 0))
-                {
-                    // This is a node that needs to be flushed
+                if (!child || (child->cowid() == 0))
+                    continue;
 
-                    child = preFlushNode(std::move(child));
+                // This is a node that needs to be flushed
+                child = preFlushNode(std::move(child));
 
-                    if (child->isInner())
-                    {
-                        // save our place and work on this node
-
-                        stack.emplace(std::move(node), branch);
-                        // The semantics of this changes when we move to c++-20
-                        // Right now no move will occur; With c++-20 child will
-                        // be moved from.
-                        node = std::static_pointer_cast<SHAMapInnerNode>(
-                            std::move(child));
-                        pos = 0;
-                    }
-                    else
-                    {
-                        // flush this leaf
-                        ++flushed;
+                if (child->isInner())
+                {
+                    // flush it with the rest of the next level
+                    levels[depth + 1].push_back(
+                        {std::static_pointer_cast<SHAMapInnerNode>(
+                             std::move(child)),
+                         node.get(),
+                         branch});
+                }
+                else
+                {
+                    // flush this leaf
+                    ++flushed;
 
-                        assert(node->cowid() == cowid_);
-                        child->updateHash();
-                        child->unshare();
+                    assert(node->cowid() == cowid_);
+                    child->updateHash();
+                    child->unshare();
 
-                        if (doWrite)
-                            child = writeNode(t, std::move(child));
+                    if (doWrite)
+                        child = writeNode(t, std::move(child));
 
-                        node->shareChild(branch, child);
-                    }
+                    node->shareChild(branch, child);
                 }
             }
         }
+    }
 
-        // update the hash of this inner node
-        node->updateHashDeep();
-
-        // This inner node can now be shared
-        node->unshare();
-
-        if (doWrite)
-            node = std::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
-
-        ++flushed;
+    std::vector<SHAMapInnerNode*> nodes;
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level)
+    {
+        // update the hashes of this level's inner nodes, whose children
+        // have all been flushed and hooked in already
+        nodes.clear();
+        for (auto const& pending : *level)
+            nodes.push_back(pending.node.get());
+        SHAMapInnerNode::updateHashesDeep(nodes);
+
+        for (auto& pending : *level)
+        {
+            // This inner node can now be shared
+            pending.node->unshare();
 
-        if (stack.empty())
-            break;
+            std::shared_ptr<SHAMapTreeNode> node = std::move(pending.node);
+            if (doWrite)
+                node = writeNode(t, std::move(node));
 
-        auto parent = std::move(stack.top().first);
-        pos = stack.top().second;
-        stack.pop();
+            ++flushed;
 
-        // Hook this inner node to its parent
-        assert(parent->cowid() == cowid_);
-        parent->shareChild(pos, node);
+            if (pending.parent == nullptr)
+            {
+                // The only node without a parent is the new subtree root
+                subTree = std::move(node);
+                continue;
+            }
 
-        // Continue with parent's next child, if any
-        node = std::move(parent);
-        ++pos;
+            // Hook this inner node to its parent
+            assert(pending.parent->cowid() == cowid_);
+            pending.parent->shareChild(pending.branch, node);
+        }
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
-
     return flushed;
 }
 
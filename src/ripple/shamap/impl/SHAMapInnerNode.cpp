@@ -222,6 +222,52 @@ SHAMapInnerNode::updateHashDeep()
     updateHash();
 }
 
+void
+SHAMapInnerNode::updateHashesDeep(std::vector<SHAMapInnerNode*> const& nodes)
+{
+    // The hash of an inner node is taken over its prefix and the hashes of
+    // all sixteen branches, so every non-empty node hashes the same number
+    // of bytes.
+    constexpr std::size_t size =
+        sizeof(std::uint32_t) + branchFactor * uint256::size();
+
+    std::vector<SHAMapInnerNode*> hashed;
+    hashed.reserve(nodes.size());
+    Serializer s(nodes.size() * size);
+    for (auto node : nodes)
+    {
+        SHAMapHash* hashes;
+        std::shared_ptr<SHAMapTreeNode>* children;
+        std::tie(std::ignore, hashes, children) =
+            node->hashesAndChildren_.getHashesAndChildren();
+        node->iterNonEmptyChildIndexes([&](auto branchNum, auto indexNum) {
+            if (children[indexNum] != nullptr)
+                hashes[indexNum] = children[indexNum]->getHash();
+        });
+
+        if (node->isEmpty())
+        {
+            node->hash_ = SHAMapHash{};
+            continue;
+        }
+
+        node->serializeWithPrefix(s);
+        hashed.push_back(node);
+    }
+    assert(s.size() == hashed.size() * size);
+
+    std::vector<Slice> messages;
+    messages.reserve(hashed.size());
+    for (std::size_t i = 0; i < hashed.size(); ++i)
+        messages.push_back(s.slice().substr(i * size, size));
+
+    std::vector<uint256> digests(hashed.size());
+    sha512HalfBatch(messages.data(), digests.data(), messages.size());
+
+    for (std::size_t i = 0; i < hashed.size(); ++i)
+        hashed[i]->hash_ = SHAMapHash{digests[i]};
+}
+
 void
 SHAMapInnerNode::serializeForWire(Serializer& s) const
 {
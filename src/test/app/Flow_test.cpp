@@ -19,6 +19,7 @@
 
 #include <ripple/app/paths/Flow.h>
 #include <ripple/app/paths/impl/Steps.h>
+#include <ripple/app/tx/impl/BookTip.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/Config.h>
 #include <ripple/ledger/ApplyViewImpl.h>
@@ -29,6 +30,8 @@
 #include <test/jtx.h>
 #include <test/jtx/PathSet.h>
 
+#include <chrono>
+
 namespace ripple {
 namespace test {
 
@@ -1252,6 +1255,60 @@ struct Flow_test : public beast::unit_test::suite
             ter(temBAD_PATH));
     }
 
+    void
+    testBookTipMemo()
+    {
+        testcase("Book Tip Memo");
+        using namespace jtx;
+
+        auto const gw = Account("gw");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+
+        Env env(*this);
+        env.fund(XRP(10000), gw, carol);
+        env.trust(USD(1000), carol);
+        env(pay(gw, carol, USD(100)));
+        auto const offerSeq = env.seq(carol);
+        env(offer(carol, XRP(100), USD(10)));
+        env.close();
+
+        Book const book{xrpIssue(), USD.issue()};
+        PaymentSandbox sb(&*env.current(), tapNONE);
+        int computed = 0;
+        auto const tip = [&]() -> std::optional<Quality> {
+            ++computed;
+            Sandbox view(&sb, tapNONE);
+            BookTip bt(view, book);
+            if (bt.step(env.journal))
+                return bt.quality();
+            return std::nullopt;
+        };
+
+        // The tip is remembered while the sandbox is unchanged
+        auto const quality = sb.bookTipQuality(book, tip);
+        BEAST_EXPECT(quality == Quality(Amounts{XRP(100), USD(10)}));
+        BEAST_EXPECT(sb.bookTipQuality(book, tip) == quality);
+        BEAST_EXPECT(computed == 1);
+
+        // Reading doesn't change the sandbox
+        BEAST_EXPECT(sb.read(keylet::offer(carol, offerSeq)));
+        BEAST_EXPECT(sb.bookTipQuality(book, tip) == quality);
+        BEAST_EXPECT(computed == 1);
+
+        // Changes applied from a child sandbox are noticed
+        {
+            PaymentSandbox child(&sb);
+            BEAST_EXPECT(child.bookTipQuality(book, tip) == quality);
+            BEAST_EXPECT(computed == 2);
+            offerDelete(
+                child, child.peek(keylet::offer(carol, offerSeq)), env.journal);
+            child.apply(sb);
+        }
+        BEAST_EXPECT(!sb.bookTipQuality(book, tip));
+        BEAST_EXPECT(computed == 3);
+    }
+
     void
     testXRPPathLoop()
     {
@@ -1400,6 +1457,7 @@ struct Flow_test : public beast::unit_test::suite
         testXRPPathLoop();
         testRIPD1443();
         testRIPD1449();
+        testBookTipMemo();
 
         using namespace jtx;
         auto const sa = supported_amendments();
@@ -1429,8 +1487,77 @@ struct Flow_manual_test : public Flow_test
     }
 };
 
+/** Measures how quickly payments that take liquidity from several strands,
+    which share their first and last books, are applied.
+*/
+struct Flow_bench_test : public beast::unit_test::suite
+{
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        std::vector<IOU> const mids{gw["BTC"], gw["CNY"], gw["JPY"]};
+
+        int const offersPerBook = 50;
+        int const payments = 20;
+
+        Env env(*this);
+        env.fund(XRP(100000000), gw, alice, bob, carol);
+        for (auto const& iou : {USD, EUR, mids[0], mids[1], mids[2]})
+            env.trust(iou(100000000), alice, bob, carol);
+        env(pay(gw, alice, EUR(10000000)));
+        for (auto const& iou : {USD, EUR, mids[0], mids[1], mids[2]})
+            env(pay(gw, carol, iou(10000000)));
+        env.close();
+
+        std::chrono::nanoseconds elapsed{0};
+        for (int payment = 0; payment < payments; ++payment)
+        {
+            // Offers of slightly different qualities in every book, so that
+            // each payment takes many passes over the strands.
+            for (int i = 0; i < offersPerBook; ++i)
+            {
+                env(offer(carol, EUR(100 + i), XRP(100)));
+                env(offer(carol, XRP(100), USD(100 - i)));
+                for (auto const& mid : mids)
+                {
+                    env(offer(carol, EUR(100 + i), mid(100)));
+                    env(offer(carol, mid(100), USD(100 - i)));
+                }
+            }
+            env.close();
+
+            auto const start = steady_clock::now();
+            env(pay(alice, bob, USD(100 * offersPerBook)),
+                path(~XRP, ~USD),
+                path(~mids[0], ~USD),
+                path(~mids[1], ~USD),
+                path(~mids[2], ~USD),
+                sendmax(EUR(1000000)),
+                txflags(tfPartialPayment));
+            elapsed += steady_clock::now() - start;
+            env.close();
+        }
+
+        log << payments << " payments through " << mids.size() + 1
+            << " strands of " << offersPerBook << " offers: "
+            << duration_cast<microseconds>(elapsed).count() / payments
+            << " us per payment" << std::endl;
+        pass();
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(Flow, app, ripple, 2);
 BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(Flow_manual, app, ripple, 4);
+BEAST_DEFINE_TESTSUITE_MANUAL(Flow_bench, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
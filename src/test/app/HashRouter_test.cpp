@@ -20,6 +20,11 @@
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace ripple {
 namespace test {
@@ -242,6 +247,46 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testConcurrentPeers()
+    {
+        testcase("concurrent peers");
+
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 2s);
+
+        std::vector<uint256> keys(1000);
+        beast::xor_shift_engine rng(1);
+        for (auto& key : keys)
+            for (auto& b : key)
+                b = static_cast<std::uint8_t>(rng());
+
+        // Every peer relays every message, but each message is only new
+        // once, and every peer is remembered for it.
+        std::atomic<std::size_t> created{0};
+        std::vector<std::thread> peers;
+        for (HashRouter::PeerShortID peer = 1; peer <= 16; ++peer)
+        {
+            peers.emplace_back([&, peer] {
+                for (auto const& key : keys)
+                {
+                    if (router.addSuppressionPeer(key, peer))
+                        ++created;
+                }
+            });
+        }
+        for (auto& peer : peers)
+            peer.join();
+
+        BEAST_EXPECT(created == keys.size());
+        for (auto const& key : keys)
+        {
+            auto const relayed = router.shouldRelay(key);
+            BEAST_EXPECT(relayed && relayed->size() == 16);
+        }
+    }
+
 public:
     void
     run() override
@@ -252,10 +297,69 @@ public:
         testSetFlags();
         testRelay();
         testProcess();
+        testConcurrentPeers();
+    }
+};
+
+/** Measures how many messages a second the HashRouter takes from 64 peers
+    which all relay the same messages at once, as in a relay storm.
+*/
+class HashRouter_bench_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+
+        int const peerCount = 64;
+        std::size_t const messages = 100000;
+
+        HashRouter router(stopwatch(), HashRouter::getDefaultHoldTime());
+
+        std::vector<uint256> keys(messages);
+        beast::xor_shift_engine rng(1);
+        for (auto& key : keys)
+            for (auto& b : key)
+                b = static_cast<std::uint8_t>(rng());
+
+        std::atomic<int> ready{0};
+        std::vector<std::thread> peers;
+        for (HashRouter::PeerShortID peer = 1; peer <= peerCount; ++peer)
+        {
+            peers.emplace_back([&, peer] {
+                ++ready;
+                while (ready < peerCount)
+                    std::this_thread::yield();
+
+                // Each peer goes through the messages from a different
+                // place, relaying the ones it sees first.
+                for (std::size_t i = 0; i < messages; ++i)
+                {
+                    auto const& key = keys[(i + peer * 997) % messages];
+                    int flags;
+                    if (router.addSuppressionPeer(key, peer, flags))
+                        router.shouldRelay(key);
+                }
+            });
+        }
+
+        auto const start = steady_clock::now();
+        for (auto& peer : peers)
+            peer.join();
+        auto const elapsed =
+            duration_cast<duration<double>>(steady_clock::now() - start);
+
+        log << peerCount << " peers, " << messages << " messages: "
+            << static_cast<std::uint64_t>(
+                   peerCount * messages / elapsed.count())
+            << " messages/s" << std::endl;
+        pass();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(HashRouter, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(HashRouter_bench, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
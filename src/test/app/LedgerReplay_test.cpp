@@ -40,7 +40,7 @@ namespace test {
 struct LedgerReplay_test : public beast::unit_test::suite
 {
     void
-    run() override
+    testReplay()
     {
         testcase("Replay ledger");
 
@@ -67,6 +67,78 @@ struct LedgerReplay_test : public beast::unit_test::suite
 
         BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
     }
+
+    void
+    testParallelBuild()
+    {
+        testcase("Parallel ledger build");
+
+        using namespace jtx;
+
+        // Builds ledgers of payments, trust lines and offers, and returns
+        // the hash of the last one.
+        auto const build = [this](bool parallel) {
+            Env env(*this, envconfig([parallel](std::unique_ptr<Config> cfg) {
+                cfg->PARALLEL_LEDGER_BUILD = parallel;
+                return cfg;
+            }));
+
+            Account const gw("gateway");
+            auto const USD = gw["USD"];
+            std::vector<Account> accounts;
+            for (int i = 0; i < 20; ++i)
+                accounts.emplace_back("acct" + std::to_string(i));
+
+            env.fund(XRP(100000), gw);
+            for (auto const& account : accounts)
+                env.fund(XRP(100000), account);
+            env.close();
+            for (auto const& account : accounts)
+                env(trust(account, USD(100000)));
+            env.close();
+            for (std::size_t i = 0; i < accounts.size(); ++i)
+            {
+                env(pay(gw, accounts[i], USD(1000)));
+                env(pay(accounts[i],
+                        accounts[(i + 1) % accounts.size()],
+                        XRP(10)));
+                env(offer(accounts[i], XRP(100 + i), USD(10)));
+            }
+            env.close();
+            for (std::size_t i = 0; i < accounts.size(); ++i)
+            {
+                env(offer(accounts[i], USD(10), XRP(90 + i)));
+                env(pay(accounts[i],
+                        accounts[(i + 3) % accounts.size()],
+                        USD(5)));
+            }
+            env.close();
+
+            // Replaying goes through the same build.
+            auto& ledgerMaster = env.app().getLedgerMaster();
+            auto const lastClosed = ledgerMaster.getClosedLedger();
+            auto const replayed = buildLedger(
+                LedgerReplay(
+                    ledgerMaster.getLedgerByHash(
+                        lastClosed->info().parentHash),
+                    lastClosed),
+                tapNONE,
+                env.app(),
+                env.journal);
+            BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
+
+            return lastClosed->info().hash;
+        };
+
+        BEAST_EXPECT(build(false) == build(true));
+    }
+
+    void
+    run() override
+    {
+        testReplay();
+        testParallelBuild();
+    }
 };
 
 enum class InboundLedgersBehavior {
@@ -24,6 +24,8 @@
 #include <test/jtx/PathSet.h>
 #include <test/jtx/WSClient.h>
 
+#include <chrono>
+
 namespace ripple {
 namespace test {
 
@@ -5439,6 +5441,62 @@ class Offer_manual_test : public Offer0_test
     }
 };
 
+/** Measures how quickly offers that cross many offers, both directly and
+    through XRP, are applied.
+*/
+class Offer_bench_test : public beast::unit_test::suite
+{
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        auto const gw = Account("gw");
+        auto const alice = Account("alice");
+        auto const carol = Account("carol");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        int const offersPerBook = 100;
+        int const crossings = 20;
+
+        Env env(*this);
+        env.fund(XRP(100000000), gw, alice, carol);
+        env.trust(USD(100000000), alice, carol);
+        env.trust(EUR(100000000), alice, carol);
+        env(pay(gw, alice, EUR(10000000)));
+        env(pay(gw, carol, USD(10000000)));
+        env(pay(gw, carol, EUR(10000000)));
+        env.close();
+
+        std::chrono::nanoseconds elapsed{0};
+        for (int crossing = 0; crossing < crossings; ++crossing)
+        {
+            // Offers of slightly different qualities in the direct book and
+            // both of the bridging books.
+            for (int i = 0; i < offersPerBook; ++i)
+            {
+                env(offer(carol, EUR(100 + i), USD(100)));
+                env(offer(carol, EUR(100 + i), XRP(100)));
+                env(offer(carol, XRP(100), USD(100 - i / 2)));
+            }
+            env.close();
+
+            auto const start = steady_clock::now();
+            env(offer(alice, USD(100 * offersPerBook), EUR(1000000)));
+            elapsed += steady_clock::now() - start;
+            env.close();
+        }
+
+        log << crossings << " offers crossing " << offersPerBook
+            << " offers per book: "
+            << duration_cast<microseconds>(elapsed).count() / crossings
+            << " us per offer" << std::endl;
+        pass();
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(Offer0, tx, ripple, 4);
 BEAST_DEFINE_TESTSUITE_PRIO(Offer1, tx, ripple, 4);
 BEAST_DEFINE_TESTSUITE_PRIO(Offer2, tx, ripple, 4);
@@ -5446,6 +5504,7 @@ BEAST_DEFINE_TESTSUITE_PRIO(Offer3, tx, ripple, 4);
 BEAST_DEFINE_TESTSUITE_PRIO(Offer4, tx, ripple, 4);
 BEAST_DEFINE_TESTSUITE_PRIO(Offer5, tx, ripple, 4);
 BEAST_DEFINE_TESTSUITE_MANUAL_PRIO(Offer_manual, tx, ripple, 20);
+BEAST_DEFINE_TESTSUITE_MANUAL(Offer_bench, tx, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+#include <chrono>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+// Carries the same transactions over to a new open ledger one by one and
+// speculatively, and compares the results.
+class OpenLedgerHarness
+{
+    jtx::Env& env_;
+    std::shared_ptr<Ledger const> const ledger_;
+
+public:
+    explicit OpenLedgerHarness(jtx::Env& env)
+        : env_(env), ledger_(env.app().getLedgerMaster().getClosedLedger())
+    {
+    }
+
+    struct Result
+    {
+        std::shared_ptr<OpenView const> view;
+        std::vector<uint256> retries;
+        std::chrono::steady_clock::duration elapsed;
+    };
+
+    // Builds an open ledger holding the transactions, then carries them
+    // over to a new open ledger on the latest closed ledger.
+    Result
+    carryOver(
+        std::vector<std::shared_ptr<STTx const>> const& txs,
+        bool speculative)
+    {
+        auto& app = env_.app();
+        OpenLedger openLedger(
+            ledger_, app.cachedSLEs(), app.journal("OpenLedger"));
+        openLedger.modify([&](OpenView& view, beast::Journal j) {
+            for (auto const& tx : txs)
+                ripple::apply(app, view, *tx, tapNONE, j);
+            return true;
+        });
+
+        auto const closed = app.getLedgerMaster().getClosedLedger();
+        app.config().SPECULATIVE_APPLY = speculative;
+        CanonicalTXSet retries(closed->info().hash);
+        auto const start = std::chrono::steady_clock::now();
+        openLedger.accept(
+            app,
+            closed->rules(),
+            closed,
+            CanonicalTXSet(closed->info().hash),
+            false,
+            retries,
+            tapNONE);
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        app.config().SPECULATIVE_APPLY = false;
+
+        Result result{openLedger.current(), {}, elapsed};
+        for (auto const& item : retries)
+            result.retries.push_back(item.second->getTransactionID());
+        return result;
+    }
+
+    // Whether two views hold the same ledger entries and transactions.
+    static bool
+    same(ReadView const& a, ReadView const& b)
+    {
+        auto ai = a.sles.begin();
+        auto bi = b.sles.begin();
+        for (; ai != a.sles.end() && bi != b.sles.end(); ++ai, ++bi)
+        {
+            if ((*ai)->key() != (*bi)->key() ||
+                (*ai)->getSerializer().peekData() !=
+                    (*bi)->getSerializer().peekData())
+                return false;
+        }
+        if (ai != a.sles.end() || bi != b.sles.end())
+            return false;
+
+        auto at = a.txs.begin();
+        auto bt = b.txs.begin();
+        for (; at != a.txs.end() && bt != b.txs.end(); ++at, ++bt)
+        {
+            if (at->first->getTransactionID() !=
+                bt->first->getTransactionID())
+                return false;
+        }
+        return at == a.txs.end() && bt == b.txs.end();
+    }
+};
+
+class OpenLedger_test : public beast::unit_test::suite
+{
+    void
+    testSpeculative()
+    {
+        testcase("speculative apply");
+
+        using namespace jtx;
+        Env env(*this);
+
+        Account const gw("gateway");
+        auto const USD = gw["USD"];
+        std::vector<Account> accounts;
+        for (int i = 0; i < 40; ++i)
+            accounts.emplace_back("acct" + std::to_string(i));
+
+        env.fund(XRP(100000), gw);
+        for (auto const& account : accounts)
+            env.fund(XRP(100000), account);
+        env.close();
+        for (auto const& account : accounts)
+            env(trust(account, USD(100000)));
+        env.close();
+        for (auto const& account : accounts)
+            env(pay(gw, account, USD(1000)));
+        env.close();
+
+        // Chains of payments from the same account, payments between
+        // accounts that also send, and offers that cross each other, so
+        // that many transactions depend on others.
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            auto const& account = accounts[i];
+            auto const seq = env.seq(account);
+            auto const sign = [&](Json::Value const& tx, std::uint32_t n) {
+                return env.jt(tx, jtx::seq(seq + n), fee(10)).stx;
+            };
+            for (std::uint32_t n = 0; n < 3; ++n)
+            {
+                auto const& to = accounts[(i * 7 + n + 1) % accounts.size()];
+                txs.push_back(sign(pay(account, to, XRP(10 + n)), n));
+            }
+            if (i % 2 == 0)
+                txs.push_back(sign(offer(account, XRP(100 + i), USD(10)), 3));
+            else
+                txs.push_back(sign(offer(account, USD(10), XRP(90 + i)), 3));
+            txs.push_back(sign(noop(account), 4));
+        }
+        OpenLedgerHarness harness(env);
+
+        // The ledger the transactions are carried over to has moved on
+        // from the one they were applied to, so some of them fail or
+        // apply differently.
+        env(noop(accounts[0]));
+        env(pay(gw, accounts[1], USD(5000)));
+        env(offer(accounts[2], USD(50), XRP(500)));
+        env.close();
+
+        auto const serial = harness.carryOver(txs, false);
+        auto const speculative = harness.carryOver(txs, true);
+
+        BEAST_EXPECT(serial.view->txCount() > 0);
+        BEAST_EXPECT(serial.view->txCount() < txs.size());
+        BEAST_EXPECT(
+            OpenLedgerHarness::same(*serial.view, *speculative.view));
+        BEAST_EXPECT(serial.retries == speculative.retries);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSpeculative();
+    }
+};
+
+/** Measures carrying 10,000 payments over to a new open ledger, one by one
+    and speculatively.
+*/
+class OpenLedger_bench_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t payments = 10'000;
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->section("transaction_queue")
+                .set(
+                    "minimum_txn_in_ledger_standalone",
+                    std::to_string(2 * payments));
+            return cfg;
+        }));
+
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < payments; ++i)
+            accounts.emplace_back("bench" + std::to_string(i));
+        for (auto const& account : accounts)
+            env.fund(XRP(1000), noripple(account));
+        env.close();
+
+        // Every account pays one on the other side of the list, so that
+        // few payments depend on each other.
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (std::size_t i = 0; i < payments; ++i)
+            txs.push_back(
+                env.jt(pay(accounts[i],
+                           accounts[(i + payments / 2) % payments],
+                           XRP(1)))
+                    .stx);
+
+        OpenLedgerHarness harness(env);
+        auto const serial = harness.carryOver(txs, false);
+        auto const speculative = harness.carryOver(txs, true);
+        BEAST_EXPECT(serial.view->txCount() == payments);
+        BEAST_EXPECT(
+            OpenLedgerHarness::same(*serial.view, *speculative.view));
+
+        auto const report = [&](char const* name, auto elapsed) {
+            auto const seconds = duration_cast<duration<double>>(elapsed);
+            log << name << ": " << duration_cast<milliseconds>(elapsed).count()
+                << "ms, "
+                << static_cast<std::uint64_t>(payments / seconds.count())
+                << " tx/s" << std::endl;
+        };
+        report("one by one", serial.elapsed);
+        report("speculative", speculative.elapsed);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OpenLedger, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(OpenLedger_bench, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <test/jtx.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class OrderBookDB_test : public beast::unit_test::suite
+{
+    // Whether the index has a book
+    static bool
+    hasBook(OrderBookDB& db, Issue const& in, Issue const& out)
+    {
+        auto const books = db.getBooksByTakerPays(in);
+        return std::find(books.begin(), books.end(), Book{in, out}) !=
+            books.end();
+    }
+
+    // Whether two indexes agree on every book between the given issues
+    void
+    expectSame(
+        OrderBookDB& actual,
+        OrderBookDB& expected,
+        std::vector<Issue> const& issues)
+    {
+        for (auto const& in : issues)
+        {
+            BEAST_EXPECT(actual.getBookSize(in) == expected.getBookSize(in));
+            BEAST_EXPECT(actual.isBookToXRP(in) == expected.isBookToXRP(in));
+
+            auto books = actual.getBooksByTakerPays(in);
+            auto expectedBooks = expected.getBooksByTakerPays(in);
+            auto const byOut = [](Book const& a, Book const& b) {
+                return a.out < b.out;
+            };
+            std::sort(books.begin(), books.end(), byOut);
+            std::sort(expectedBooks.begin(), expectedBooks.end(), byOut);
+            BEAST_EXPECT(books == expectedBooks);
+        }
+    }
+
+    void
+    testIncremental()
+    {
+        testcase("incremental");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw("gateway");
+        Account const alice("alice");
+        Account const bob("bob");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        std::vector<Issue> const issues{xrpIssue(), USD, EUR};
+
+        env.fund(XRP(10000), gw, alice, bob);
+        env.close();
+        env.trust(USD(1000), alice, bob);
+        env.trust(EUR(1000), alice, bob);
+        env(pay(gw, alice, USD(500)));
+        env(pay(gw, alice, EUR(500)));
+        env.close();
+
+        OrderBookDB db(env.app());
+        db.update(env.closed());
+        BEAST_EXPECT(db.getBookSize(xrpIssue()) == 0);
+
+        // A new book, and a second quality in it
+        auto const aliceSeq = env.seq(alice);
+        env(offer(alice, XRP(100), USD(10)));
+        env(offer(alice, XRP(200), USD(10)));
+        env.close();
+        db.applyLedger(env.closed());
+
+        // More books, and offers crossing in the ledger that created them
+        env(offer(alice, USD(10), EUR(10)));
+        env(offer(alice, XRP(100), EUR(10)));
+        env(offer(bob, EUR(10), XRP(100)));
+        env.close();
+        db.applyLedger(env.closed());
+
+        {
+            OrderBookDB full(env.app());
+            full.update(env.closed());
+            expectSame(db, full, issues);
+            BEAST_EXPECT(db.getBookSize(USD) == 1);
+            BEAST_EXPECT(hasBook(db, xrpIssue(), USD));
+        }
+
+        // A book stays while it has a directory left
+        env(offer_cancel(alice, aliceSeq));
+        env.close();
+        db.applyLedger(env.closed());
+        BEAST_EXPECT(hasBook(db, xrpIssue(), USD));
+
+        // Emptying a book removes it, even when a ledger is skipped
+        env(offer_cancel(alice, aliceSeq + 1));
+        env.close();
+        env(noop(bob));
+        env.close();
+        db.applyLedger(env.closed());
+
+        {
+            OrderBookDB full(env.app());
+            full.update(env.closed());
+            expectSame(db, full, issues);
+            BEAST_EXPECT(!hasBook(db, xrpIssue(), USD));
+        }
+    }
+
+    void
+    testSnapshot()
+    {
+        testcase("snapshot");
+
+        using namespace jtx;
+
+        beast::temp_dir dir;
+        Env env(*this, envconfig([&dir](std::unique_ptr<Config> cfg) {
+            cfg->legacy("database_path", dir.path());
+            return cfg;
+        }));
+        Account const gw("gateway");
+        Account const alice("alice");
+        auto const USD = gw["USD"];
+        std::vector<Issue> const issues{xrpIssue(), USD};
+
+        env.fund(XRP(10000), gw, alice);
+        env.close();
+        env.trust(USD(1000), alice);
+        env(pay(gw, alice, USD(500)));
+        env(offer(alice, XRP(100), USD(10)));
+        env(offer(alice, USD(10), XRP(200)));
+        env.close();
+
+        OrderBookDB saved(env.app());
+        saved.update(env.closed());
+        BEAST_EXPECT(boost::filesystem::exists(
+            boost::filesystem::path(dir.path()) / "order_books.snapshot"));
+
+        env(offer(alice, XRP(300), USD(10)));
+        env.close();
+
+        // A new index starts from the saved one and catches up
+        OrderBookDB loaded(env.app());
+        loaded.setup(env.closed());
+
+        OrderBookDB full(env.app());
+        full.update(env.closed());
+        expectSame(loaded, full, issues);
+    }
+
+public:
+    void
+    run() override
+    {
+        testIncremental();
+        testSnapshot();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OrderBookDB, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
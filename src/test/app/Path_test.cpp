@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/paths/AccountCurrencies.h>
+#include <ripple/basics/PerfLog.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/JobQueue.h>
@@ -573,6 +574,56 @@ public:
         BEAST_EXPECT(equal(sa, Account("alice")["USD"](5)));
     }
 
+    void
+    concurrent_path_requests()
+    {
+        testcase("concurrent path requests");
+        using namespace jtx;
+        Env env = pathTestEnv();
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        auto const gw2 = Account("gateway2");
+        auto const gw2_USD = gw2["USD"];
+        env.fund(XRP(10000), "alice", "bob", "carol", "dan", gw, gw2);
+        env(rate("carol", 1.1));
+        env.trust(Account("carol")["USD"](800), "alice", "bob");
+        env.trust(Account("dan")["USD"](800), "alice", "bob");
+        env.trust(USD(800), "alice", "bob");
+        env.trust(gw2_USD(800), "alice", "bob");
+        env.trust(Account("alice")["USD"](800), "dan");
+        env.trust(Account("bob")["USD"](800), "dan");
+        env(pay(gw2, "alice", gw2_USD(100)));
+        env(pay("carol", "alice", Account("carol")["USD"](100)));
+        env(pay(gw, "alice", USD(100)));
+        env.close();
+
+        // Requests made at once are updated in parallel against the same
+        // line cache, and each finds what a lone request would.
+        std::vector<Json::Value> results(8);
+        std::vector<std::thread> threads;
+        for (auto& result : results)
+        {
+            threads.emplace_back([&]() {
+                result = find_paths_request(
+                    env, "alice", "bob", Account("bob")["USD"](5));
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        auto const expected = find_paths_request(
+            env, "alice", "bob", Account("bob")["USD"](5));
+        BEAST_EXPECT(expected[jss::alternatives].size() > 0);
+        for (auto const& result : results)
+            BEAST_EXPECT(
+                result[jss::alternatives] == expected[jss::alternatives]);
+
+        auto const phases = env.app().getPerfLog().countersJson()[jss::phases];
+        BEAST_EXPECT(phases.isMember("pathRequest.update"));
+        BEAST_EXPECT(
+            phases["pathRequest.update"].isMember(jss::p99_duration_us));
+    }
+
     void
     issues_path_negative_issue()
     {
@@ -1358,6 +1409,7 @@ public:
         alternative_paths_consume_best_transfer();
         alternative_paths_consume_best_transfer_first();
         alternative_paths_limit_returned_paths_to_best_quality();
+        concurrent_path_requests();
         issues_path_negative_issue();
         issues_path_negative_ripple_client_issue_23_smaller();
         issues_path_negative_ripple_client_issue_23_larger();
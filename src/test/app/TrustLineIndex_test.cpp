@@ -0,0 +1,208 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/paths/TrustLineIndex.h>
+#include <test/jtx.h>
+
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class TrustLineIndex_test : public beast::unit_test::suite
+{
+    // The keys of an account's trust lines, read from its owner directory
+    static std::vector<uint256>
+    lineKeys(AccountID const& account, ReadView const& ledger)
+    {
+        std::vector<uint256> keys;
+        for (auto const& line : PathFindTrustLine::getItems(
+                 account, ledger, LineDirection::outgoing))
+            keys.push_back(line.key());
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    static std::vector<uint256>
+    sorted(std::optional<std::vector<uint256>> keys)
+    {
+        if (!keys)
+            return {};
+        std::sort(keys->begin(), keys->end());
+        return *keys;
+    }
+
+    void
+    testIndex()
+    {
+        testcase("index");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw("gateway");
+        Account const gw2("gateway2");
+        Account const alice("alice");
+        Account const bob("bob");
+        Account const carol("carol");
+        Account const dan("dan");
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, gw2, alice, bob, carol, dan);
+        env.close();
+        env.trust(USD(1000), alice, bob);
+        env.trust(gw2["EUR"](1000), dan);
+        env.close();
+
+        auto index = std::make_shared<TrustLineIndex>();
+        BEAST_EXPECT(!index->advance(*env.closed()));
+        BEAST_EXPECT(!index->find(gw, *env.closed()));
+
+        // The lines read from an owner directory are remembered
+        auto const first = env.closed();
+        auto cache1 = std::make_shared<RippleLineCache>(
+            first, env.journal, index);
+        auto const gwLines =
+            cache1->getRippleLines(gw, LineDirection::outgoing);
+        BEAST_EXPECT(gwLines && gwLines->size() == 2);
+        auto const danLines =
+            cache1->getRippleLines(dan, LineDirection::outgoing);
+        BEAST_EXPECT(danLines && danLines->size() == 1);
+        BEAST_EXPECT(index->size() == 2);
+        BEAST_EXPECT(
+            sorted(index->find(gw, *first)) == lineKeys(gw, *first));
+        BEAST_EXPECT(!index->find(gw, *env.current()));
+
+        // A line created, one modified and one deleted
+        env.trust(USD(1000), carol);
+        env(pay(gw, alice, USD(10)));
+        env(trust(bob, USD(0)));
+        env.close();
+
+        auto const second = env.closed();
+        auto const touched = index->advance(*second);
+        BEAST_EXPECT(touched);
+        if (touched)
+        {
+            BEAST_EXPECT(touched->count(gw));
+            BEAST_EXPECT(touched->count(alice));
+            BEAST_EXPECT(touched->count(bob));
+            BEAST_EXPECT(touched->count(carol));
+            BEAST_EXPECT(!touched->count(dan));
+        }
+        BEAST_EXPECT(lineKeys(gw, *second).size() == 2);
+        BEAST_EXPECT(
+            sorted(index->find(gw, *second)) == lineKeys(gw, *second));
+        BEAST_EXPECT(!index->find(gw, *first));
+
+        // The lines of accounts the ledger left alone are carried over,
+        // and the rest are read again, from the index.
+        auto cache2 = std::make_shared<RippleLineCache>(
+            second, env.journal, index);
+        if (touched)
+            cache2->carryOver(*cache1, *touched);
+        BEAST_EXPECT(
+            cache2->getRippleLines(dan, LineDirection::outgoing) == danLines);
+
+        auto const lines =
+            cache2->getRippleLines(gw, LineDirection::outgoing);
+        auto const expected =
+            PathFindTrustLine::getItems(gw, *second, LineDirection::outgoing);
+        BEAST_EXPECT(lines && lines->size() == expected.size());
+        if (lines && lines->size() == expected.size())
+        {
+            for (auto const& line : expected)
+            {
+                BEAST_EXPECT(std::any_of(
+                    lines->begin(), lines->end(), [&](auto const& l) {
+                        return l.key() == line.key() &&
+                            l.getBalance() == line.getBalance();
+                    }));
+            }
+        }
+
+        // A ledger that doesn't follow the one the index reflects starts
+        // it over.
+        env.close();
+        env.close();
+        BEAST_EXPECT(!index->advance(*env.closed()));
+        BEAST_EXPECT(index->size() == 0);
+        BEAST_EXPECT(!index->find(gw, *env.closed()));
+    }
+
+    void
+    testCompact()
+    {
+        testcase("compact");
+
+        using namespace jtx;
+
+        Env env(*this);
+        Account const gw("gateway");
+        auto const USD = gw["USD"];
+
+        // Enough accounts change that the index merges them into its
+        // arrays, and the lines of each are still found.
+        std::vector<Account> accounts;
+        for (int i = 0; i < 20; ++i)
+            accounts.emplace_back("account" + std::to_string(i));
+
+        env.fund(XRP(10000), gw);
+        for (auto const& account : accounts)
+            env.fund(XRP(10000), account);
+        env.close();
+
+        TrustLineIndex index;
+        index.advance(*env.closed());
+        for (auto const& account : accounts)
+            index.insert(account, *env.closed(), {});
+        index.insert(gw, *env.closed(), {});
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (auto const& account : accounts)
+                env(trust(account, USD(round == 1 ? 0 : 100 + round)));
+            env.close();
+            BEAST_EXPECT(index.advance(*env.closed()));
+
+            auto const ledger = env.closed();
+            BEAST_EXPECT(index.size() == accounts.size() + 1);
+            BEAST_EXPECT(
+                sorted(index.find(gw, *ledger)) == lineKeys(gw, *ledger));
+            for (auto const& account : accounts)
+                BEAST_EXPECT(
+                    sorted(index.find(account, *ledger)) ==
+                    lineKeys(account, *ledger));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testIndex();
+        testCompact();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TrustLineIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -31,6 +31,10 @@
 #include <test/jtx/envconfig.h>
 #include <test/jtx/ticket.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace ripple {
 
 namespace test {
@@ -4979,8 +4983,123 @@ class TxQ2_test : public TxQ1_test
     }
 };
 
+/** Fills the queue to maximum_txn_in_ledger times ledgers_in_queue
+    transactions from many accounts, and measures how long it takes to
+    queue them and to drain them into ledgers, while another thread reads
+    the queue the way the RPC handlers do.
+*/
+class TxQ_bench_test : public beast::unit_test::suite
+{
+    static constexpr std::size_t txnsPerLedger = 250;
+    static constexpr std::size_t ledgersInQueue = 20;
+    static constexpr std::size_t txnsPerAccount = 10;
+
+    static std::unique_ptr<Config>
+    makeConfig()
+    {
+        auto p = jtx::envconfig();
+        auto& section = p->section("transaction_queue");
+        section.set(
+            "minimum_txn_in_ledger_standalone", std::to_string(txnsPerLedger));
+        section.set("target_txn_in_ledger", std::to_string(txnsPerLedger));
+        section.set("maximum_txn_in_ledger", std::to_string(txnsPerLedger));
+        section.set("ledgers_in_queue", std::to_string(ledgersInQueue));
+        section.set("maximum_txn_per_account", std::to_string(txnsPerAccount));
+        section.set("normal_consensus_increase_percent", "0");
+        return p;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env(*this, makeConfig());
+        auto& txQ = env.app().getTxQ();
+
+        std::vector<Account> accounts;
+        for (std::size_t i = 0; i < txnsPerLedger * ledgersInQueue;
+             i += txnsPerAccount)
+            accounts.emplace_back("bench" + std::to_string(i));
+
+        // Fund the accounts a few at a time, so that none of the payments
+        // has to wait in the queue.
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            env.fund(XRP(100000), noripple(accounts[i]));
+            if (i % (txnsPerLedger / 2) == 0)
+                env.close();
+        }
+        env.close();
+
+        // Fill the open ledger, so that the fee escalates and everything
+        // else goes to the queue.
+        auto metrics = txQ.getMetrics(*env.current());
+        for (auto i = metrics.txInLedger; i <= metrics.txPerLedger; ++i)
+            env(noop(env.master));
+
+        auto const queueStart = steady_clock::now();
+        for (auto const& account : accounts)
+        {
+            auto const seq = env.seq(account);
+            for (std::size_t i = 0; i < txnsPerAccount; ++i)
+                env(noop(account), jtx::seq(seq + i), ter(terQUEUED));
+        }
+        auto const queueElapsed =
+            duration_cast<duration<double>>(steady_clock::now() - queueStart);
+
+        metrics = txQ.getMetrics(*env.current());
+        BEAST_EXPECT(metrics.txQMaxSize == txnsPerLedger * ledgersInQueue);
+        BEAST_EXPECT(metrics.txCount == *metrics.txQMaxSize);
+        log << metrics.txCount << " transactions queued in "
+            << duration_cast<milliseconds>(queueElapsed).count() << "ms, "
+            << static_cast<std::uint64_t>(
+                   metrics.txCount / queueElapsed.count())
+            << " tx/s" << std::endl;
+
+        // Drain the queue, while reading it from another thread.
+        std::atomic<bool> done{false};
+        std::atomic<std::uint64_t> reads{0};
+        std::thread reader([&, view = env.current()]() {
+            for (std::size_t i = 0; !done; ++i)
+            {
+                txQ.getAccountTxs(accounts[i % accounts.size()].id());
+                txQ.getMetrics(*view);
+                ++reads;
+            }
+        });
+
+        std::size_t ledgers = 0;
+        auto longest = steady_clock::duration::zero();
+        auto const drainStart = steady_clock::now();
+        while (txQ.getMetrics(*env.current()).txCount != 0 &&
+               ledgers < 2 * ledgersInQueue)
+        {
+            auto const start = steady_clock::now();
+            env.close();
+            longest = std::max(longest, steady_clock::now() - start);
+            ++ledgers;
+        }
+        auto const drainElapsed =
+            duration_cast<duration<double>>(steady_clock::now() - drainStart);
+        done = true;
+        reader.join();
+
+        BEAST_EXPECT(txQ.getMetrics(*env.current()).txCount == 0);
+        log << "Queue drained into " << ledgers << " ledgers in "
+            << duration_cast<milliseconds>(drainElapsed).count()
+            << "ms, longest close "
+            << duration_cast<milliseconds>(longest).count() << "ms, "
+            << static_cast<std::uint64_t>(reads / drainElapsed.count())
+            << " concurrent reads/s" << std::endl;
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(TxQ1, app, ripple, 1);
 BEAST_DEFINE_TESTSUITE_PRIO(TxQ2, app, ripple, 1);
+BEAST_DEFINE_TESTSUITE_MANUAL(TxQ_bench, app, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -886,7 +886,7 @@ public:
                                   int queued_us,
                                   int running_us) {
             BEAST_EXPECT(countersJson.isObject());
-            BEAST_EXPECT(countersJson.size() == 2);
+            BEAST_EXPECT(countersJson.size() == 3);
 
             BEAST_EXPECT(countersJson.isMember(jss::rpc));
             BEAST_EXPECT(countersJson[jss::rpc].isObject());
@@ -895,6 +895,10 @@ public:
             BEAST_EXPECT(countersJson.isMember(jss::job_queue));
             BEAST_EXPECT(countersJson[jss::job_queue].isObject());
             BEAST_EXPECT(countersJson[jss::job_queue].size() == 1);
+
+            BEAST_EXPECT(countersJson.isMember(jss::phases));
+            BEAST_EXPECT(countersJson[jss::phases].isObject());
+            BEAST_EXPECT(countersJson[jss::phases].size() == 0);
             {
                 Json::Value const& job{
                     countersJson[jss::job_queue][jobTypeName]};
@@ -989,6 +993,53 @@ public:
         }
     }
 
+    void
+    testPhases(WithFile withFile)
+    {
+        using namespace std::chrono;
+
+        Fixture fixture{env_.app(), j_};
+        auto perfLog{fixture.perfLog(withFile)};
+        perfLog->start();
+
+        BEAST_EXPECT(perfLog->countersJson()[jss::phases].size() == 0);
+
+        perfLog->phaseFinish("flush", microseconds{5});
+        perfLog->phaseFinish("flush", microseconds{17});
+        perfLog->phaseFinish("apply", microseconds{3});
+
+        Json::Value const phases{perfLog->countersJson()[jss::phases]};
+        BEAST_EXPECT(phases.size() == 2);
+        {
+            Json::Value const& flush{phases["flush"]};
+            BEAST_EXPECT(jsonToUint64(flush[jss::finished]) == 2);
+            BEAST_EXPECT(jsonToUint64(flush[jss::duration_us]) == 22);
+            BEAST_EXPECT(jsonToUint64(flush[jss::max_duration_us]) == 17);
+            BEAST_EXPECT(jsonToUint64(flush[jss::p50_duration_us]) == 5);
+            BEAST_EXPECT(jsonToUint64(flush[jss::p99_duration_us]) == 17);
+        }
+        {
+            Json::Value const& apply{phases["apply"]};
+            BEAST_EXPECT(jsonToUint64(apply[jss::finished]) == 1);
+            BEAST_EXPECT(jsonToUint64(apply[jss::duration_us]) == 3);
+            BEAST_EXPECT(jsonToUint64(apply[jss::max_duration_us]) == 3);
+            BEAST_EXPECT(jsonToUint64(apply[jss::p99_duration_us]) == 3);
+        }
+
+        // Percentiles are of the most recent phases only
+        for (int i = 0; i < 2000; ++i)
+            perfLog->phaseFinish("apply", microseconds{i < 1000 ? 1000 : i});
+        {
+            Json::Value const& apply{
+                perfLog->countersJson()[jss::phases]["apply"]};
+            BEAST_EXPECT(jsonToUint64(apply[jss::max_duration_us]) == 1999);
+            BEAST_EXPECT(jsonToUint64(apply[jss::p50_duration_us]) == 1487);
+            BEAST_EXPECT(jsonToUint64(apply[jss::p99_duration_us]) == 1989);
+        }
+
+        perfLog->stop();
+    }
+
     void
     testRotate(WithFile withFile)
     {
@@ -1055,6 +1106,8 @@ public:
         testJobs(WithFile::yes);
         testInvalidID(WithFile::no);
         testInvalidID(WithFile::yes);
+        testPhases(WithFile::no);
+        testPhases(WithFile::yes);
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
     }
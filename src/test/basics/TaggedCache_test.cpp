@@ -22,8 +22,13 @@
 #include <ripple/beast/clock/manual_clock.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/digest.h>
 #include <test/unit_test/SuiteJournal.h>
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 
 /*
@@ -38,10 +43,32 @@ original object.
 
 class TaggedCache_test : public beast::unit_test::suite
 {
+    template <bool PartitionLocks>
+    using Cache = TaggedCache<
+        LedgerIndex,
+        std::string,
+        false,
+        hardened_hash<>,
+        std::equal_to<LedgerIndex>,
+        std::recursive_mutex,
+        PartitionLocks>;
+
 public:
     void
     run() override
     {
+        testCache<false>();
+        testCache<true>();
+        testConcurrent();
+        testConcurrentFetchDel();
+    }
+
+    template <bool PartitionLocks>
+    void
+    testCache()
+    {
+        testcase(PartitionLocks ? "partition locks" : "single lock");
+
         using namespace std::chrono_literals;
         using namespace beast::severities;
         test::SuiteJournal journal("TaggedCache_test", *this);
@@ -49,11 +76,9 @@ public:
         TestStopwatch clock;
         clock.set(0);
 
-        using Key = LedgerIndex;
         using Value = std::string;
-        using Cache = TaggedCache<Key, Value>;
 
-        Cache c("test", 1, 1s, clock, journal);
+        Cache<PartitionLocks> c("test", 1, 1s, clock, journal);
 
         // Insert an item, retrieve it, and age it so it gets purged.
         {
@@ -149,8 +174,199 @@ public:
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
     }
+
+    void
+    testConcurrent()
+    {
+        testcase("concurrent canonicalize");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("TaggedCache_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        Cache<true> c("test", 0, 1s, clock, journal);
+
+        // Every thread canonicalizes its own copy of the same keys, so all
+        // of them must end up sharing the object inserted first.
+        constexpr int threadCount = 8;
+        constexpr LedgerIndex keyCount = 1000;
+        std::vector<std::vector<std::shared_ptr<std::string>>> results(
+            threadCount);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (LedgerIndex k = 0; k < keyCount; ++k)
+                {
+                    auto p = std::make_shared<std::string>(std::to_string(k));
+                    c.canonicalize_replace_client(k, p);
+                    results[t].push_back(std::move(p));
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        BEAST_EXPECT(c.getCacheSize() == keyCount);
+        BEAST_EXPECT(c.getTrackSize() == keyCount);
+        for (LedgerIndex k = 0; k < keyCount; ++k)
+        {
+            auto const p = c.fetch(k);
+            for (auto const& r : results)
+                BEAST_EXPECT(r[k] == p);
+        }
+
+        results.clear();
+        ++clock;
+        c.sweep();
+        BEAST_EXPECT(c.getCacheSize() == 0);
+        BEAST_EXPECT(c.getTrackSize() == 0);
+    }
+
+    void
+    testConcurrentFetchDel()
+    {
+        testcase("concurrent fetch and del");
+
+        using namespace std::chrono_literals;
+        test::SuiteJournal journal("TaggedCache_test", *this);
+
+        TestStopwatch clock;
+        clock.set(0);
+
+        Cache<true> c("test", 0, 1s, clock, journal);
+
+        // Each thread inserts, fetches and removes its own keys, so the
+        // partitions change under their own locks while the others are
+        // looked up and erased from.
+        constexpr int threadCount = 8;
+        constexpr LedgerIndex keyCount = 2000;
+        std::vector<int> failures(threadCount, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (int round = 0; round < 4; ++round)
+                {
+                    for (LedgerIndex i = 0; i < keyCount; ++i)
+                    {
+                        LedgerIndex const k = t * keyCount + i;
+                        auto p = std::make_shared<std::string>("x");
+                        c.canonicalize_replace_client(k, p);
+                        if (c.fetch(k) != p)
+                            ++failures[t];
+                        if (!c.del(k, false))
+                            ++failures[t];
+                        if (c.fetch(k))
+                            ++failures[t];
+                        if (c.del(k, false))
+                            ++failures[t];
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        for (auto const f : failures)
+            BEAST_EXPECT(f == 0);
+        BEAST_EXPECT(c.getCacheSize() == 0);
+        BEAST_EXPECT(c.size() == 0);
+    }
+};
+
+/** Measures fetch/canonicalize throughput as the number of threads grows,
+    with and without partition locks.
+*/
+class TaggedCacheContention_test : public beast::unit_test::suite
+{
+    template <bool PartitionLocks>
+    using Cache = TaggedCache<
+        uint256,
+        std::string,
+        false,
+        hardened_hash<>,
+        std::equal_to<uint256>,
+        std::recursive_mutex,
+        PartitionLocks>;
+
+    // Operations performed by each thread
+    static constexpr std::size_t opsPerThread = 200'000;
+
+    // Distinct keys in the working set
+    static constexpr std::size_t keyCount = 100'000;
+
+    template <bool PartitionLocks>
+    double
+    measure(std::vector<uint256> const& keys, std::size_t threadCount)
+    {
+        using namespace std::chrono;
+        test::SuiteJournal journal("TaggedCacheContention_test", *this);
+        TestStopwatch clock;
+        clock.set(0);
+
+        Cache<PartitionLocks> c("bench", 0, 1min, clock, journal);
+        for (auto const& key : keys)
+            c.canonicalize_replace_cache(
+                key, std::make_shared<std::string>(to_string(key)));
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        auto const start = steady_clock::now();
+        for (std::size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                // Nine fetches for every canonicalize, like tree node lookups
+                std::size_t index = t * 7919;
+                for (std::size_t i = 0; i < opsPerThread; ++i)
+                {
+                    index = (index + 104729) % keys.size();
+                    if (i % 10)
+                    {
+                        c.fetch(keys[index]);
+                    }
+                    else
+                    {
+                        auto p = std::make_shared<std::string>();
+                        c.canonicalize_replace_client(keys[index], p);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        auto const elapsed =
+            duration_cast<duration<double>>(steady_clock::now() - start);
+
+        return (threadCount * opsPerThread) / elapsed.count();
+    }
+
+public:
+    void
+    run() override
+    {
+        std::vector<uint256> keys;
+        keys.reserve(keyCount);
+        for (std::size_t i = 0; i < keyCount; ++i)
+            keys.push_back(sha512Half(i));
+
+        for (std::size_t threads = 1; threads <= 64; threads *= 2)
+        {
+            auto const single = measure<false>(keys, threads);
+            auto const partitioned = measure<true>(keys, threads);
+            log << threads << " threads: single lock "
+                << static_cast<std::uint64_t>(single)
+                << " ops/s, partition locks "
+                << static_cast<std::uint64_t>(partitioned) << " ops/s"
+                << std::endl;
+        }
+        pass();
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(TaggedCache, common, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(TaggedCacheContention, common, ripple);
 
 }  // namespace ripple
@@ -21,17 +21,35 @@
 #include <ripple/core/JobQueue.h>
 #include <test/jtx/Env.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
 namespace ripple {
 namespace test {
 
 //------------------------------------------------------------------------------
 
+// The configuration of a server whose workers use the given scheduler
+static std::unique_ptr<Config>
+schedulerConfig(bool workStealing, int workers = 0)
+{
+    return jtx::envconfig([=](std::unique_ptr<Config> cfg) {
+        cfg->FORCE_MULTI_THREAD = workStealing || workers != 0;
+        cfg->WORKERS = workers;
+        cfg->WORKERS_STEAL = workStealing;
+        return cfg;
+    });
+}
+
 class JobQueue_test : public beast::unit_test::suite
 {
     void
-    testAddJob()
+    testAddJob(bool workStealing)
     {
-        jtx::Env env{*this};
+        jtx::Env env{*this, schedulerConfig(workStealing)};
 
         JobQueue& jQueue = env.app().getJobQueue();
         {
@@ -64,9 +82,9 @@ class JobQueue_test : public beast::unit_test::suite
     }
 
     void
-    testPostCoro()
+    testPostCoro(bool workStealing)
     {
-        jtx::Env env{*this};
+        jtx::Env env{*this, schedulerConfig(workStealing)};
 
         JobQueue& jQueue = env.app().getJobQueue();
         {
@@ -149,16 +167,147 @@ class JobQueue_test : public beast::unit_test::suite
         }
     }
 
+    void
+    testLimits(bool workStealing)
+    {
+        jtx::Env env{*this, schedulerConfig(workStealing)};
+
+        JobQueue& jQueue = env.app().getJobQueue();
+        {
+            // No more jobs of a limited type run at once than its limit
+            // allows, while jobs of other types run around them.
+            int const limit = JobTypes::instance().get(jtLEDGER_DATA).limit();
+            std::atomic<int> running{0};
+            std::atomic<int> mostRunning{0};
+            std::atomic<int> limitedDone{0};
+            std::atomic<int> otherDone{0};
+
+            auto const limited = [&]() {
+                int const now = ++running;
+                int most = mostRunning;
+                while (now > most &&
+                       !mostRunning.compare_exchange_weak(most, now))
+                    ;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                --running;
+                ++limitedDone;
+            };
+
+            constexpr int jobCount = 100;
+            for (int i = 0; i < jobCount; ++i)
+            {
+                BEAST_EXPECT(
+                    jQueue.addJob(jtLEDGER_DATA, "JobLimitTest1", limited));
+                BEAST_EXPECT(jQueue.addJob(
+                    jtCLIENT, "JobLimitTest2", [&]() { ++otherDone; }));
+            }
+
+            jQueue.rendezvous();
+            BEAST_EXPECT(limitedDone == jobCount);
+            BEAST_EXPECT(otherDone == jobCount);
+            BEAST_EXPECT(mostRunning <= limit);
+        }
+        {
+            // Jobs added by running jobs all run too. When work stealing,
+            // these start out in the queue of the worker that added them.
+            std::atomic<int> done{0};
+            std::function<void(int)> spawn = [&](int depth) {
+                if (depth < 4)
+                {
+                    for (int i = 0; i < 4; ++i)
+                        jQueue.addJob(jtCLIENT, "JobLimitTest3", [&, depth]() {
+                            spawn(depth + 1);
+                        });
+                }
+                ++done;
+            };
+            spawn(0);
+
+            jQueue.rendezvous();
+            BEAST_EXPECT(done == 1 + 4 + 16 + 64 + 256);
+        }
+    }
+
 public:
     void
     run() override
     {
-        testAddJob();
-        testPostCoro();
+        for (bool const workStealing : {false, true})
+        {
+            testcase(workStealing ? "work stealing" : "shared queue");
+            testAddJob(workStealing);
+            testPostCoro(workStealing);
+            testLimits(workStealing);
+        }
+    }
+};
+
+/** Measures how many small jobs per second each scheduler gets through,
+    with jobs added both from outside the queue and by running jobs.
+*/
+class JobQueue_bench_test : public beast::unit_test::suite
+{
+    void
+    measure(bool workStealing, int workers, int producers)
+    {
+        using namespace std::chrono;
+
+        jtx::Env env{*this, schedulerConfig(workStealing, workers)};
+        JobQueue& jQueue = env.app().getJobQueue();
+        jQueue.rendezvous();
+
+        constexpr int jobsPerProducer = 100'000;
+        std::atomic<int> done{0};
+        auto const followUp = [&]() { ++done; };
+
+        auto const start = steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < jobsPerProducer; ++i)
+                {
+                    // Half the jobs add a job of their own, as jobs handling
+                    // peer messages often do.
+                    jQueue.addJob(jtCLIENT, "JobQueueBench", [&, i]() {
+                        if (i % 2 == 0)
+                            jQueue.addJob(
+                                jtTRANSACTION, "JobQueueBench", followUp);
+                        ++done;
+                    });
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        jQueue.rendezvous();
+
+        auto const elapsed =
+            duration_cast<duration<double>>(steady_clock::now() - start);
+        log << (workStealing ? "stealing" : "shared") << ", " << workers
+            << " workers, " << producers << " producers: "
+            << static_cast<std::uint64_t>(done / elapsed.count())
+            << " jobs/s" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        for (int const workers : {4, 8, 16})
+        {
+            for (int const producers : {1, 4})
+            {
+                measure(false, workers, producers);
+                measure(true, workers, producers);
+            }
+        }
+        pass();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(JobQueue, core, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(JobQueue_bench, core, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -74,6 +74,11 @@ class PerfLogTest : public PerfLog
     {
     }
 
+    void
+    phaseFinish(char const* phase, std::chrono::microseconds dur) override
+    {
+    }
+
     Json::Value
     countersJson() const override
     {
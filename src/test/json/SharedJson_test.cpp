@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/json/SharedJson.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/server/WSSession.h>
+
+#include <boost/beast/core/multi_buffer.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+// Something like a validated transaction, as published to subscribers
+static Json::Value
+makeTransaction(int seq)
+{
+    Json::Value jv(Json::objectValue);
+    jv["type"] = "transaction";
+    jv["validated"] = true;
+    jv["ledger_index"] = 80000000 + seq;
+    jv["engine_result"] = "tesSUCCESS";
+    auto& tx = jv["transaction"];
+    tx["Account"] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+    tx["Destination"] = "rPT1Sjq2YGrBMTttX4GZHjKu9dyfzbpAYe";
+    tx["Amount"] = std::to_string(1000000 + seq);
+    tx["Fee"] = "12";
+    tx["Sequence"] = seq;
+    tx["TransactionType"] = "Payment";
+    tx["hash"] = std::string(64, 'A');
+    auto& nodes = jv["meta"]["AffectedNodes"];
+    for (int i = 0; i < 8; ++i)
+    {
+        auto& node = nodes[i]["ModifiedNode"];
+        node["LedgerEntryType"] = "AccountRoot";
+        node["LedgerIndex"] = std::string(64, 'B');
+        node["FinalFields"]["Balance"] = std::to_string(i * 1000);
+        node["FinalFields"]["Flags"] = 0;
+        node["PreviousFields"]["Balance"] = std::to_string(i * 999);
+    }
+    return jv;
+}
+
+// Everything a WebSocket message would write, in writes of up to `bytes`
+static std::string
+drain(WSMsg& m, std::size_t bytes)
+{
+    std::string s;
+    for (;;)
+    {
+        auto const [done, buffers] = m.prepare(bytes, [] {});
+        for (auto const& b : buffers)
+            s.append(static_cast<char const*>(b.data()), b.size());
+        if (done)
+            return s;
+    }
+}
+
+struct SharedJson_test : beast::unit_test::suite
+{
+    void
+    testText()
+    {
+        testcase("text");
+
+        auto const jv = makeTransaction(1);
+        SharedJson const msg{jv};
+        BEAST_EXPECT(&msg.json() == &jv);
+
+        // The text is made once, and is what the value serializes to
+        auto const text = msg.text();
+        BEAST_EXPECT(msg.text() == text);
+
+        Json::Value parsed;
+        BEAST_EXPECT(Json::Reader().parse(*text, parsed));
+        BEAST_EXPECT(parsed == jv);
+    }
+
+    void
+    testVersions()
+    {
+        testcase("versions");
+
+        MultiApiJson jv{makeTransaction(1)};
+        jv.val[0]["ledger_index"] = "80000001";
+
+        MultiApiSharedJson const msg{jv};
+        for (unsigned int version = 1; version <= 3; ++version)
+        {
+            auto const& selected = msg.select(apiVersionSelector(version));
+            BEAST_EXPECT(
+                &selected.json() == &jv.select(apiVersionSelector(version)));
+        }
+        BEAST_EXPECT(
+            *msg.select(apiVersionSelector(1)).text() !=
+            *msg.select(apiVersionSelector(2)).text());
+    }
+
+    void
+    testMessage()
+    {
+        testcase("message");
+
+        auto const jv = makeTransaction(1);
+        SharedJson const msg{jv};
+        auto const& text = *msg.text();
+
+        // Each message writes all of the text, however it is split up
+        for (std::size_t const bytes :
+             {std::size_t{1}, std::size_t{7}, text.size(), text.size() + 1})
+        {
+            SharedWSMsg m{msg.text()};
+            BEAST_EXPECT(drain(m, bytes) == text);
+        }
+
+        // The text is not consumed by the messages that share it
+        SharedWSMsg first{msg.text()};
+        SharedWSMsg second{msg.text()};
+        BEAST_EXPECT(drain(first, 64) == text);
+        BEAST_EXPECT(drain(second, 64) == text);
+
+        SharedWSMsg empty{std::make_shared<std::string const>()};
+        BEAST_EXPECT(drain(empty, 64).empty());
+    }
+
+    void
+    run() override
+    {
+        testText();
+        testVersions();
+        testMessage();
+    }
+};
+
+/** Measures publishing a transaction to WebSocket subscribers, with the
+    message serialized for each subscriber and serialized once and shared.
+*/
+struct SharedJson_bench_test : beast::unit_test::suite
+{
+    static constexpr int subscribers = 10000;
+    static constexpr int transactions = 20;
+
+    template <class Publish>
+    void
+    measure(char const* name, Publish&& publish)
+    {
+        using namespace std::chrono;
+
+        std::size_t bytes = 0;
+        auto const start = steady_clock::now();
+        for (int i = 0; i < transactions; ++i)
+        {
+            auto const jv = makeTransaction(i);
+            std::vector<std::shared_ptr<WSMsg>> queued;
+            queued.reserve(subscribers);
+            publish(jv, queued);
+            for (auto const& m : queued)
+                bytes += drain(*m, 65536).size();
+        }
+        auto const elapsed =
+            duration_cast<duration<double>>(steady_clock::now() - start);
+
+        log << name << ": "
+            << static_cast<std::uint64_t>(
+                   transactions * subscribers / elapsed.count())
+            << " messages/s, " << bytes / (transactions * subscribers)
+            << " bytes each" << std::endl;
+    }
+
+    void
+    run() override
+    {
+        measure(
+            "serialized per subscriber",
+            [](Json::Value const& jv,
+               std::vector<std::shared_ptr<WSMsg>>& queued) {
+                for (int i = 0; i < subscribers; ++i)
+                {
+                    boost::beast::multi_buffer sb;
+                    Json::stream(jv, [&](void const* data, std::size_t n) {
+                        sb.commit(boost::asio::buffer_copy(
+                            sb.prepare(n), boost::asio::buffer(data, n)));
+                    });
+                    queued.push_back(
+                        std::make_shared<StreambufWSMsg<decltype(sb)>>(
+                            std::move(sb)));
+                }
+            });
+
+        measure(
+            "serialized once",
+            [](Json::Value const& jv,
+               std::vector<std::shared_ptr<WSMsg>>& queued) {
+                SharedJson const msg{jv};
+                for (int i = 0; i < subscribers; ++i)
+                    queued.push_back(std::make_shared<SharedWSMsg>(msg.text()));
+            });
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SharedJson, ripple_basics, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SharedJson_bench, ripple_basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
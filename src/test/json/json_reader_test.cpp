@@ -0,0 +1,510 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class json_reader_test : public beast::unit_test::suite
+{
+    beast::xor_shift_engine engine_{20230901};
+
+    std::size_t plain_ = 0;
+
+    int
+    random(int n)
+    {
+        return std::uniform_int_distribution<int>(0, n - 1)(engine_);
+    }
+
+    // Whether two values are identical, including the types of numbers
+    // and the signs of zeros.
+    static bool
+    same(Json::Value const& x, Json::Value const& y)
+    {
+        if (x.type() != y.type())
+            return false;
+
+        switch (x.type())
+        {
+            case Json::realValue:
+                return x.asDouble() == y.asDouble() &&
+                    std::signbit(x.asDouble()) == std::signbit(y.asDouble());
+
+            case Json::arrayValue:
+                if (x.size() != y.size())
+                    return false;
+                for (Json::UInt i = 0; i < x.size(); ++i)
+                    if (!same(x[i], y[i]))
+                        return false;
+                return true;
+
+            case Json::objectValue: {
+                if (x.getMemberNames() != y.getMemberNames())
+                    return false;
+                for (auto it = x.begin(); it != x.end(); ++it)
+                    if (!same(*it, y[it.memberName()]))
+                        return false;
+                return true;
+            }
+
+            default:
+                return x == y;
+        }
+    }
+
+    // Parses a document with and without the fast path, and checks that
+    // the outcome is the same.
+    void
+    check(std::string const& document)
+    {
+        Json::Value fast;
+        Json::Reader fastReader;
+        bool const fastOk = fastReader.parse(document, fast);
+
+        Json::Value full;
+        Json::Reader fullReader;
+        bool const fullOk = fullReader.parseTokens(
+            document.data(), document.data() + document.size(), full);
+
+        Json::Value plain;
+        if (Json::Reader::parsePlain(
+                document.data(), document.data() + document.size(), plain))
+        {
+            ++plain_;
+            BEAST_EXPECTS(fullOk && same(plain, full), document);
+        }
+
+        BEAST_EXPECTS(fastOk == fullOk, document);
+        if (fastOk && fullOk)
+            BEAST_EXPECTS(same(fast, full), document);
+        else
+            BEAST_EXPECTS(
+                fastReader.getFormatedErrorMessages() ==
+                    fullReader.getFormatedErrorMessages(),
+                document);
+    }
+
+    bool
+    isPlain(std::string const& document)
+    {
+        Json::Value value;
+        return Json::Reader::parsePlain(
+            document.data(), document.data() + document.size(), value);
+    }
+
+    void
+    testDocuments()
+    {
+        testcase("documents");
+
+        char const* const documents[] = {
+            R"({})",
+            R"([])",
+            R"(null)",
+            R"( { "a" : [ 1 , 2.5 , -3 , true , false , null , "x" ] } )",
+            "{\n\t\"method\": \"account_info\",\r\n\t\"params\": [{}]\n}",
+            R"({"s":"\"\\\/\b\f\n\r\tAé中😀"})",
+            R"({"lone":"\udc00\ud800\u0000x"})",
+            R"({"bad":"\ud800x"})",
+            R"({"bad":"\ud800\u00"})",
+            R"({"bad":"\q"})",
+            R"({"bad":"\u12G4"})",
+            R"({"unterminated":"abc)",
+            R"({"i":[0,-0,2147483647,2147483648,4294967295,-2147483648]})",
+            R"({"i":4294967296})",
+            R"({"i":-2147483649})",
+            R"({"i":007})",
+            R"({"d":[0.1,-0.0,1e5,1E+5,1e-5,2.5e400,4.9e-324]})",
+            R"({"d":1.7976931348623157e308})",
+            R"({"d":12345678901234567890123456789012345678.5})",
+            R"({"d":1.})",
+            R"({"d":.5})",
+            R"({"d":-.5})",
+            R"({"d":1.2.3})",
+            R"({"d":1e})",
+            R"({"d":1-2})",
+            R"({"d":-})",
+            R"({"a":1,"a":2})",
+            R"({"a":1,})",
+            R"({"":1,})",
+            R"([1,])",
+            R"([,1])",
+            R"({"a" 1})",
+            R"({"a":tru})",
+            R"({"a":truex})",
+            R"({"a":1} trailing)",
+            R"({"a":1} // comment)",
+            R"(// comment
+               {"a":1})",
+            R"({"a": /* comment */ 1})",
+            R"("string")",
+            R"(42)",
+            R"(true)",
+            "",
+            "   ",
+        };
+
+        for (auto const document : documents)
+            check(document);
+
+        check(std::string("{\"nul\":\"x\0y\"}", 13));
+        check(std::string("{\"a\":1}\0{", 9));
+        check(std::string("{\"a\":\0}", 7));
+
+        BEAST_EXPECT(isPlain(R"( {"a" : [1, 2.5, "x"]} )"));
+        BEAST_EXPECT(isPlain(R"({"s":"\"\u00e9\ud83d\ude00"})"));
+        BEAST_EXPECT(isPlain(R"({"i":007})"));
+        BEAST_EXPECT(!isPlain(R"({"i":4294967296})"));
+        BEAST_EXPECT(!isPlain(R"({"a":1,"a":2})"));
+        BEAST_EXPECT(!isPlain(R"({"a":1} // comment)"));
+        BEAST_EXPECT(!isPlain(R"({"d":1.})"));
+    }
+
+    void
+    testNesting()
+    {
+        testcase("nesting");
+
+        for (unsigned depth = 0; depth <= Json::Reader::nest_limit + 2;
+             ++depth)
+        {
+            std::string array, object;
+            for (unsigned i = 0; i < depth; ++i)
+            {
+                array += "[";
+                object += "{\"o\":";
+            }
+            array += "[1]";
+            object += "{\"o\":1}";
+            for (unsigned i = 0; i < depth; ++i)
+            {
+                array += "]";
+                object += "}";
+            }
+            check(array);
+            check(object);
+            BEAST_EXPECT(
+                isPlain(array) == (depth + 1 <= Json::Reader::nest_limit));
+        }
+    }
+
+    std::string
+    randomSpace()
+    {
+        static char const spaces[] = {' ', '\t', '\r', '\n'};
+        std::string result;
+        if (random(3) == 0)
+            for (int n = random(20); n > 0; --n)
+                result += spaces[random(4)];
+        return result;
+    }
+
+    std::string
+    randomString()
+    {
+        static char const escapes[] = {'"', '\\', '/', 'b', 'f', 'n', 'r', 't'};
+        std::string result = "\"";
+        for (int n = random(random(8) == 0 ? 100 : 12); n > 0; --n)
+        {
+            switch (random(8))
+            {
+                case 0:
+                    result += '\\';
+                    result += escapes[random(8)];
+                    break;
+                case 1: {
+                    char buffer[8];
+                    unsigned const unit = random(4) == 0
+                        ? 0xD800 + random(0x800)
+                        : random(0x10000);
+                    snprintf(buffer, sizeof(buffer), "\\u%04X", unit);
+                    result += buffer;
+                    break;
+                }
+                case 2:
+                    // Raw bytes, including control characters and UTF-8
+                    result += static_cast<char>(1 + random(255));
+                    if (result.back() == '"' || result.back() == '\\')
+                        result.back() = 'q';
+                    break;
+                default:
+                    result += static_cast<char>('a' + random(26));
+                    break;
+            }
+        }
+        return result + "\"";
+    }
+
+    std::string
+    randomNumber()
+    {
+        char buffer[64];
+        switch (random(5))
+        {
+            case 0:
+                return std::to_string(random(1000) - 500);
+            case 1:
+                return std::to_string(
+                    std::uniform_int_distribution<std::int64_t>(
+                        -3'000'000'000, 5'000'000'000)(engine_));
+            case 2:
+                snprintf(
+                    buffer,
+                    sizeof(buffer),
+                    "%.17g",
+                    std::uniform_real_distribution<double>(-1e6, 1e6)(
+                        engine_));
+                return buffer;
+            case 3:
+                snprintf(
+                    buffer,
+                    sizeof(buffer),
+                    "%d.%de%c%d",
+                    random(100),
+                    random(1000),
+                    "+-"[random(2)],
+                    random(400));
+                return buffer;
+            default:
+                snprintf(
+                    buffer, sizeof(buffer), "%dE%d", random(10), random(30));
+                return buffer;
+        }
+    }
+
+    std::string
+    randomValue(unsigned depth, bool container = false)
+    {
+        auto const choice =
+            container ? 6 + random(2) : random(depth > 6 ? 6 : 8);
+        switch (choice)
+        {
+            case 0:
+                return "true";
+            case 1:
+                return "false";
+            case 2:
+                return "null";
+            case 3:
+            case 4:
+                return randomString();
+            case 5:
+                return randomNumber();
+            case 6: {
+                std::string result = "[" + randomSpace();
+                for (int n = random(6); n > 0; --n)
+                {
+                    result += randomValue(depth + 1) + randomSpace();
+                    if (n > 1)
+                        result += "," + randomSpace();
+                }
+                return result + "]";
+            }
+            default: {
+                std::string result = "{" + randomSpace();
+                for (int n = random(6); n > 0; --n)
+                {
+                    // Mostly short names, so that some are duplicated
+                    auto const name = random(4) == 0
+                        ? randomString()
+                        : "\"" + std::string(1, 'a' + random(8)) + "\"";
+                    result += name + randomSpace() + ":" + randomSpace() +
+                        randomValue(depth + 1) + randomSpace();
+                    if (n > 1)
+                        result += "," + randomSpace();
+                }
+                return result + "}";
+            }
+        }
+    }
+
+    void
+    mutate(std::string& document)
+    {
+        static char const tokens[] = "{}[]\",:\\/*0123456789-+.eEtfnu \n";
+
+        if (document.empty())
+            return;
+
+        auto const at = random(document.size());
+        switch (random(4))
+        {
+            case 0:
+                document.erase(at, 1);
+                break;
+            case 1:
+                document.insert(
+                    document.begin() + at, tokens[random(sizeof(tokens) - 1)]);
+                break;
+            case 2:
+                document[at] = static_cast<char>(random(256));
+                break;
+            default:
+                document.insert(at, document.substr(at, random(10)));
+                break;
+        }
+    }
+
+    void
+    testDifferential()
+    {
+        testcase("differential");
+
+        std::size_t const count = 20000;
+        plain_ = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto const document =
+                randomSpace() + randomValue(random(7), true) + randomSpace();
+            check(document);
+            check(randomValue(6));
+
+            auto mutated = document;
+            for (int n = 1 + random(3); n > 0; --n)
+                mutate(mutated);
+            check(mutated);
+        }
+
+        // Most generated documents, and some others, are plain.
+        log << plain_ << " of " << 3 * count << " documents were plain"
+            << std::endl;
+        BEAST_EXPECT(plain_ > count);
+    }
+
+    void
+    run() override
+    {
+        testDocuments();
+        testNesting();
+        testDifferential();
+    }
+};
+
+/** Measures the parsing throughput of typical requests, with the fast path
+    and with the full parser alone.
+*/
+class json_reader_bench_test : public beast::unit_test::suite
+{
+public:
+    void
+    measure(char const* name, std::string const& document)
+    {
+        using namespace std::chrono;
+
+        std::size_t const count = 200'000;
+
+        auto const time = [&](auto&& parse) {
+            auto const start = steady_clock::now();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Json::Value value;
+                BEAST_EXPECT(parse(value));
+            }
+            return duration_cast<duration<double>>(
+                       steady_clock::now() - start)
+                .count();
+        };
+
+        auto const fast = time([&](Json::Value& value) {
+            return Json::Reader().parse(document, value);
+        });
+        auto const full = time([&](Json::Value& value) {
+            return Json::Reader().parseTokens(
+                document.data(), document.data() + document.size(), value);
+        });
+
+        auto const rate = [&](double elapsed) {
+            return static_cast<std::uint64_t>(
+                count * document.size() / elapsed / (1024 * 1024));
+        };
+        log << name << " (" << document.size() << " bytes): "
+            << rate(fast) << " MiB/s, full parser " << rate(full)
+            << " MiB/s" << std::endl;
+    }
+
+    void
+    run() override
+    {
+        measure(
+            "account_info",
+            R"({"method":"account_info","params":[{"account":)"
+            R"("rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh","ledger_index":)"
+            R"("validated","strict":true}]})");
+
+        measure(
+            "tx",
+            R"({"id":7,"command":"tx","transaction":)"
+            R"("E08D6E9754025BA2534A78707605E060)"
+            R"(1F03ACE063687A0CA1BDDACFCD1698C7",)"
+            R"("binary":false})");
+
+        measure(
+            "submit",
+            R"({
+    "method": "submit",
+    "params": [
+        {
+            "secret": "snoPBrXtMeMyMHUVTgbuqAfg1SUTb",
+            "tx_json": {
+                "TransactionType": "Payment",
+                "Account": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+                "Destination": "ra5nK24KXen9AHvsdFTKHSANinZseWnPcX",
+                "Amount": {
+                    "currency": "USD",
+                    "value": "1.25",
+                    "issuer": "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn"
+                },
+                "SendMax": "2000000",
+                "Fee": "12",
+                "Sequence": 360,
+                "LastLedgerSequence": 7835923,
+                "Memos": [
+                    {
+                        "Memo": {
+                            "MemoType": "746578742F706C61696E",
+                            "MemoData": "72656E74"
+                        }
+                    }
+                ]
+            },
+            "fee_mult_max": 1000
+        }
+    ]
+})");
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(json_reader, json, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(json_reader_bench, json, ripple);
+
+}  // namespace ripple
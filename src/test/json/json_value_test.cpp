@@ -26,6 +26,8 @@
 
 #include <algorithm>
 #include <regex>
+#include <string>
+#include <vector>
 
 namespace ripple {
 
@@ -1372,6 +1374,124 @@ struct json_value_test : beast::unit_test::suite
         }
     }
 
+    void
+    test_storage()
+    {
+        {
+            // References to members stay valid as others are added and
+            // removed around them.
+            Json::Value v;
+            Json::Value& m = v["m"];
+            m = "member";
+            Json::Value& e = v["e"][1u];
+            e = 1;
+            for (int i = 0; i < 100; ++i)
+            {
+                v[std::to_string(i)] = i;
+                v["e"].append(i);
+            }
+            v.removeMember("0");
+            v.removeMember("a");
+            BEAST_EXPECT(&m == &v["m"]);
+            BEAST_EXPECT(m.asString() == "member");
+            BEAST_EXPECT(&e == &v["e"][1u]);
+            BEAST_EXPECT(e.asInt() == 1);
+            BEAST_EXPECT(v["e"].size() == 102);
+            BEAST_EXPECT(v["e"][0u].isNull());
+        }
+        {
+            // Members inserted in any order are kept sorted, whether their
+            // names are static or not.
+            static Json::StaticString const early("000");
+            static Json::StaticString const late("zzz");
+            Json::Value v;
+            std::vector<std::string> names;
+            for (int i = 0; i < 500; ++i)
+            {
+                auto const name = std::to_string((i * 7919) % 500);
+                v[name] = i;
+                names.push_back(name);
+            }
+            v[late] = "late";
+            v[early] = "early";
+            names.push_back(late.c_str());
+            names.push_back(early.c_str());
+            std::sort(names.begin(), names.end());
+
+            BEAST_EXPECT(v.size() == names.size());
+            BEAST_EXPECT(v.getMemberNames() == names);
+            BEAST_EXPECT(v["000"].asString() == "early");
+            BEAST_EXPECT(v[std::string("zzz")].asString() == "late");
+            BEAST_EXPECT(v["123"].isInt());
+
+            std::size_t i = 0;
+            for (auto it = v.begin(); it != v.end(); ++it, ++i)
+                BEAST_EXPECT(it.memberName() == names[i]);
+            BEAST_EXPECT(i == names.size());
+
+            Json::Value const copy = v;
+            BEAST_EXPECT(copy == v);
+            BEAST_EXPECT(!(copy < v) && !(v < copy));
+
+            for (int n = 0; n < 500; n += 2)
+                BEAST_EXPECT(!v.removeMember(std::to_string(n)).isNull());
+            BEAST_EXPECT(v.size() == 252);
+            BEAST_EXPECT(!v.isMember("2") && v.isMember("3"));
+            BEAST_EXPECT(copy.size() == 502);
+            BEAST_EXPECT(copy != v);
+            BEAST_EXPECT(v < copy);
+        }
+        {
+            // Arrays filled out of order still index correctly.
+            Json::Value v;
+            v[5u] = 5;
+            v[2u] = 2;
+            v[9u] = 9;
+            v.append(10);
+            BEAST_EXPECT(v.size() == 11);
+            BEAST_EXPECT(v[2u] == 2 && v[5u] == 5 && v[9u] == 9);
+            BEAST_EXPECT(v[10u] == 10);
+            BEAST_EXPECT(v[3u].isNull());
+        }
+        {
+            // Parsing an object whose keys arrive in descending order
+            // inserts every member at the front.
+            int const count = 50000;
+            std::string text = "{";
+            for (int i = count; i > 0; --i)
+            {
+                text += "\"k" + std::to_string(1000000 + i) + "\":" +
+                    std::to_string(i);
+                text += i == 1 ? "}" : ",";
+            }
+            Json::Value v;
+            Json::Reader r;
+            BEAST_EXPECT(r.parse(text, v));
+            BEAST_EXPECT(v.size() == count);
+            BEAST_EXPECT(v.begin().memberName() == std::string("k1000001"));
+            BEAST_EXPECT(v["k1000001"] == 1);
+            BEAST_EXPECT(v["k1050000"] == count);
+        }
+        {
+            // Iterators stay valid while other members are added and
+            // removed.
+            Json::Value v;
+            for (int i = 0; i < 100; i += 2)
+                v[std::to_string(1000 + i)] = i;
+            int visited = 0;
+            for (auto it = v.begin(); it != v.end(); ++it, ++visited)
+            {
+                auto const n = (*it).asInt();
+                if (n < 99)
+                    v[std::to_string(1000 + n + 1)] = n + 1;
+                v.removeMember(std::to_string(1000 + n - 1));
+            }
+            BEAST_EXPECT(visited == 100);
+            BEAST_EXPECT(v.size() == 1);
+            BEAST_EXPECT(v.isMember("1099"));
+        }
+    }
+
     void
     run() override
     {
@@ -1391,6 +1511,7 @@ struct json_value_test : beast::unit_test::suite
         test_iterator();
         test_nest_limits();
         test_leak();
+        test_storage();
     }
 };
 
@@ -0,0 +1,329 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/rngfill.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/ledger/Sandbox.h>
+#include <ripple/ledger/detail/KeyedTable.h>
+#include <test/jtx.h>
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+static uint256
+randomKey()
+{
+    uint256 key;
+    beast::rngfill(key.data(), key.size(), default_prng());
+    return key;
+}
+
+class KeyedTable_test : public beast::unit_test::suite
+{
+    using Table = detail::KeyedTable<int>;
+    using Map = std::map<uint256, int>;
+
+    // Whether the table holds what the map does, in the same order.
+    static bool
+    same(Table const& table, Map const& map)
+    {
+        if (table.size() != map.size())
+            return false;
+        auto iter = table.begin();
+        for (auto const& [key, value] : map)
+        {
+            if (iter == table.end() || iter->first != key ||
+                iter->second != value)
+                return false;
+            ++iter;
+        }
+        return iter == table.end();
+    }
+
+    void
+    testRandom()
+    {
+        testcase("random operations");
+
+        // Few enough keys that they are often added again after being
+        // erased, and enough erasing that the table gets compacted.
+        for (std::size_t keyCount : {1, 10, 300, 3000})
+        {
+            std::vector<uint256> keys;
+            for (std::size_t i = 0; i < keyCount; ++i)
+                keys.push_back(randomKey());
+
+            Table table;
+            Map map;
+            bool ok = true;
+            for (int op = 0; ok && op < 30000; ++op)
+            {
+                auto const& key = keys[rand_int(keyCount - 1)];
+                switch (rand_int(9))
+                {
+                    case 0:
+                    case 1:
+                    case 2:
+                    case 3: {
+                        auto const value = rand_int(1000);
+                        auto const t = table.emplace(key, value);
+                        auto const m = map.emplace(key, value);
+                        ok = t.second == m.second &&
+                            *t.first == m.first->second;
+                        break;
+                    }
+                    case 4:
+                    case 5:
+                    case 6:
+                        table.erase(key);
+                        map.erase(key);
+                        break;
+                    case 7: {
+                        auto const t = table.find(key);
+                        auto const m = map.find(key);
+                        ok = (t != nullptr) == (m != map.end()) &&
+                            (!t || *t == m->second);
+                        if (ok && t)
+                            ++*t, ++m->second;
+                        break;
+                    }
+                    case 8: {
+                        auto t = table.upper_bound(key);
+                        auto m = map.upper_bound(key);
+                        for (int i = 0; ok && i < 4 && m != map.end(); ++i)
+                        {
+                            ok = t != table.end() && t->first == m->first &&
+                                t->second == m->second;
+                            ++t, ++m;
+                        }
+                        ok = ok && ((t == table.end()) == (m == map.end()));
+                        break;
+                    }
+                    default:
+                        ok = same(table, map) && same(Table(table), map);
+                        break;
+                }
+            }
+            BEAST_EXPECT(ok);
+            BEAST_EXPECT(same(table, map));
+        }
+    }
+
+    void
+    testSucc()
+    {
+        testcase("succ through views");
+
+        using namespace jtx;
+        Env env(*this);
+        OpenView open(
+            open_ledger,
+            &*env.app().getLedgerMaster().getClosedLedger(),
+            env.current()->rules());
+
+        // Entries added to and erased from an open view and a sandbox on
+        // top of it, in random order, are found in key order.
+        std::map<uint256, bool> expected;
+        for (auto sle : env.closed()->sles)
+            expected.emplace(sle->key(), true);
+
+        std::vector<std::shared_ptr<SLE>> added;
+        for (int i = 0; i < 500; ++i)
+        {
+            auto const sle =
+                std::make_shared<SLE>(Keylet{ltACCOUNT_ROOT, randomKey()});
+            sle->setFieldU32(sfSequence, i);
+            open.rawInsert(sle);
+            expected.emplace(sle->key(), true);
+            added.push_back(sle);
+        }
+        for (std::size_t i = 0; i < added.size(); i += 3)
+        {
+            open.rawErase(added[i]);
+            expected.erase(added[i]->key());
+        }
+
+        Sandbox sb(&open, tapNONE);
+        for (std::size_t i = 1; i < added.size(); i += 3)
+        {
+            sb.erase(sb.peek(keylet::unchecked(added[i]->key())));
+            expected.erase(added[i]->key());
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            auto const sle =
+                std::make_shared<SLE>(Keylet{ltACCOUNT_ROOT, randomKey()});
+            sb.insert(sle);
+            expected.emplace(sle->key(), true);
+        }
+
+        std::vector<uint256> found;
+        for (auto key = sb.succ(uint256{}); key; key = sb.succ(*key))
+            found.push_back(*key);
+        std::vector<uint256> keys;
+        for (auto const& item : expected)
+            keys.push_back(item.first);
+        BEAST_EXPECT(found == keys);
+
+        std::vector<uint256> iterated;
+        for (auto const& sle : sb.sles)
+            iterated.push_back(sle->key());
+        BEAST_EXPECT(iterated == keys);
+    }
+
+    void
+    run() override
+    {
+        testRandom();
+        testSucc();
+    }
+};
+
+/** Measures the state tables of views under the access patterns of
+    applying transactions: a sandbox per transaction that reads, changes
+    and searches a few entries, over an open view that grows to hold a
+    full ledger's worth of changes; and offers crossing in a ledger.
+*/
+class KeyedTable_bench_test : public beast::unit_test::suite
+{
+    void
+    measureOpenView(std::size_t txCount)
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env(*this);
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        OpenView open(open_ledger, &*closed, closed->rules());
+
+        std::vector<Keylet> accounts;
+        auto const start = steady_clock::now();
+        for (std::size_t tx = 0; tx < txCount; ++tx)
+        {
+            Sandbox sb(&open, tapNONE);
+
+            // Create an entry, change a few earlier ones, and search for
+            // the entries after one of them.
+            Keylet const created{ltACCOUNT_ROOT, randomKey()};
+            auto const sle = std::make_shared<SLE>(created);
+            sle->setFieldU32(sfSequence, 1);
+            sb.insert(sle);
+
+            for (int i = 0; i < 4 && !accounts.empty(); ++i)
+            {
+                auto const& k = accounts[rand_int(accounts.size() - 1)];
+                if (auto const modified = sb.peek(k))
+                {
+                    modified->setFieldU32(
+                        sfSequence, modified->getFieldU32(sfSequence) + 1);
+                    sb.update(modified);
+                }
+                auto key = sb.succ(k.key);
+                for (int j = 0; key && j < 4; ++j)
+                    key = sb.succ(*key);
+            }
+
+            sb.apply(open);
+            accounts.push_back(created);
+        }
+        auto const applied = steady_clock::now();
+
+        std::size_t count = 0;
+        for (auto const& sle : open.sles)
+            count += sle != nullptr;
+        auto const iterated = steady_clock::now();
+
+        log << txCount << " transactions over an open view: "
+            << duration_cast<milliseconds>(applied - start).count()
+            << "ms, iterating " << count << " entries: "
+            << duration_cast<microseconds>(iterated - applied).count()
+            << "us" << std::endl;
+    }
+
+    void
+    measureOffers(std::size_t offerCount)
+    {
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env(*this, envconfig([offerCount](std::unique_ptr<Config> cfg) {
+            cfg->section("transaction_queue")
+                .set(
+                    "minimum_txn_in_ledger_standalone",
+                    std::to_string(2 * offerCount));
+            return cfg;
+        }));
+
+        Account const gw("gateway");
+        auto const USD = gw["USD"];
+        std::vector<Account> accounts;
+        for (int i = 0; i < 50; ++i)
+            accounts.emplace_back("trader" + std::to_string(i));
+        env.fund(XRP(1000000), gw);
+        for (auto const& account : accounts)
+            env.fund(XRP(1000000), account);
+        env.close();
+        for (auto const& account : accounts)
+            env(trust(account, USD(1000000)));
+        env.close();
+        for (auto const& account : accounts)
+            env(pay(gw, account, USD(100000)));
+        env.close();
+
+        // Every other offer crosses some of those before it.
+        auto const start = steady_clock::now();
+        for (std::size_t i = 0; i < offerCount; ++i)
+        {
+            auto const& account = accounts[i % accounts.size()];
+            if (i % 2 == 0)
+                env(offer(account, XRP(100 + i % 7), USD(1)));
+            else
+                env(offer(account, USD(3), XRP(280 + i % 11)));
+        }
+        env.close();
+        auto const elapsed = steady_clock::now() - start;
+
+        log << offerCount << " offers: "
+            << duration_cast<milliseconds>(elapsed).count() << "ms"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        measureOpenView(5000);
+        measureOpenView(20000);
+        measureOffers(2000);
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(KeyedTable, ledger, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(KeyedTable_bench, ledger, ripple);
+
+}  // namespace test
+}  // namespace ripple
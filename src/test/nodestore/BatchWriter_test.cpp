@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/impl/BatchWriter.h>
+#include <test/nodestore/TestBase.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+// Tests the pipelining of the BatchWriter
+//
+class BatchWriter_test : public TestBase
+{
+    // Runs every task on a thread of its own
+    class ThreadScheduler : public Scheduler
+    {
+    public:
+        ~ThreadScheduler()
+        {
+            std::lock_guard lock(mutex_);
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        void
+        scheduleTask(Task& task) override
+        {
+            std::lock_guard lock(mutex_);
+            threads_.emplace_back([&task]() { task.performScheduledTask(); });
+        }
+
+        void
+        onFetch(FetchReport const&) override
+        {
+        }
+
+        void
+        onBatchWrite(BatchWriteReport const& report) override
+        {
+            writeCount += report.writeCount;
+        }
+
+        std::atomic<int> writeCount{0};
+
+    private:
+        std::mutex mutex_;
+        std::vector<std::thread> threads_;
+    };
+
+    // Encodes each object as its payload and records what gets written
+    class Recorder : public BatchWriter::Callback
+    {
+    public:
+        explicit Recorder(std::chrono::milliseconds writeDelay)
+            : writeDelay_(writeDelay)
+        {
+        }
+
+        void
+        encodeBatch(Batch const& batch, EncodedBatch& encoded) override
+        {
+            if (writing_)
+                overlapped = true;
+
+            for (auto const& object : batch)
+                encoded.add(
+                    object->getHash().data(),
+                    object->getData().data(),
+                    object->getData().size());
+
+            auto const pending = ++encoded_ - written_;
+            if (pending > maxPending)
+                maxPending = pending;
+        }
+
+        void
+        writeBatch(EncodedBatch const& batch) override
+        {
+            writing_ = true;
+            std::this_thread::sleep_for(writeDelay_);
+
+            {
+                std::lock_guard lock(mutex_);
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                {
+                    keys_.push_back(batch.key(i));
+                    auto const data = batch.data(i);
+                    data_.emplace_back(data.begin(), data.end());
+                }
+            }
+
+            ++written_;
+            writing_ = false;
+        }
+
+        // Whether a batch was encoded while another was being written
+        std::atomic<bool> overlapped{false};
+
+        // The most batches that were encoded but not yet written
+        std::atomic<int> maxPending{0};
+
+        bool
+        wrote(Batch const& batch)
+        {
+            std::lock_guard lock(mutex_);
+            if (keys_.size() != batch.size())
+                return false;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                if (keys_[i] != batch[i]->getHash() ||
+                    data_[i] != batch[i]->getData())
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        std::chrono::milliseconds const writeDelay_;
+        std::atomic<bool> writing_{false};
+        std::atomic<int> encoded_{0};
+        std::atomic<int> written_{0};
+        std::mutex mutex_;
+        std::vector<uint256> keys_;
+        std::vector<Blob> data_;
+    };
+
+public:
+    void
+    testSynchronous()
+    {
+        testcase("synchronous");
+
+        auto const batch = createPredictableBatch(numObjectsToTest, 1);
+
+        DummyScheduler scheduler;
+        Recorder recorder{std::chrono::milliseconds{0}};
+        {
+            BatchWriter writer(recorder, scheduler);
+            for (auto const& object : batch)
+                writer.store(object);
+            BEAST_EXPECT(writer.getWriteLoad() == 0);
+        }
+        BEAST_EXPECT(recorder.wrote(batch));
+        BEAST_EXPECT(!recorder.overlapped);
+    }
+
+    void
+    testPipelined()
+    {
+        testcase("pipelined");
+
+        auto const batch = createPredictableBatch(numObjectsToTest, 2);
+
+        Section config;
+        config.set("batch_write_limit", "64");
+        config.set("batch_write_queue", "2");
+
+        ThreadScheduler scheduler;
+        Recorder recorder{std::chrono::milliseconds{2}};
+        {
+            BatchWriter writer(recorder, scheduler, config);
+            for (auto const& object : batch)
+            {
+                writer.store(object);
+                BEAST_EXPECT(writer.getWriteLoad() <= 64 * 3);
+            }
+        }
+
+        // Everything is written once, in the order it was stored, and
+        // later batches were encoded while earlier ones were written, but
+        // no more than the queue allows.
+        BEAST_EXPECT(recorder.wrote(batch));
+        BEAST_EXPECT(scheduler.writeCount == numObjectsToTest);
+        BEAST_EXPECT(recorder.overlapped);
+        BEAST_EXPECT(recorder.maxPending <= 2);
+    }
+
+    void
+    testConfig()
+    {
+        testcase("config");
+
+        DummyScheduler scheduler;
+        Recorder recorder{std::chrono::milliseconds{0}};
+
+        auto const rejects = [&](char const* name) {
+            Section config;
+            config.set(name, "0");
+            try
+            {
+                BatchWriter writer(recorder, scheduler, config);
+            }
+            catch (std::runtime_error const&)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        BEAST_EXPECT(rejects("batch_write_limit"));
+        BEAST_EXPECT(rejects("batch_write_queue"));
+    }
+
+    void
+    run() override
+    {
+        testSynchronous();
+        testPipelined();
+        testConfig();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BatchWriter, NodeStore, ripple);
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/DatabaseRotatingImp.h>
+#include <test/nodestore/TestBase.h>
+#include <test/unit_test/SuiteJournal.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+// A rotating database over backends of one type, in a temporary directory
+class RotatingFixture
+{
+public:
+    RotatingFixture(
+        std::string type,
+        beast::unit_test::suite& suite,
+        std::string const& name)
+        : type_(std::move(type)), journal_(name, suite)
+    {
+    }
+
+    std::unique_ptr<Backend>
+    makeBackend()
+    {
+        Section params;
+        params.set("type", type_);
+        params.set("path", dir_.file(std::to_string(backends_++)));
+        auto backend = Manager::instance().make_Backend(
+            params, megabytes(4), scheduler_, journal_);
+        backend->open();
+        return backend;
+    }
+
+    std::unique_ptr<DatabaseRotatingImp>
+    makeDatabase(std::shared_ptr<Backend> writable)
+    {
+        Section config;
+        config.set("type", type_);
+        return std::make_unique<DatabaseRotatingImp>(
+            scheduler_,
+            1,
+            std::move(writable),
+            makeBackend(),
+            config,
+            journal_);
+    }
+
+    // Rotate, returning the new writable backend
+    Backend*
+    rotate(DatabaseRotatingImp& db)
+    {
+        Backend* writable = nullptr;
+        db.rotateWithLock([&](std::string const&) {
+            auto backend = makeBackend();
+            writable = backend.get();
+            return backend;
+        });
+        return writable;
+    }
+
+private:
+    std::string const type_;
+    test::SuiteJournal journal_;
+    DummyScheduler scheduler_;
+    beast::temp_dir dir_;
+    int backends_ = 0;
+};
+
+// Tests the rotation of the backends of a DatabaseRotating
+//
+class DatabaseRotating_test : public TestBase
+{
+public:
+    void
+    testMigrateOnRead()
+    {
+        testcase("migrate on read");
+
+        RotatingFixture fixture("memory", *this, "DatabaseRotating_test");
+        auto const batch = createPredictableBatch(numObjectsToTest, 1);
+        auto db = fixture.makeDatabase(fixture.makeBackend());
+        Database& database = *db;
+        storeBatch(database, batch);
+
+        // Reading half the objects from the archive backend moves them to
+        // the new writable backend.
+        auto const writable = fixture.rotate(*db);
+        Batch const read(batch.begin(), batch.begin() + batch.size() / 2);
+        Batch const unread(batch.begin() + batch.size() / 2, batch.end());
+        Batch copy;
+        fetchCopyOfBatch(database, &copy, read);
+        BEAST_EXPECT(areBatchesEqual(read, copy));
+        fetchCopyOfBatch(*writable, &copy, read);
+        BEAST_EXPECT(areBatchesEqual(read, copy));
+        fetchMissing(*writable, unread);
+
+        // Only those survive the next rotation
+        fixture.rotate(*db);
+        fetchCopyOfBatch(database, &copy, read);
+        BEAST_EXPECT(areBatchesEqual(read, copy));
+        fetchCopyOfBatch(database, &copy, unread);
+        BEAST_EXPECT(copy.empty());
+
+        // Asynchronous fetches, which are read in batches, move objects too
+        auto const writable2 = fixture.rotate(*db);
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::size_t found = 0;
+        std::size_t done = 0;
+        for (auto const& object : read)
+        {
+            database.asyncFetch(
+                object->getHash(),
+                0,
+                [&](std::shared_ptr<NodeObject> const& nodeObject) {
+                    std::lock_guard lock(mutex);
+                    if (nodeObject)
+                        ++found;
+                    ++done;
+                    cond.notify_all();
+                });
+        }
+        {
+            std::unique_lock lock(mutex);
+            cond.wait(lock, [&] { return done == read.size(); });
+        }
+        BEAST_EXPECT(found == read.size());
+        fetchCopyOfBatch(*writable2, &copy, read);
+        BEAST_EXPECT(areBatchesEqual(read, copy));
+    }
+
+    void
+    testConcurrentRotation()
+    {
+        testcase("concurrent rotation");
+
+        RotatingFixture fixture("memory", *this, "DatabaseRotating_test");
+        auto const batch = createPredictableBatch(numObjectsToTest, 2);
+        auto db = fixture.makeDatabase(fixture.makeBackend());
+        Database& database = *db;
+        storeBatch(database, batch);
+
+        // Readers keep fetching while the objects are copied forward and
+        // the backends are rotated underneath them.
+        std::atomic<bool> stop{false};
+        std::atomic<int> missing{0};
+        std::atomic<int> fetched{0};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&, i] {
+                beast::xor_shift_engine rng(i);
+                while (!stop)
+                {
+                    auto const& object = batch[rng() % batch.size()];
+                    if (!database.fetchNodeObject(object->getHash()))
+                        ++missing;
+                    ++fetched;
+                }
+            });
+        }
+
+        for (int rotation = 0; rotation < 8; ++rotation)
+        {
+            for (auto const& object : batch)
+                database.fetchNodeObject(object->getHash());
+            fixture.rotate(*db);
+        }
+
+        stop = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        BEAST_EXPECT(fetched > 0);
+        BEAST_EXPECT(missing == 0);
+
+        Batch copy;
+        fetchCopyOfBatch(database, &copy, batch);
+        BEAST_EXPECT(areBatchesEqual(batch, copy));
+    }
+
+    void
+    run() override
+    {
+        testMigrateOnRead();
+        testConcurrentRotation();
+    }
+};
+
+/** Measures the wall time of copying the state forward and rotating, and
+    the latency of the fetches made meanwhile compared to those made when
+    nothing is rotating.
+
+    The argument is the backend type, "memory" by default.
+*/
+class DatabaseRotating_bench_test : public TestBase
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static std::chrono::microseconds
+    percentile(std::vector<std::chrono::microseconds>& samples, int p)
+    {
+        if (samples.empty())
+            return {};
+        std::sort(samples.begin(), samples.end());
+        return samples[(samples.size() * p + 99) / 100 - 1];
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono;
+
+        auto const type = arg().empty() ? std::string("memory") : arg();
+        int const objects = 100000;
+        int const rotations = 3;
+
+        RotatingFixture fixture(type, *this, "DatabaseRotating_bench");
+        auto const batch = createPredictableBatch(objects, 3);
+        auto db = fixture.makeDatabase(fixture.makeBackend());
+        Database& database = *db;
+        storeBatch(database, batch);
+
+        // Even phases are idle, odd ones copy and rotate
+        std::atomic<int> phase{0};
+        std::vector<std::vector<microseconds>> idle(4), busy(4);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&, i] {
+                beast::xor_shift_engine rng(i);
+                for (int p; (p = phase.load()) < 2 * rotations;)
+                {
+                    auto const& object = batch[rng() % batch.size()];
+                    auto const start = clock_type::now();
+                    database.fetchNodeObject(object->getHash());
+                    auto const latency = duration_cast<microseconds>(
+                        clock_type::now() - start);
+                    (p % 2 ? busy : idle)[i].push_back(latency);
+                }
+            });
+        }
+
+        milliseconds elapsed{0};
+        for (int rotation = 0; rotation < rotations; ++rotation)
+        {
+            std::this_thread::sleep_for(seconds(1));
+            ++phase;
+
+            auto const start = clock_type::now();
+            for (auto const& object : batch)
+                database.fetchNodeObject(object->getHash());
+            fixture.rotate(*db);
+            elapsed += duration_cast<milliseconds>(clock_type::now() - start);
+            ++phase;
+        }
+
+        for (auto& reader : readers)
+            reader.join();
+
+        auto const merge = [](auto const& samples) {
+            std::vector<microseconds> merged;
+            for (auto const& s : samples)
+                merged.insert(merged.end(), s.begin(), s.end());
+            return merged;
+        };
+        auto idleSamples = merge(idle);
+        auto busySamples = merge(busy);
+
+        log << type << ", " << objects << " objects: "
+            << elapsed.count() / rotations << "ms per rotation" << std::endl;
+        log << "fetches while idle: " << idleSamples.size()
+            << ", p50 " << percentile(idleSamples, 50).count() << "us, p99 "
+            << percentile(idleSamples, 99).count() << "us" << std::endl;
+        log << "fetches while rotating: " << busySamples.size()
+            << ", p50 " << percentile(busySamples, 50).count() << "us, p99 "
+            << percentile(busySamples, 99).count() << "us" << std::endl;
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(DatabaseRotating, NodeStore, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(DatabaseRotating_bench, NodeStore, ripple);
+
+}  // namespace NodeStore
+}  // namespace ripple
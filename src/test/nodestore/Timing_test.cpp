@@ -30,9 +30,11 @@
 #include <boost/algorithm/string.hpp>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -149,6 +151,7 @@ public:
     };
 
     std::size_t const default_repeat = 3;
+    static std::size_t const fetchBatchSize = 64;
 #ifndef NDEBUG
     std::size_t const default_items = 10000;
 #else
@@ -392,6 +395,129 @@ public:
         backend->close();
     }
 
+    // Fetch existing keys, a batch at a time
+    void
+    do_fetch_batch(
+        Section const& config,
+        Params const& params,
+        beast::Journal journal)
+    {
+        DummyScheduler scheduler;
+        auto backend = make_Backend(config, scheduler, journal);
+        BEAST_EXPECT(backend != nullptr);
+        backend->open();
+
+        class Body
+        {
+        private:
+            suite& suite_;
+            Backend& backend_;
+            Sequence seq1_;
+            beast::xor_shift_engine gen_;
+            std::uniform_int_distribution<std::size_t> dist_;
+
+        public:
+            Body(
+                std::size_t id,
+                suite& s,
+                Params const& params,
+                Backend& backend)
+                : suite_(s)
+                , backend_(backend)
+                , seq1_(1)
+                , gen_(id + 1)
+                , dist_(0, params.items - 1)
+            {
+            }
+
+            void
+            operator()(std::size_t i)
+            {
+                try
+                {
+                    Batch objs;
+                    std::vector<uint256> keys;
+                    for (std::size_t n = 0; n < fetchBatchSize; ++n)
+                    {
+                        objs.push_back(seq1_.obj(dist_(gen_)));
+                        keys.push_back(objs.back()->getHash());
+                    }
+                    std::vector<uint256 const*> hashes;
+                    for (auto const& key : keys)
+                        hashes.push_back(&key);
+
+                    auto const results = backend_.fetchBatch(hashes).first;
+                    suite_.expect(results.size() == objs.size());
+                    for (std::size_t n = 0; n < results.size(); ++n)
+                        suite_.expect(
+                            results[n] && isSame(results[n], objs[n]));
+                }
+                catch (std::exception const& e)
+                {
+                    suite_.fail(e.what());
+                }
+            }
+        };
+        try
+        {
+            parallel_for_id<Body>(
+                params.items / fetchBatchSize,
+                params.threads,
+                std::ref(*this),
+                std::ref(params),
+                std::ref(*backend));
+        }
+        catch (std::exception const&)
+        {
+#if NODESTORE_TIMING_DO_VERIFY
+            backend->verify();
+#endif
+            Rethrow();
+        }
+        backend->close();
+    }
+
+    // Fetch existing keys asynchronously through a database, whose read
+    // threads coalesce the pending requests
+    void
+    do_async(Section const& config, Params const& params, beast::Journal journal)
+    {
+        DummyScheduler scheduler;
+        auto db = Manager::instance().make_Database(
+            megabytes(4), scheduler, params.threads, config, journal);
+        BEAST_EXPECT(db != nullptr);
+
+        Sequence seq1(1);
+        beast::xor_shift_engine gen(1);
+        std::uniform_int_distribution<std::size_t> dist(0, params.items - 1);
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        std::atomic<std::size_t> found = 0;
+
+        for (std::size_t i = 0; i < params.items; ++i)
+        {
+            auto const obj = seq1.obj(dist(gen));
+            db->asyncFetch(
+                obj->getHash(),
+                0,
+                [&, obj](std::shared_ptr<NodeObject> const& result) {
+                    if (result && isSame(result, obj))
+                        ++found;
+                    std::lock_guard lock(mutex);
+                    if (++done == params.items)
+                        cv.notify_all();
+                });
+        }
+
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return done == params.items; });
+        lock.unlock();
+
+        BEAST_EXPECT(found == params.items);
+    }
+
     // Perform lookups of non-existent keys
     void
     do_missing(
@@ -758,6 +884,8 @@ public:
         test_list const tests = {
             {"Insert", &Timing_test::do_insert},
             {"Fetch", &Timing_test::do_fetch},
+            {"Batch", &Timing_test::do_fetch_batch},
+            {"Async", &Timing_test::do_async},
             {"Missing", &Timing_test::do_missing},
             {"Mixed", &Timing_test::do_mixed},
             {"Work", &Timing_test::do_work}};
@@ -93,6 +93,13 @@ public:
 
         auto& buffer = m.getBuffer(Compressed::On);
 
+        // The message is serialized and compressed once, however many
+        // peers it is sent to, and its buffers are accounted for once.
+        BEAST_EXPECT(m.takeAllocations().serialized);
+        BEAST_EXPECT(&m.getBuffer(Compressed::On) == &buffer);
+        auto const again = m.takeAllocations();
+        BEAST_EXPECT(!again.serialized && !again.compressed);
+
         boost::beast::multi_buffer buffers;
 
         // simulate multi-buffer
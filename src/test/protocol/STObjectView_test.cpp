@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/STObjectView.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
+#include <ripple/protocol/st.h>
+
+#include <memory>
+
+namespace ripple {
+
+class STObjectView_test : public beast::unit_test::suite
+{
+    // An object with a field of every serialized type
+    static STObject
+    makeObject()
+    {
+        Issue const usd{to_currency("USD"), AccountID{7}};
+
+        STObject obj(sfGeneric);
+        obj.setFieldU8(sfTickSize, 5);
+        obj.setFieldU16(sfTransactionType, ttPAYMENT);
+        obj.setFieldU32(sfFlags, 0x80000001);
+        obj.setFieldU64(sfIndexNext, 0x0123456789abcdefULL);
+        obj.setFieldH128(sfEmailHash, uint128{3});
+        obj.setFieldH160(sfTakerPaysCurrency, to_currency("EUR"));
+        obj.setFieldH256(sfPreviousTxnID, uint256{42});
+        obj.setFieldAmount(sfAmount, XRPAmount{1000});
+        obj.setFieldAmount(sfLimitAmount, STAmount{usd, 100});
+        obj.setFieldVL(sfPublicKey, Blob(33, 0x02));
+        obj.setAccountID(sfAccount, AccountID{9});
+        obj.setFieldV256(
+            sfAmendments,
+            STVector256{std::vector<uint256>{uint256{1}, uint256{2}}});
+        obj.setFieldIssue(sfLockingChainIssue, STIssue{sfLockingChainIssue, usd});
+        obj.set(std::make_unique<STXChainBridge>(
+            AccountID{1}, xrpIssue(), AccountID{2}, usd));
+
+        STPath path;
+        path.emplace_back(AccountID{3}, to_currency("EUR"), AccountID{4});
+        path.emplace_back(std::nullopt, xrpCurrency(), std::nullopt);
+        STPathSet paths;
+        paths.push_back(path);
+        paths.push_back(path);
+        obj.setFieldPathSet(sfPaths, paths);
+
+        STObject memo(sfMemo);
+        memo.setFieldVL(sfMemoData, Blob{1, 2, 3});
+        STArray memos(sfMemos);
+        memos.push_back(memo);
+        memos.push_back(memo);
+        obj.setFieldArray(sfMemos, memos);
+
+        STObject inner(sfMajority);
+        inner.setFieldH256(sfAmendment, uint256{5});
+        inner.setFieldU32(sfCloseTime, 12);
+        obj.set(std::make_unique<STObject>(std::move(inner)));
+
+        return obj;
+    }
+
+    // The serialized contents of a field, as the view should see them
+    static Blob
+    contents(STBase const& field)
+    {
+        Serializer s;
+        field.add(s);
+
+        auto const type = field.getSType();
+        if (type == STI_VL || type == STI_ACCOUNT || type == STI_VECTOR256)
+        {
+            SerialIter sit(s.slice());
+            return sit.getRaw(sit.getVLDataLength());
+        }
+
+        if (type == STI_OBJECT || type == STI_ARRAY)
+            s.addFieldID(type, 1);
+        return s.getData();
+    }
+
+public:
+    void
+    testFields()
+    {
+        testcase("fields");
+
+        auto const obj = makeObject();
+        Serializer s;
+        obj.add(s);
+
+        STObjectView const view(s.slice());
+        BEAST_EXPECT(view.getCount() == obj.getCount());
+
+        for (auto const& field : obj)
+        {
+            auto const data = view.peekFieldData(field.getFName());
+            BEAST_EXPECTS(
+                data && *data == makeSlice(contents(field)),
+                field.getFName().getName());
+        }
+
+        BEAST_EXPECT(view.getFieldU8(sfTickSize) == 5);
+        BEAST_EXPECT(view.getFieldU16(sfTransactionType) == ttPAYMENT);
+        BEAST_EXPECT(view.getFieldU32(sfFlags) == 0x80000001);
+        BEAST_EXPECT(view.getFieldU64(sfIndexNext) == 0x0123456789abcdefULL);
+        BEAST_EXPECT(view.getFieldH256(sfPreviousTxnID) == uint256{42});
+        BEAST_EXPECT(view.getFieldVL(sfPublicKey) == makeSlice(Blob(33, 0x02)));
+
+        BEAST_EXPECT(!view.isFieldPresent(sfSequence));
+        except<std::runtime_error>([&] { view.getFieldU32(sfSequence); });
+        except<std::runtime_error>([&] { view.getFieldU32(sfIndexNext); });
+    }
+
+    void
+    testMalformed()
+    {
+        testcase("malformed");
+
+        auto const obj = makeObject();
+        Serializer s;
+        obj.add(s);
+        STObjectView const full(s.slice());
+
+        // Cutting the object short anywhere either throws, or finds the
+        // fields that came before the cut where they were. Like STObject,
+        // the view accepts an inner object or array that runs to the end
+        // of the buffer without its end marker, so that one may be shorter.
+        for (std::size_t size = 0; size < s.size(); ++size)
+        {
+            try
+            {
+                STObjectView const view(Slice{s.data(), size});
+                for (auto const& field : obj)
+                {
+                    auto const data = view.peekFieldData(field.getFName());
+                    auto const whole = full.peekFieldData(field.getFName());
+                    BEAST_EXPECT(
+                        !data ||
+                        (data->data() == whole->data() &&
+                         data->size() <= whole->size()));
+                }
+            }
+            catch (std::runtime_error const&)
+            {
+            }
+        }
+
+        // An unknown field
+        {
+            Serializer bad;
+            bad.addFieldID(STI_UINT32, 255);
+            bad.add32(0);
+            except<std::runtime_error>([&] { STObjectView{bad.slice()}; });
+        }
+
+        // An end of array marker in an object
+        {
+            Serializer bad;
+            bad.addFieldID(STI_ARRAY, 1);
+            except<std::runtime_error>([&] { STObjectView{bad.slice()}; });
+        }
+
+        // Objects nested too deeply
+        {
+            Serializer bad;
+            for (int i = 0; i < 12; ++i)
+                bad.addFieldID(STI_OBJECT, sfMemo.fieldValue);
+            except<std::runtime_error>([&] { STObjectView{bad.slice()}; });
+        }
+    }
+
+    void
+    run() override
+    {
+        testFields();
+        testMalformed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STObjectView, protocol, ripple);
+
+}  // namespace ripple
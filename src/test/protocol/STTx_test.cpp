@@ -20,14 +20,18 @@
 #include <ripple/basics/Slice.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/json/to_string.h>
+#include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/Rules.h>
 #include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/Sign.h>
+#include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/TxFormats.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/messages.h>
+#include <chrono>
 #include <memory>
 #include <regex>
 
@@ -1817,7 +1821,84 @@ public:
     }
 };
 
+/** Measures how quickly transactions and ledger entries are rendered as
+    JSON, which dominates the cost of many RPC responses and subscription
+    streams.
+*/
+class STJson_bench_test : public beast::unit_test::suite
+{
+    template <class Object>
+    void
+    measure(char const* name, Object const& object, std::size_t count)
+    {
+        using namespace std::chrono;
+
+        std::size_t members = 0;
+        auto const start = steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i)
+            members += object.getJson(JsonOptions::none).size();
+        auto const elapsed =
+            duration_cast<duration<double>>(steady_clock::now() - start);
+
+        BEAST_EXPECT(
+            members == count * object.getJson(JsonOptions::none).size());
+        log << name << ": "
+            << static_cast<std::uint64_t>(count / elapsed.count())
+            << " objects/s" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        auto const kp1 = randomKeyPair(KeyType::secp256k1);
+        auto const id1 = calcAccountID(kp1.first);
+        auto const id2 = calcAccountID(randomKeyPair(KeyType::ed25519).first);
+        Issue const usd{to_currency("USD"), id2};
+
+        STTx payment(ttPAYMENT, [&](auto& obj) {
+            obj.setAccountID(sfAccount, id1);
+            obj.setAccountID(sfDestination, id2);
+            obj.setFieldAmount(sfAmount, STAmount(usd, 12345, -2));
+            obj.setFieldAmount(sfSendMax, STAmount(200'000'000));
+            obj.setFieldAmount(sfFee, STAmount(12));
+            obj.setFieldU32(sfSequence, 42);
+            obj.setFieldU32(sfLastLedgerSequence, 1000);
+            obj.setFieldU32(sfFlags, tfPartialPayment);
+            obj.setFieldVL(sfSigningPubKey, kp1.first.slice());
+            STArray memos(sfMemos, 1);
+            memos.push_back(STObject(sfMemo));
+            memos.back().setFieldVL(sfMemoData, Slice("benchmark", 9));
+            obj.setFieldArray(sfMemos, memos);
+        });
+        payment.sign(kp1.first, kp1.second);
+
+        STLedgerEntry account(keylet::account(id1));
+        account.setAccountID(sfAccount, id1);
+        account.setFieldAmount(sfBalance, STAmount(1'000'000'000));
+        account.setFieldU32(sfSequence, 43);
+        account.setFieldU32(sfOwnerCount, 3);
+        account.setFieldH256(sfPreviousTxnID, payment.getTransactionID());
+        account.setFieldU32(sfPreviousTxnLgrSeq, 999);
+
+        STLedgerEntry line(keylet::line(id1, id2, usd.currency));
+        line.setFieldAmount(sfBalance, STAmount(noIssue(), 5, 0));
+        line.setFieldAmount(sfLowLimit, STAmount(usd, 1000, 0));
+        line.setFieldAmount(sfHighLimit, STAmount(usd, 0, 0));
+        line.setFieldU32(sfFlags, lsfLowReserve);
+        line.setFieldU64(sfLowNode, 0);
+        line.setFieldU64(sfHighNode, 0);
+        line.setFieldH256(sfPreviousTxnID, payment.getTransactionID());
+        line.setFieldU32(sfPreviousTxnLgrSeq, 999);
+
+        measure("STTx::getJson (Payment)", payment, 200'000);
+        measure("STLedgerEntry::getJson (AccountRoot)", account, 200'000);
+        measure("STLedgerEntry::getJson (RippleState)", line, 200'000);
+    }
+};
+
 BEAST_DEFINE_TESTSUITE(STTx, ripple_app, ripple);
 BEAST_DEFINE_TESTSUITE(InnerObjectFormatsSerializer, ripple_app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(STJson_bench, ripple_app, ripple);
 
 }  // namespace ripple
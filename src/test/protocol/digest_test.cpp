@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+static char const*
+engineName(detail::sha512_engine engine)
+{
+    switch (engine)
+    {
+        case detail::sha512_engine::avx2:
+            return "avx2";
+        case detail::sha512_engine::avx512:
+            return "avx512";
+        default:
+            return "openssl";
+    }
+}
+
+struct digest_test : public beast::unit_test::suite
+{
+    // Checks every engine against sha512Half, one message at a time.
+    void
+    check(std::vector<Blob> const& blobs)
+    {
+        std::vector<Slice> messages;
+        std::vector<uint256> expected;
+        for (auto const& blob : blobs)
+        {
+            messages.push_back(makeSlice(blob));
+            expected.push_back(sha512Half(makeSlice(blob)));
+        }
+
+        for (auto const engine : detail::sha512Engines())
+        {
+            std::vector<uint256> digests(messages.size());
+            detail::sha512HalfBatch(
+                engine, messages.data(), digests.data(), messages.size());
+            BEAST_EXPECTS(digests == expected, engineName(engine));
+        }
+    }
+
+    void
+    testKnownAnswer()
+    {
+        testcase("known answer");
+
+        std::string engines;
+        for (auto const engine : detail::sha512Engines())
+            engines += std::string(" ") + engineName(engine);
+        log << "SHA-512 engines:" << engines << std::endl;
+
+        std::string const abc = "abc";
+        std::vector<Slice> const messages(9, Slice{abc.data(), abc.size()});
+        auto const digests = sha512HalfBatch(messages);
+        BEAST_EXPECT(digests.size() == messages.size());
+        for (auto const& digest : digests)
+            BEAST_EXPECT(
+                to_string(digest) ==
+                "DDAF35A193617ABACC417349AE20413112E6FA4E89A97EA20A9EEEE64B"
+                "55D39A");
+
+        BEAST_EXPECT(sha512HalfBatch(std::vector<Slice>{}).empty());
+    }
+
+    void
+    testPaddingBoundaries()
+    {
+        testcase("padding boundaries");
+
+        // Every length from empty to three blocks, so that the padding
+        // falls in every position, with enough copies of each to fill the
+        // widest lanes.
+        std::vector<Blob> blobs;
+        for (std::size_t size = 0; size <= 384; ++size)
+        {
+            for (int copy = 0; copy < 9; ++copy)
+            {
+                Blob blob(size);
+                for (auto& b : blob)
+                    b = rand_byte<std::uint8_t>();
+                blobs.push_back(std::move(blob));
+            }
+        }
+        check(blobs);
+    }
+
+    void
+    testMixedLengths()
+    {
+        testcase("mixed lengths");
+
+        // Random lengths in random order, including the sizes of inner
+        // nodes and typical leaves, and lone messages of their length.
+        std::vector<Blob> blobs;
+        for (int i = 0; i < 2000; ++i)
+        {
+            std::size_t const size =
+                (i % 3 == 0) ? 516 : rand_int<std::size_t>(1500);
+            Blob blob(size);
+            for (auto& b : blob)
+                b = rand_byte<std::uint8_t>();
+            blobs.push_back(std::move(blob));
+        }
+        blobs.emplace_back(20000, 0xa5);
+        check(blobs);
+    }
+
+    void
+    run() override
+    {
+        testKnownAnswer();
+        testPaddingBoundaries();
+        testMixedLengths();
+    }
+};
+
+/** Measures the hashing throughput of each SHA-512 engine on messages the
+    size of SHAMap inner nodes and of typical account state leaves.
+*/
+struct digest_bench_test : public beast::unit_test::suite
+{
+    void
+    measure(std::size_t size, std::size_t count)
+    {
+        using namespace std::chrono;
+
+        std::vector<Blob> blobs(count, Blob(size));
+        for (auto& blob : blobs)
+            std::generate(blob.begin(), blob.end(), [] {
+                return rand_byte<std::uint8_t>();
+            });
+
+        std::vector<Slice> messages;
+        for (auto const& blob : blobs)
+            messages.push_back(makeSlice(blob));
+        std::vector<uint256> digests(count);
+
+        for (auto const engine : detail::sha512Engines())
+        {
+            auto const start = steady_clock::now();
+            detail::sha512HalfBatch(
+                engine, messages.data(), digests.data(), count);
+            auto const elapsed =
+                duration_cast<duration<double>>(steady_clock::now() - start);
+
+            log << size << " byte messages, " << engineName(engine) << ": "
+                << static_cast<std::uint64_t>(count / elapsed.count())
+                << " hashes/s, "
+                << static_cast<std::uint64_t>(
+                       count * size / elapsed.count() / (1024 * 1024))
+                << " MiB/s" << std::endl;
+        }
+    }
+
+    void
+    run() override
+    {
+        measure(516, 1'000'000);
+        measure(120, 1'000'000);
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(digest, protocol, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(digest_bench, protocol, ripple);
+
+}  // namespace ripple
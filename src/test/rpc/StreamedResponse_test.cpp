@@ -0,0 +1,433 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2023 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/random.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/impl/StreamedResponse.h>
+#include <ripple/rpc/impl/Tuning.h>
+#include <test/jtx.h>
+#include <test/jtx/JSONRPCClient.h>
+#include <test/jtx/WSClient.h>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/dynamic_body.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace ripple {
+namespace test {
+
+class StreamedResponse_test : public beast::unit_test::suite
+{
+    // Removes the chunked transfer encoding from an HTTP body.
+    static std::optional<std::string>
+    unchunk(std::string const& body)
+    {
+        std::string result;
+        std::size_t pos = 0;
+        for (;;)
+        {
+            auto const eol = body.find("\r\n", pos);
+            if (eol == std::string::npos)
+                return std::nullopt;
+            auto const size =
+                std::stoul(body.substr(pos, eol - pos), nullptr, 16);
+            pos = eol + 2;
+            if (size == 0)
+                break;
+            if (body.size() < pos + size + 2)
+                return std::nullopt;
+            result.append(body, pos, size);
+            pos += size + 2;
+        }
+        if (body.compare(pos, std::string::npos, "\r\n") != 0)
+            return std::nullopt;
+        return result;
+    }
+
+    // Takes everything from a Writer, as an HTTP session would, slowly
+    // enough for the producer to get ahead of it.
+    static std::string
+    drain(Writer& writer, std::size_t& maxBuffered)
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool woken = false;
+        auto const resume = [&]() {
+            std::lock_guard lock(mutex);
+            woken = true;
+            cv.notify_one();
+        };
+
+        std::string received;
+        while (!writer.complete())
+        {
+            if (!writer.prepare(0, resume))
+            {
+                std::unique_lock lock(mutex);
+                cv.wait(lock, [&] { return woken; });
+                woken = false;
+                continue;
+            }
+
+            auto const buffers = writer.data();
+            auto const n = boost::asio::buffer_size(buffers);
+            maxBuffered = std::max(maxBuffered, n);
+            for (auto const& b : buffers)
+                received.append(static_cast<char const*>(b.data()), b.size());
+            writer.consume(n);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return received;
+    }
+
+public:
+    void
+    testResults()
+    {
+        testcase("results");
+
+        using namespace jtx;
+        Env env{*this};
+
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        auto const USD = gw["USD"];
+        env.fund(XRP(100000), gw, alice, bob);
+        env.close();
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        for (int i = 0; i < 20; ++i)
+        {
+            env(pay(gw, alice, USD(10)));
+            env(offer(alice, XRP(10 + i), USD(1)));
+            env(pay(alice, bob, XRP(1)));
+            env.close();
+        }
+        for (int i = 0; i < 300; ++i)
+            env.fund(XRP(1000), Account{"account" + std::to_string(i)});
+        env.close();
+
+        // The command line client speaks HTTP/1.0, so it gets the result
+        // built as a Json::Value, which the streamed results must match.
+        auto http = makeJSONRPCClient(env.app().config());
+        auto ws = makeWSClient(env.app().config());
+        auto const check = [&](std::string const& command,
+                               Json::Value const& params) {
+            auto const expected =
+                env.rpc("json", command, to_string(params))[jss::result];
+            BEAST_EXPECTS(
+                expected[jss::status] == jss::success,
+                command + " " + to_string(params));
+            BEAST_EXPECTS(
+                http->invoke(command, params)[jss::result] == expected,
+                command + " over HTTP " + to_string(params));
+            BEAST_EXPECTS(
+                ws->invoke(command, params)[jss::result] == expected,
+                command + " over WebSocket " + to_string(params));
+            return expected;
+        };
+
+        for (auto const binary : {false, true})
+        {
+            Json::Value params;
+            params[jss::ledger_index] = "closed";
+            params[jss::binary] = binary;
+            auto const page = check("ledger_data", params);
+            BEAST_EXPECT(page.isMember(jss::marker));
+            params[jss::marker] = page[jss::marker];
+            check("ledger_data", params);
+        }
+
+        {
+            Json::Value params;
+            params[jss::ledger_index] = "closed";
+            params[jss::transactions] = true;
+            params[jss::expand] = true;
+            check("ledger", params);
+            params[jss::full] = true;
+            check("ledger", params);
+        }
+
+        for (auto const binary : {false, true})
+        {
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::ledger_index_min] = -1;
+            params[jss::ledger_index_max] = -1;
+            params[jss::limit] = 10;
+            params[jss::binary] = binary;
+            auto const page = check("account_tx", params);
+            BEAST_EXPECT(page.isMember(jss::marker));
+            params[jss::marker] = page[jss::marker];
+            check("account_tx", params);
+        }
+
+        {
+            Json::Value params;
+            params[jss::account] = alice.human();
+            check("account_objects", params);
+            params[jss::type] = jss::offer;
+            params[jss::limit] = 10;
+            auto const page = check("account_objects", params);
+            BEAST_EXPECT(page.isMember(jss::marker));
+            params[jss::marker] = page[jss::marker];
+            check("account_objects", params);
+        }
+
+        // Requests that fail their checks get the same errors as before.
+        auto const fails = [&](std::string const& command,
+                               Json::Value const& params,
+                               std::string const& error) {
+            auto const jv = http->invoke(command, params);
+            BEAST_EXPECTS(
+                jv[jss::error][jss::error] == error,
+                command + " over HTTP " + to_string(params));
+            BEAST_EXPECTS(
+                ws->invoke(command, params)[jss::error] == error,
+                command + " over WebSocket " + to_string(params));
+        };
+        {
+            Json::Value params;
+            params[jss::marker] = "not a marker";
+            fails("ledger_data", params, "invalidParams");
+        }
+        {
+            Json::Value params;
+            params[jss::account] = "not an account";
+            fails("account_objects", params, "actMalformed");
+            fails("account_tx", params, "actMalformed");
+        }
+    }
+
+    void
+    testBackpressure()
+    {
+        testcase("backpressure");
+
+        using namespace jtx;
+        Env env{*this};
+
+        std::string data(8'000'000, 0);
+        for (auto& c : data)
+            c = 'a' + rand_int(25);
+        std::string const head = "head\r\n\r\n";
+
+        std::promise<std::shared_ptr<Writer>> writer;
+        std::promise<void> done;
+        env.app().getJobQueue().postCoro(
+            jtCLIENT, "StreamedResponse", [&](auto const& coro) {
+                auto const stream =
+                    std::make_shared<RPC::StreamedResponse>(coro, true, head);
+                writer.set_value(stream->makeHTTPWriter());
+                for (std::size_t pos = 0; pos < data.size(); pos += 1000)
+                    stream->write({data.data() + pos, 1000});
+                stream->finish();
+                done.set_value();
+            });
+
+        std::size_t maxBuffered = 0;
+        auto const received = drain(*writer.get_future().get(), maxBuffered);
+        done.get_future().wait();
+
+        // Everything arrives, but no more than one block past the limit is
+        // ever waiting to be sent.
+        BEAST_EXPECT(received.compare(0, head.size(), head) == 0);
+        BEAST_EXPECT(unchunk(received.substr(head.size())) == data);
+        BEAST_EXPECT(
+            maxBuffered <=
+            RPC::Tuning::maxStreamBuffer + RPC::Tuning::streamBlockSize + 32);
+    }
+
+    void
+    testAbandoned()
+    {
+        testcase("abandoned");
+
+        using namespace jtx;
+        Env env{*this};
+
+        std::string const data(RPC::Tuning::streamBlockSize, 'x');
+
+        std::promise<std::shared_ptr<WSMsg>> message;
+        std::promise<bool> threw;
+        env.app().getJobQueue().postCoro(
+            jtCLIENT, "StreamedResponse", [&](auto const& coro) {
+                auto const stream =
+                    std::make_shared<RPC::StreamedResponse>(coro, false);
+                message.set_value(stream->makeWSMsg());
+                try
+                {
+                    // Far more than can be buffered, so this only ends when
+                    // the client goes away.
+                    for (int i = 0; i < 1000; ++i)
+                        stream->write(data);
+                    stream->finish();
+                    threw.set_value(false);
+                }
+                catch (std::runtime_error const&)
+                {
+                    stream->abort();
+                    threw.set_value(true);
+                }
+            });
+
+        {
+            auto msg = message.get_future().get();
+            std::promise<void> ready;
+            auto const result = msg->prepare(1000, [&] { ready.set_value(); });
+            if (boost::indeterminate(result.first))
+                ready.get_future().wait();
+            else
+                BEAST_EXPECT(!result.first);
+        }
+
+        auto result = threw.get_future();
+        BEAST_EXPECT(
+            result.wait_for(std::chrono::seconds(10)) ==
+            std::future_status::ready);
+        BEAST_EXPECT(result.get());
+    }
+
+    void
+    run() override
+    {
+        testResults();
+        testBackpressure();
+        testAbandoned();
+    }
+};
+
+/** Compares the memory and time to first byte of a full ledger dump built
+    as a Json::Value, for HTTP/1.0 clients, with one streamed as chunks to
+    HTTP/1.1 clients. The number of accounts can be given as the suite
+    argument.
+*/
+class StreamedResponseBench_test : public beast::unit_test::suite
+{
+    // Peak resident set size in kilobytes, or 0 if unavailable.
+    static long
+    peakRSS()
+    {
+#ifndef _WIN32
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return usage.ru_maxrss;
+#endif
+        return 0;
+    }
+
+    void
+    fetch(
+        Config const& config,
+        unsigned version,
+        std::string const& body,
+        char const* name)
+    {
+        using namespace std::chrono;
+        namespace http = boost::beast::http;
+        using boost::asio::ip::tcp;
+
+        auto const& section = config["port_rpc"];
+        tcp::endpoint const endpoint{
+            boost::asio::ip::make_address(*section.get("ip")),
+            *section.get<std::uint16_t>("port")};
+
+        boost::asio::io_service ios;
+        tcp::socket socket{ios};
+        socket.connect(endpoint);
+
+        http::request<http::string_body> req{http::verb::post, "/", version};
+        req.set(http::field::content_type, "application/json");
+        req.body() = body;
+        req.prepare_payload();
+
+        auto const rss = peakRSS();
+        auto const start = steady_clock::now();
+        http::write(socket, req);
+
+        boost::beast::flat_buffer buffer;
+        http::response_parser<http::dynamic_body> parser;
+        parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+        http::read_header(socket, buffer, parser);
+        auto const firstByte = steady_clock::now() - start;
+        http::read(socket, buffer, parser);
+        auto const total = steady_clock::now() - start;
+
+        log << name << ": " << parser.get().body().size() << " bytes, "
+            << "first byte after "
+            << duration_cast<milliseconds>(firstByte).count() << "ms, "
+            << "complete after " << duration_cast<milliseconds>(total).count()
+            << "ms, peak RSS grew by " << (peakRSS() - rss) << " KiB"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+
+        std::size_t accounts = 10'000;
+        if (!arg().empty())
+            accounts = std::stoul(arg());
+
+        Env env{*this};
+        for (std::size_t i = 0; i < accounts; ++i)
+        {
+            env.fund(XRP(1000), Account{"account" + std::to_string(i)});
+            if (i % 1000 == 999)
+                env.close();
+        }
+        env.close();
+
+        Json::Value request;
+        request[jss::method] = "ledger";
+        request[jss::params][0u][jss::ledger_index] = "closed";
+        request[jss::params][0u][jss::full] = true;
+        auto const body = to_string(request);
+
+        // The peak only ever grows, so the streamed response goes first.
+        fetch(env.app().config(), 11, body, "streamed");
+        fetch(env.app().config(), 10, body, "Json::Value");
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StreamedResponse, rpc, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(StreamedResponseBench, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
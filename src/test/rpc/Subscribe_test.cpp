@@ -308,6 +308,79 @@ public:
         BEAST_EXPECT(jv[jss::status] == "success");
     }
 
+    void
+    testTransactionOrder()
+    {
+        testcase("transaction order");
+
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+        Account const alice("alice");
+        Account const bob("bob");
+        env.fund(XRP(10000), alice, bob);
+        env.close();
+
+        // One client follows the accounts, the other every transaction.
+        auto accountsClient = makeWSClient(env.app().config());
+        auto streamClient = makeWSClient(env.app().config());
+        {
+            Json::Value stream;
+            stream[jss::accounts] = Json::arrayValue;
+            stream[jss::accounts].append(alice.human());
+            stream[jss::accounts].append(bob.human());
+            auto jv = accountsClient->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+        }
+        {
+            Json::Value stream;
+            stream[jss::streams] = Json::arrayValue;
+            stream[jss::streams].append("transactions");
+            auto jv = streamClient->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+        }
+
+        // Enough transactions in one ledger that they are prepared for
+        // publication in parallel.
+        int const count = 40;
+        for (int i = 0; i < count; ++i)
+        {
+            if (i % 2)
+                env(pay(alice, bob, XRP(1)));
+            else
+                env(noop(bob));
+        }
+        env.close();
+
+        // Each client sees every transaction once, in ledger order.
+        for (auto* client : {accountsClient.get(), streamClient.get()})
+        {
+            int received = 0;
+            while (auto const jv = client->getMsg(5s))
+            {
+                if (!jv->isMember(jss::meta))
+                    continue;
+                BEAST_EXPECT((*jv)[jss::validated].asBool());
+                BEAST_EXPECT(
+                    (*jv)[jss::meta][sfTransactionIndex.jsonName].asInt() ==
+                    received);
+                if (++received == count)
+                    break;
+            }
+            BEAST_EXPECT(received == count);
+        }
+
+        // The time taken to publish it is reported.
+        auto const info = env.rpc("server_info")[jss::result][jss::info];
+        BEAST_EXPECT(info.isMember(jss::ledger_publish));
+        auto const& publish = info[jss::ledger_publish];
+        BEAST_EXPECT(
+            publish[jss::ledger_index].asUInt() == env.closed()->seq());
+        BEAST_EXPECT(publish.isMember(jss::duration_us));
+        BEAST_EXPECT(publish.isMember(jss::max_duration_us));
+        BEAST_EXPECT(publish.isMember(jss::lag_s));
+    }
+
     void
     testTransactions_APIv2()
     {
@@ -1304,6 +1377,7 @@ public:
         testLedger();
         testTransactions_APIv1();
         testTransactions_APIv2();
+        testTransactionOrder();
         testManifests();
         testValidations(all - xrpFees);
         testValidations(all);
@@ -21,7 +21,10 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
+#include <test/jtx/Env.h>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -122,6 +125,55 @@ public:
 
         run(true, journal);
         run(false, journal);
+        testParallelFlush(journal);
+    }
+
+    void
+    testParallelFlush(beast::Journal const& journal)
+    {
+        testcase("parallel flush");
+
+        test::jtx::Env env(*this);
+        auto& jobQueue = env.app().getJobQueue();
+        tests::TestNodeFamily f(journal);
+
+        auto const add = [](SHAMap& map, std::uint32_t i) {
+            auto const key = sha512Half(i);
+            return map.addItem(
+                SHAMapNodeType::tnACCOUNT_STATE,
+                make_shamapitem(key, Slice{key.data(), key.size()}));
+        };
+
+        SHAMap serial(SHAMapType::STATE, f);
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            BEAST_EXPECT(add(serial, i));
+        serial.flushDirty(hotACCOUNT_NODE);
+
+        // Make the same changes to two maps sharing the flushed nodes, then
+        // flush one serially and the other in parallel.
+        auto parallel = serial.snapShot(true);
+        for (std::uint32_t i = 0; i < 1000; i += 3)
+        {
+            BEAST_EXPECT(serial.delItem(sha512Half(i)));
+            BEAST_EXPECT(parallel->delItem(sha512Half(i)));
+        }
+        for (std::uint32_t i = 1000; i < 1200; ++i)
+        {
+            BEAST_EXPECT(add(serial, i));
+            BEAST_EXPECT(add(*parallel, i));
+        }
+
+        auto const serialFlushed = serial.flushDirty(hotACCOUNT_NODE);
+        auto const parallelFlushed =
+            parallel->flushDirty(hotACCOUNT_NODE, jobQueue);
+        BEAST_EXPECT(serialFlushed > 0);
+        BEAST_EXPECT(parallelFlushed == serialFlushed);
+        BEAST_EXPECT(parallel->getHash() == serial.getHash());
+        BEAST_EXPECT(parallel->deepCompare(serial));
+        parallel->invariants();
+
+        // Everything has been flushed
+        BEAST_EXPECT(parallel->flushDirty(hotACCOUNT_NODE, jobQueue) == 0);
     }
 
     void